@@ -0,0 +1,429 @@
+#include "ArrayBenchmark.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+using lingodb::runtime::ArrayAllocator;
+using lingodb::runtime::ArenaAllocator;
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::PrintSink;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::bench::ElementType;
+using lingodb::runtime::bench::Input;
+using lingodb::runtime::bench::Shape;
+using lingodb::runtime::bench::getInput;
+using lingodb::runtime::bench::getRows;
+using lingodb::runtime::bench::getStructure;
+
+namespace {
+
+/**
+ * This class drops the printed text, so only the printing itself is measured.
+ */
+class DiscardPrintSink : public PrintSink {
+    protected:
+    void write(const char *, size_t) override {}
+};
+
+/**
+ * This function measures an operation. The results of each iteration are released
+ * afterwards, so the memory of the process does not grow with the iterations.
+ *
+ * @param state The state of the benchmark.
+ * @param elements The number of elements processed by a single call.
+ * @param bytes The number of bytes processed by a single call.
+ * @param operation The measured call (its result is kept alive).
+ */
+template<class OP>
+void measure(benchmark::State &state, size_t elements, size_t bytes, OP operation) {
+    ArenaAllocator results;
+    ArrayAllocator::Scope scope(results);
+    for (auto _ : state) {
+        auto result = operation();
+        benchmark::DoNotOptimize(result);
+        results.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * elements);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+/**
+ * This function calls `function` with a scalar of the element type of the shape
+ * (the overload of `ArrayRuntime` that matches this type).
+ */
+template<class FUNCTION>
+auto withScalar(const Shape &shape, FUNCTION function) {
+    switch (shape.type) {
+        case ElementType::INTEGER32:
+            return function(static_cast<int32_t>(3));
+        case ElementType::INTEGER64:
+            return function(static_cast<int64_t>(3));
+        case ElementType::DOUBLE:
+            return function(3.0);
+        default:
+            return function(3.0f);
+    }
+}
+
+/**
+ * This function returns the number of bytes of a single element of the given type
+ * (the length of a string).
+ */
+size_t getElementSize(int32_t type) {
+    switch (type) {
+        case ElementType::INTEGER64:
+        case ElementType::DOUBLE:
+            return 8;
+        case ElementType::BFLOAT:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+/**
+ * This function returns the (average) width of a dimension of the shape.
+ */
+int32_t getWidth(const Shape &shape) {
+    return std::max(1L, std::lround(std::pow(static_cast<double>(shape.size), 1.0 / shape.dimensions)));
+}
+
+// The shapes that are accepted by the operations
+bool isAny(const Shape &) {
+    return true;
+}
+bool isNumeric(const Shape &shape) {
+    return shape.type != ElementType::STRING;
+}
+bool isNumericButDouble(const Shape &shape) {
+    return isNumeric(shape) && shape.type != ElementType::DOUBLE;
+}
+bool isNumericWithoutNulls(const Shape &shape) {
+    return isNumeric(shape) && shape.nullPercent == 0;
+}
+bool isFloatingPointWithoutNulls(const Shape &shape) {
+    return isNumericWithoutNulls(shape) && shape.type >= ElementType::BFLOAT;
+}
+bool isRectangular(const Shape &shape) {
+    return isNumeric(shape) && !shape.ragged && shape.dimensions >= 2;
+}
+bool isMatrix(const Shape &shape) {
+    // Larger matrices only measure the BLAS library
+    return isNumericWithoutNulls(shape) && !shape.ragged && shape.dimensions == 2 && shape.size <= 1000000;
+}
+bool isMatrixBatch(const Shape &shape) {
+    return isFloatingPointWithoutNulls(shape) && !shape.ragged && shape.dimensions == 3 && shape.size <= 1000000;
+}
+bool isFillable(const Shape &shape) {
+    return shape.type != ElementType::BFLOAT && !shape.ragged && shape.nullPercent == 0;
+}
+
+// Measures an operation on a single array
+#define ARRAY_UNARY_BENCHMARK(NAME, CALL)                                              \
+    void NAME(benchmark::State &state, Shape shape) {                                  \
+        auto &input = getInput(shape, 1);                                              \
+        VarLen32 array = input.array;                                                  \
+        int32_t type = shape.type;                                                     \
+        (void) type;                                                                   \
+        measure(state, input.elements, input.bytes, [&]() { return CALL; });          \
+    }
+
+// Measures an operation on two arrays with the same structure
+#define ARRAY_BINARY_BENCHMARK(NAME, CALL)                                             \
+    void NAME(benchmark::State &state, Shape shape) {                                  \
+        auto &left = getInput(shape, 1);                                               \
+        auto &right = getInput(shape, 2);                                              \
+        VarLen32 leftArray = left.array;                                               \
+        VarLen32 rightArray = right.array;                                             \
+        int32_t type = shape.type;                                                     \
+        measure(state, left.elements + right.elements, left.bytes + right.bytes, [&]() { return CALL; }); \
+    }
+
+// Measures a batch operation on rows of a single column
+#define ARRAY_BATCH_UNARY_BENCHMARK(NAME, FUNCTION)                                    \
+    void NAME(benchmark::State &state, Shape shape) {                                  \
+        auto &rows = getRows(shape, 1);                                                \
+        std::vector<double> result(rows.size());                                       \
+        measure(state, shape.size, shape.size * getElementSize(shape.type), [&]() {       \
+            ArrayRuntime::FUNCTION(rows.data(), rows.size(), shape.type, result.data()); \
+            return result[0];                                                          \
+        });                                                                            \
+    }
+
+// Measures a batch operation on rows of two columns
+#define ARRAY_BATCH_BINARY_BENCHMARK(NAME, FUNCTION, INITIAL)                          \
+    void NAME(benchmark::State &state, Shape shape) {                                  \
+        auto &left = getRows(shape, 1);                                                \
+        auto &right = getRows(shape, 2);                                               \
+        std::vector<decltype(INITIAL)> result(left.size(), INITIAL);                   \
+        measure(state, 2 * shape.size, 2 * shape.size * getElementSize(shape.type), [&]() { \
+            ArrayRuntime::FUNCTION(left.data(), right.data(), left.size(), shape.type, result.data()); \
+            return result[0];                                                          \
+        });                                                                            \
+    }
+
+void fromString(benchmark::State &state, Shape shape) {
+    auto &input = getInput(shape, 1);
+    measure(state, input.elements, input.text.size(), [&]() { return ArrayRuntime::fromString(input.literal, shape.type); });
+}
+
+void print(benchmark::State &state, Shape shape) {
+    auto &input = getInput(shape, 1);
+    DiscardPrintSink sink;
+    measure(state, input.elements, input.bytes, [&]() {
+        ArrayRuntime::print(input.array, shape.type, sink);
+        return 0;
+    });
+}
+
+ARRAY_UNARY_BENCHMARK(castToDouble, ArrayRuntime::cast(array, type, ElementType::DOUBLE))
+ARRAY_UNARY_BENCHMARK(castToString, ArrayRuntime::cast(array, type, ElementType::STRING))
+
+ARRAY_BINARY_BENCHMARK(appendArray, ArrayRuntime::append(leftArray, rightArray, type, type))
+ARRAY_UNARY_BENCHMARK(appendNull, ArrayRuntime::append(array, type))
+
+void appendValue(benchmark::State &state, Shape shape) {
+    auto &input = getInput(shape, 1);
+    VarLen32 array = input.array;
+    if (shape.type == ElementType::STRING) {
+        auto value = VarLen32::fromString("value");
+        measure(state, input.elements, input.bytes, [&]() { return ArrayRuntime::append(array, shape.type, value, false); });
+    } else {
+        withScalar(shape, [&](auto value) {
+            measure(state, input.elements, input.bytes, [&]() { return ArrayRuntime::append(array, shape.type, value, false); });
+        });
+    }
+}
+
+ARRAY_UNARY_BENCHMARK(slice, ArrayRuntime::slice(array, type, 1, std::max(1, getWidth(shape) / 2), 1))
+ARRAY_UNARY_BENCHMARK(subscript, ArrayRuntime::subscript(array, type, 1))
+
+ARRAY_BINARY_BENCHMARK(add, ArrayRuntime::add(leftArray, rightArray, type, type))
+ARRAY_BINARY_BENCHMARK(sub, ArrayRuntime::sub(leftArray, rightArray, type, type))
+ARRAY_BINARY_BENCHMARK(mul, ArrayRuntime::mul(leftArray, rightArray, type, type))
+ARRAY_BINARY_BENCHMARK(div, ArrayRuntime::div(leftArray, rightArray, type, type))
+
+/**
+ * This function measures the addition of a `DOUBLE` array to an array of the shape, either
+ * promoted by the kernel (`castFirst` false) or after casting the array to `DOUBLE`.
+ */
+void addDouble(benchmark::State &state, Shape shape, bool castFirst) {
+    auto &left = getInput(shape, 1);
+    auto &right = getInput(shape, 2);
+    ArenaAllocator operands;
+    ArrayAllocator::Scope scope(operands);
+    VarLen32 doubles = ArrayRuntime::cast(right.array, shape.type, ElementType::DOUBLE);
+    measure(state, left.elements + right.elements, left.bytes + right.bytes, [&]() {
+        if (!castFirst) return ArrayRuntime::add(left.array, doubles, shape.type, ElementType::DOUBLE);
+        auto cast = ArrayRuntime::cast(left.array, shape.type, ElementType::DOUBLE);
+        return ArrayRuntime::add(cast, doubles, ElementType::DOUBLE, ElementType::DOUBLE);
+    });
+}
+
+void addDoublePromoted(benchmark::State &state, Shape shape) {
+    addDouble(state, shape, false);
+}
+
+void addDoubleCast(benchmark::State &state, Shape shape) {
+    addDouble(state, shape, true);
+}
+
+ARRAY_UNARY_BENCHMARK(scalarAdd, withScalar(shape, [&](auto value) { return ArrayRuntime::scalarAdd(array, type, value); }))
+ARRAY_UNARY_BENCHMARK(scalarSub, withScalar(shape, [&](auto value) { return ArrayRuntime::scalarSub(array, type, value, false); }))
+ARRAY_UNARY_BENCHMARK(scalarMul, withScalar(shape, [&](auto value) { return ArrayRuntime::scalarMul(array, type, value); }))
+ARRAY_UNARY_BENCHMARK(scalarDiv, withScalar(shape, [&](auto value) { return ArrayRuntime::scalarDiv(array, type, value, false); }))
+
+ARRAY_BINARY_BENCHMARK(matrixMul, ArrayRuntime::matrixMul(leftArray, rightArray, type, type))
+ARRAY_BINARY_BENCHMARK(matrixMulTransposed, ArrayRuntime::matrixMul(leftArray, rightArray, type, type, false, true, 1.0))
+
+/**
+ * This function measures the addition of a matrix product to an accumulator (the product
+ * of the inputs, which has the element type and the shape of the result).
+ */
+void matrixMulAdd(benchmark::State &state, Shape shape) {
+    auto &left = getInput(shape, 1);
+    auto &right = getInput(shape, 2);
+    ArenaAllocator operands;
+    ArrayAllocator::Scope scope(operands);
+    VarLen32 accumulator = ArrayRuntime::matrixMul(left.array, right.array, shape.type, shape.type);
+    // Brain floating point products return floats and 32-bit integer products 64-bit integers
+    int32_t accumulatorType = shape.type;
+    if (shape.type == ElementType::BFLOAT) {
+        accumulatorType = ElementType::FLOAT;
+    } else if (shape.type == ElementType::INTEGER32) {
+        accumulatorType = ElementType::INTEGER64;
+    }
+    measure(state, left.elements + right.elements, left.bytes + right.bytes, [&]() {
+        return ArrayRuntime::matrixMulAdd(left.array, right.array, accumulator, shape.type, shape.type, accumulatorType, false, false, 1.0, 2.0);
+    });
+}
+
+void fillValue(benchmark::State &state, Shape shape) {
+    auto &structure = getStructure(shape);
+    size_t elements = std::pow(getWidth(shape), shape.dimensions);
+    if (shape.type == ElementType::STRING) {
+        auto value = VarLen32::fromString("value");
+        measure(state, elements, structure.bytes, [&]() { return ArrayRuntime::fill(value, structure.array, ElementType::INTEGER32); });
+    } else {
+        withScalar(shape, [&](auto value) {
+            measure(state, elements, structure.bytes, [&]() { return ArrayRuntime::fill(value, structure.array, ElementType::INTEGER32); });
+        });
+    }
+}
+
+void fillNull(benchmark::State &state, Shape shape) {
+    auto &structure = getStructure(shape);
+    size_t elements = std::pow(getWidth(shape), shape.dimensions);
+    measure(state, elements, structure.bytes, [&]() { return ArrayRuntime::fill(structure.array, ElementType::INTEGER32); });
+}
+
+ARRAY_UNARY_BENCHMARK(transpose, ArrayRuntime::transpose(array, type))
+
+void permute(benchmark::State &state, Shape shape) {
+    auto &input = getInput(shape, 1);
+    // Reverse the order of the dimensions
+    std::string text = "{";
+    for (uint32_t i = shape.dimensions; i > 0; i--) {
+        text += std::to_string(i) + (i > 1 ? "," : "}");
+    }
+    VarLen32 axes = ArrayRuntime::fromString(VarLen32::fromString(text), ElementType::INTEGER32);
+    measure(state, input.elements, input.bytes, [&]() { return ArrayRuntime::permute(input.array, shape.type, axes, ElementType::INTEGER32); });
+}
+ARRAY_UNARY_BENCHMARK(sigmoid, ArrayRuntime::sigmoid(array, type))
+ARRAY_UNARY_BENCHMARK(increment, ArrayRuntime::increment(array, type))
+
+ARRAY_UNARY_BENCHMARK(getHighestPosition, ArrayRuntime::getHighestPosition(array, type))
+ARRAY_UNARY_BENCHMARK(getLowestPosition, ArrayRuntime::getLowestPosition(array, type))
+
+ARRAY_UNARY_BENCHMARK(sum, ArrayRuntime::sum(array, type))
+ARRAY_UNARY_BENCHMARK(product, ArrayRuntime::product(array, type))
+ARRAY_UNARY_BENCHMARK(minimum, ArrayRuntime::minimum(array, type))
+ARRAY_UNARY_BENCHMARK(maximum, ArrayRuntime::maximum(array, type))
+ARRAY_UNARY_BENCHMARK(mean, ArrayRuntime::mean(array, type))
+ARRAY_UNARY_BENCHMARK(l1Norm, ArrayRuntime::l1Norm(array, type))
+ARRAY_UNARY_BENCHMARK(l2Norm, ArrayRuntime::l2Norm(array, type))
+
+ARRAY_BINARY_BENCHMARK(dot, ArrayRuntime::dot(leftArray, rightArray, type, type))
+ARRAY_BINARY_BENCHMARK(cosineSimilarity, ArrayRuntime::cosineSimilarity(leftArray, rightArray, type, type))
+ARRAY_BINARY_BENCHMARK(l2Distance, ArrayRuntime::l2Distance(leftArray, rightArray, type, type))
+ARRAY_BINARY_BENCHMARK(innerProduct, ArrayRuntime::innerProduct(leftArray, rightArray, type, type))
+
+ARRAY_BATCH_BINARY_BENCHMARK(batchAdd, add, VarLen32(nullptr, 0))
+ARRAY_BATCH_BINARY_BENCHMARK(batchSub, sub, VarLen32(nullptr, 0))
+ARRAY_BATCH_BINARY_BENCHMARK(batchMul, mul, VarLen32(nullptr, 0))
+ARRAY_BATCH_BINARY_BENCHMARK(batchDiv, div, VarLen32(nullptr, 0))
+
+ARRAY_BATCH_UNARY_BENCHMARK(batchSum, sum)
+ARRAY_BATCH_UNARY_BENCHMARK(batchProduct, product)
+ARRAY_BATCH_UNARY_BENCHMARK(batchMinimum, minimum)
+ARRAY_BATCH_UNARY_BENCHMARK(batchMaximum, maximum)
+ARRAY_BATCH_UNARY_BENCHMARK(batchL1Norm, l1Norm)
+ARRAY_BATCH_UNARY_BENCHMARK(batchL2Norm, l2Norm)
+
+ARRAY_BATCH_BINARY_BENCHMARK(batchDot, dot, 0.0)
+ARRAY_BATCH_BINARY_BENCHMARK(batchCosineSimilarity, cosineSimilarity, 0.0)
+ARRAY_BATCH_BINARY_BENCHMARK(batchL2Distance, l2Distance, 0.0)
+ARRAY_BATCH_BINARY_BENCHMARK(batchInnerProduct, innerProduct, 0.0)
+
+// A benchmarked operation and the shapes it supports.
+struct Definition {
+    const char *name;
+    bool (*accepts)(const Shape &);
+    void (*run)(benchmark::State &, Shape);
+};
+
+const Definition DEFINITIONS[] = {
+    {"fromString", isAny, fromString},
+    {"print", isAny, print},
+    {"cast/double", isNumeric, castToDouble},
+    {"cast/string", isNumeric, castToString},
+    {"append/array", isAny, appendArray},
+    {"append/value", isAny, appendValue},
+    {"append/null", isAny, appendNull},
+    {"slice", isAny, slice},
+    {"subscript", isAny, subscript},
+    {"add", isNumeric, add},
+    {"sub", isNumeric, sub},
+    {"mul", isNumeric, mul},
+    {"div", isNumeric, div},
+    {"add/double", isNumericButDouble, addDoublePromoted},
+    {"add/castDouble", isNumericButDouble, addDoubleCast},
+    {"scalarAdd", isNumeric, scalarAdd},
+    {"scalarSub", isNumeric, scalarSub},
+    {"scalarMul", isNumeric, scalarMul},
+    {"scalarDiv", isNumeric, scalarDiv},
+    {"matrixMul", isMatrix, matrixMul},
+    {"matrixMul/transposed", isMatrix, matrixMulTransposed},
+    {"matrixMulAdd", isMatrix, matrixMulAdd},
+    {"matrixMul/batched", isMatrixBatch, matrixMul},
+    {"fill/value", isFillable, fillValue},
+    {"fill/null", isFillable, fillNull},
+    {"transpose", isRectangular, transpose},
+    {"permute", isRectangular, permute},
+    {"sigmoid", isNumeric, sigmoid},
+    {"increment", isAny, increment},
+    {"getHighestPosition", isAny, getHighestPosition},
+    {"getLowestPosition", isAny, getLowestPosition},
+    {"sum", isNumeric, sum},
+    {"product", isNumeric, product},
+    {"minimum", isNumeric, minimum},
+    {"maximum", isNumeric, maximum},
+    {"mean", isNumeric, mean},
+    {"l1Norm", isNumeric, l1Norm},
+    {"l2Norm", isNumeric, l2Norm},
+    {"dot", isFloatingPointWithoutNulls, dot},
+    {"cosineSimilarity", isFloatingPointWithoutNulls, cosineSimilarity},
+    {"l2Distance", isFloatingPointWithoutNulls, l2Distance},
+    {"innerProduct", isFloatingPointWithoutNulls, innerProduct},
+    {"batch/add", isNumeric, batchAdd},
+    {"batch/sub", isNumeric, batchSub},
+    {"batch/mul", isNumeric, batchMul},
+    {"batch/div", isNumeric, batchDiv},
+    {"batch/sum", isNumeric, batchSum},
+    {"batch/product", isNumeric, batchProduct},
+    {"batch/minimum", isNumeric, batchMinimum},
+    {"batch/maximum", isNumeric, batchMaximum},
+    {"batch/l1Norm", isNumeric, batchL1Norm},
+    {"batch/l2Norm", isNumeric, batchL2Norm},
+    {"batch/dot", isFloatingPointWithoutNulls, batchDot},
+    {"batch/cosineSimilarity", isFloatingPointWithoutNulls, batchCosineSimilarity},
+    {"batch/l2Distance", isFloatingPointWithoutNulls, batchL2Distance},
+    {"batch/innerProduct", isFloatingPointWithoutNulls, batchInnerProduct},
+};
+
+/**
+ * This function registers every operation for every supported shape. The shapes are the
+ * outer loop, so consecutive benchmarks share their generated inputs.
+ */
+void registerBenchmarks() {
+    const size_t sizes[] = {10, 1000, 100000, 10000000};
+    for (size_t size : sizes) {
+        for (int32_t type = ElementType::INTEGER32; type <= ElementType::STRING; type++) {
+            for (uint32_t dimensions = 1; dimensions <= 3; dimensions++) {
+                // Every one-dimensional array is rectangular
+                for (bool ragged : {false, true}) {
+                    if (ragged && dimensions == 1) continue;
+                    for (uint32_t nullPercent : {0u, 10u}) {
+                        Shape shape{type, dimensions, ragged, nullPercent, size};
+                        for (auto &definition : DEFINITIONS) {
+                            if (!definition.accepts(shape)) continue;
+                            auto name = std::string(definition.name) + "/" + shape.getName();
+                            benchmark::RegisterBenchmark(name.c_str(), definition.run, shape);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
+
+int main(int argc, char **argv) {
+    registerBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
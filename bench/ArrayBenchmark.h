@@ -0,0 +1,90 @@
+#ifndef LINGODB_RUNTIME_ARRAYBENCHMARK_H
+#define LINGODB_RUNTIME_ARRAYBENCHMARK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ArrayRuntime.h"
+
+namespace lingodb::runtime::bench {
+
+// The element types as passed to `ArrayRuntime` (the same order as `Array::ArrayType`).
+enum ElementType : int32_t {
+    INTEGER32,
+    INTEGER64,
+    BFLOAT,
+    FLOAT,
+    DOUBLE,
+    STRING,
+};
+
+/**
+ * This struct describes the arrays a single benchmark is executed with.
+ */
+struct Shape {
+    // The element type (see `ElementType`)
+    int32_t type;
+    // The number of dimensions
+    uint32_t dimensions;
+    // Whether the widths of a dimension differ between its subarrays
+    bool ragged;
+    // The percentage of NULL values among the elements
+    uint32_t nullPercent;
+    // The targeted number of elements (including NULL values)
+    size_t size;
+
+    /**
+     * This method returns the name of the shape (e.g. `type:float/dims:2/ragged:0/nulls:10/size:1000`).
+     */
+    std::string getName() const;
+
+    bool operator==(const Shape &other) const;
+};
+
+/**
+ * This struct is a generated input array.
+ */
+struct Input {
+    // The array literal
+    std::string text;
+    // The array literal as input of `ArrayRuntime::fromString`
+    VarLen32 literal;
+    // The array in its binary representation
+    VarLen32 array;
+    // The number of elements (including NULL values)
+    size_t elements;
+    // The number of bytes of the binary representation
+    size_t bytes;
+};
+
+/**
+ * This function returns an array of the given shape. Arrays with the same shape share
+ * their structure (every width is the same), `seed` only changes their values.
+ * The arrays remain valid until an array of another shape is requested.
+ *
+ * @param shape The shape of the array.
+ * @param seed The seed of the element values.
+ */
+const Input &getInput(const Shape &shape, uint32_t seed);
+
+/**
+ * This function returns arrays that consist of `shape.size` elements in total. Each row
+ * has the shape, but at most `ROW_SIZE` elements. The rows remain valid until an array of
+ * another shape is requested.
+ *
+ * @param shape The shape of all rows.
+ * @param seed The seed of the element values.
+ */
+const std::vector<VarLen32> &getRows(const Shape &shape, uint32_t seed);
+
+// The maximum number of elements of a single row (see `getRows`).
+constexpr size_t ROW_SIZE = 64;
+
+/**
+ * This function returns a one-dimensional INTEGER32 array that stores the dimension
+ * lengths of a rectangular array with the given shape (the structure argument of `fill`).
+ */
+const Input &getStructure(const Shape &shape);
+
+}
+#endif
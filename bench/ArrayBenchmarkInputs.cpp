@@ -0,0 +1,150 @@
+#include "ArrayBenchmark.h"
+#include "ArrayGenerator.h"
+#include <cmath>
+#include <map>
+#include <memory>
+
+using lingodb::runtime::bench::Shape;
+using lingodb::runtime::bench::Input;
+using lingodb::runtime::ArrayAllocator;
+using lingodb::runtime::ArenaAllocator;
+using lingodb::runtime::Array;
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::bench::ElementType;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::ArrayGenerator;
+using lingodb::runtime::ArraySpecification;
+
+namespace {
+
+const char *TYPE_NAMES[] = {"int32", "int64", "bfloat", "float", "double", "string"};
+
+/**
+ * This function returns the width of every dimension of a rectangular array with the given shape.
+ */
+uint32_t getWidth(const Shape &shape) {
+    return std::max(1L, std::lround(std::pow(static_cast<double>(shape.size), 1.0 / shape.dimensions)));
+}
+
+/**
+ * This function returns a generator of the given shape. The structure seed only depends on
+ * the shape, so generators with different value seeds create arrays of the same structure.
+ */
+ArrayGenerator getGenerator(const Shape &shape, uint32_t seed) {
+    ArraySpecification specification;
+    specification.type = shape.type;
+    auto width = getWidth(shape);
+    ArraySpecification::Dimension dimension;
+    dimension.minWidth = shape.ragged ? 1 : width;
+    dimension.maxWidth = shape.ragged ? 2 * width - 1 : width;
+    specification.dimensions.assign(shape.dimensions, dimension);
+    specification.nullDensity = shape.nullPercent / 100.0;
+    // Values are never zero, so they can be used as divisors
+    specification.minValue = 1;
+    specification.maxValue = 1000;
+    return ArrayGenerator(specification, shape.dimensions * 31 + shape.size, seed);
+}
+
+// The inputs of the current shape (the memory of the arrays is released with the next shape)
+struct InputCache {
+    bool valid = false;
+    Shape shape;
+    ArenaAllocator allocator;
+    std::map<uint32_t, Input> inputs;
+    std::map<uint32_t, std::vector<VarLen32>> rows;
+    std::unique_ptr<Input> structure;
+};
+
+/**
+ * This function returns the inputs of the given shape (all other inputs are released).
+ */
+InputCache &getCache(const Shape &shape) {
+    static InputCache cache;
+    if (!cache.valid || !(cache.shape == shape)) {
+        cache.inputs.clear();
+        cache.rows.clear();
+        cache.structure.reset();
+        cache.allocator.reset();
+        cache.shape = shape;
+        cache.valid = true;
+    }
+    return cache;
+}
+
+/**
+ * This function creates an input from an array (the memory is taken from the cache).
+ */
+Input createInput(InputCache &cache, VarLen32 array, int32_t type) {
+    ArrayAllocator::Scope scope(cache.allocator);
+    Array created(array, type);
+    auto text = created.print();
+    auto literal = VarLen32::fromString(text);
+    return Input{std::move(text), literal, array, created.getSize(true), array.getLen()};
+}
+
+/**
+ * This function creates the next array of a generator (the memory is taken from the cache).
+ */
+VarLen32 generate(InputCache &cache, ArrayGenerator &generator) {
+    ArrayAllocator::Scope scope(cache.allocator);
+    return generator.next();
+}
+
+}
+
+std::string Shape::getName() const {
+    return std::string("type:") + TYPE_NAMES[this->type] + "/dims:" + std::to_string(this->dimensions) + "/ragged:" + std::to_string(this->ragged) +
+        "/nulls:" + std::to_string(this->nullPercent) + "/size:" + std::to_string(this->size);
+}
+
+bool Shape::operator==(const Shape &other) const {
+    return this->type == other.type && this->dimensions == other.dimensions && this->ragged == other.ragged &&
+        this->nullPercent == other.nullPercent && this->size == other.size;
+}
+
+const Input &lingodb::runtime::bench::getInput(const Shape &shape, uint32_t seed) {
+    auto &cache = getCache(shape);
+    auto entry = cache.inputs.find(seed);
+    if (entry == cache.inputs.end()) {
+        auto generator = getGenerator(shape, seed);
+        entry = cache.inputs.emplace(seed, createInput(cache, generate(cache, generator), shape.type)).first;
+    }
+    return entry->second;
+}
+
+const std::vector<VarLen32> &lingodb::runtime::bench::getRows(const Shape &shape, uint32_t seed) {
+    auto &cache = getCache(shape);
+    auto entry = cache.rows.find(seed);
+    if (entry == cache.rows.end()) {
+        Shape rowShape = shape;
+        rowShape.size = std::min(shape.size, ROW_SIZE);
+        size_t count = (shape.size + rowShape.size - 1) / rowShape.size;
+        // A single generator creates every row, so the rows differ in their (ragged) structure
+        auto generator = getGenerator(rowShape, seed);
+        std::vector<VarLen32> rows;
+        rows.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            rows.push_back(generate(cache, generator));
+        }
+        entry = cache.rows.emplace(seed, std::move(rows)).first;
+    }
+    return entry->second;
+}
+
+const Input &lingodb::runtime::bench::getStructure(const Shape &shape) {
+    auto &cache = getCache(shape);
+    if (!cache.structure) {
+        std::string text = "{";
+        for (uint32_t i = 0; i < shape.dimensions; i++) {
+            if (i != 0) text += ',';
+            text += std::to_string(getWidth(shape));
+        }
+        text += '}';
+        auto array = [&] {
+            ArrayAllocator::Scope scope(cache.allocator);
+            return ArrayRuntime::fromString(VarLen32::fromString(text), ElementType::INTEGER32);
+        }();
+        cache.structure = std::make_unique<Input>(createInput(cache, array, ElementType::INTEGER32));
+    }
+    return *cache.structure;
+}
@@ -3,14 +3,23 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <charconv>
 #include <vector>
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
 #include <cstring>
 #include <tuple>
+#include <utility>
+#include <type_traits>
 #include "ArrayArithmetic.h"
+#include "../include/ArraySimd.h"
 #include "../include/VarLen32.h"
+#include "../include/ArrayAllocator.h"
+#include "../include/ArrayBuilder.h"
+#include "../include/ArrayPrintSink.h"
+#include "../include/ArrayThreadPool.h"
 #include "../include/Types.h" 
 
 namespace lingodb::runtime {
@@ -27,8 +36,15 @@ namespace lingodb::runtime {
  * widths = 2,2,2,3,3,3,3 
  * elements = ...
  * nulls = 0000.1000, 0000.0000 (bitstrings - from left to right) 
+ * 
+ * Binary format (version 2): `Header`, indices, dimensionWidthMap, widths, padding,
+ * elements (aligned to `ELEMENT_ALIGNMENT`), nulls, strings. Arrays in version 1
+ * (no counts, offsets and padding) can still be read.
  */
 class Array {
+    // Creates arrays with the writers of the binary format
+    friend class ArrayGenerator;
+
     private:
     // The type of the array elements (only necessary for printing).
     uint8_t type;
@@ -36,6 +52,12 @@ class Array {
     uint32_t dimensions;
     // The number of elements in this array (without NULL values).
     uint32_t size;
+    // The number of elements in this array (with NULL values).
+    uint32_t totalSize;
+    // The number of width entries in this array.
+    uint32_t widthSize;
+    // The total length of all string elements (if array stores strings).
+    uint32_t stringSize;
     // A pointer to the first index values of each dimension.
     int32_t *indices;
     // A pointer to the number of width values for each dimension.
@@ -48,11 +70,48 @@ class Array {
     uint8_t *nulls;
     // A pointer to the first character of a string (if array stores strings).
     char *strings;
+    // The number of NULL values in front of each 64-bit word of the NULL bitstrings (rank index).
+    std::vector<uint32_t> nullRanks;
+
+    // The position of the first child and of the first element of a width entry.
+    struct WidthOffset {
+        uint32_t child;
+        uint32_t element;
+    };
+    // The offsets of each width entry (prefix sums per dimension). Each dimension has an additional
+    // entry behind its last width, so width `i` of dimension `d` is stored at `i + d - 1`.
+    std::vector<WidthOffset> widthOffsets;
+
+    // The fixed part of the binary format (version 2). It is followed by the indices, the
+    // dimension width map and the widths. The elements start at an aligned offset.
+    struct Header {
+        char identifier[5];
+        uint8_t version;
+        uint8_t type;
+        uint8_t reserved;
+        uint32_t dimensions;
+        uint32_t size;
+        uint32_t totalSize;
+        uint32_t widthSize;
+        uint32_t stringSize;
+        uint32_t elementOffset;
+        uint32_t nullOffset;
+        uint32_t stringOffset;
+    };
+
+    // The version of the binary format written by this class. Version 1 stores the element
+    // type at this position (always smaller than this value) and no offsets.
+    static constexpr uint8_t FORMAT_VERSION = 0x82;
+    // The alignment of the element section (relative to the beginning of the array).
+    static constexpr uint32_t ELEMENT_ALIGNMENT = 64;
+    // The maximum number of characters of a formatted numeric element.
+    static constexpr uint32_t MAX_ELEMENT_CHARS = 32;
 
     // This enumeration specifies all array element types
     enum ArrayType {
         INTEGER32,
         INTEGER64,
+        // Brain floating point numbers (see `BFloat16`)
         BFLOAT,
         FLOAT,
         DOUBLE,
@@ -77,15 +136,16 @@ class Array {
 
     /**
      * This function casts a string into a value of the corresponding type `TYPE` and
-     * copy its value to the given pointer.
+     * copy its value to the given pointer. Numbers are parsed with `std::from_chars`
+     * (surrounding whitespace and a leading `+` are ignored), so nothing is allocated.
      * 
      * @param buffer A reference to the pointer in which the casted element should be copied.
-     * @param value A reference to the string which should be casted.
+     * @param value The characters which should be casted.
      * @throws `std::runtime_error`: If the value could not be casted or if the resulting
      * value is out of range.
      */
     template<class TYPE>
-    static void castAndCopyElement(char *&buffer, std::string &value);
+    static void castAndCopyElement(char *&buffer, std::string_view value);
 
     /**
      * This function casts the array elements at a certain position to the provided type
@@ -125,6 +185,58 @@ class Array {
      * @throws `std::runtime_error`: If the provided type is not supported.
      */
     static size_t getStringSize(uint32_t dimensions, uint32_t size, uint32_t widths, uint32_t nullSize, uint32_t stringSize, uint8_t type);
+
+    /**
+     * This function returns the offset of the element section in the binary format, which
+     * is the size of the header, indices and widths rounded up to `ELEMENT_ALIGNMENT`.
+     * 
+     * @param dimensions The number of dimensions.
+     * @param widths The number of widths elements.
+     * @return The offset in bytes.
+     */
+    static uint32_t getElementOffset(uint32_t dimensions, uint32_t widths);
+
+    /**
+     * This function writes the header of the binary format. It must be followed by the
+     * indices, the dimension width map, the widths and `writePadding`.
+     * 
+     * @param buffer A reference to a char pointer which points to the string
+     * that should store the result.
+     * @param type The type of each array element.
+     * @param dimensions The number of dimensions.
+     * @param size The number of elements (without NULL).
+     * @param totalSize The number of elements (with NULL).
+     * @param widths The number of widths elements.
+     * @param stringSize The total length of all string elements (if array stores string values).
+     */
+    static void writeHeader(char *&buffer, uint8_t type, uint32_t dimensions, uint32_t size, uint32_t totalSize, uint32_t widths, uint32_t stringSize);
+
+    /**
+     * This function fills the gap between the widths and the element section with zeros.
+     * 
+     * @param buffer A reference to a char pointer which points behind the last width.
+     * @param dimensions The number of dimensions.
+     * @param widths The number of widths elements.
+     */
+    static void writePadding(char *&buffer, uint32_t dimensions, uint32_t widths);
+
+    /**
+     * This function returns the number of widths elements of a rectangular array.
+     * 
+     * @param sizes The size of every dimension.
+     * @return The number of widths elements.
+     */
+    static uint32_t getRectangularWidthSize(const std::vector<uint32_t> &sizes);
+
+    /**
+     * This function writes the indices, the dimension width map, the widths and the padding
+     * of a rectangular array (behind `writeHeader`).
+     * 
+     * @param buffer A reference to a char pointer which points behind the header.
+     * @param sizes The size of every dimension.
+     * @param indices The index of every dimension.
+     */
+    static void writeRectangularStructure(char *&buffer, const std::vector<uint32_t> &sizes, const std::vector<int32_t> &indices);
     
     /**
      * This function returns the size of a specific element type.
@@ -191,6 +303,23 @@ class Array {
     template<class TYPE>
     void toString(uint32_t position, std::string &target);
 
+    /**
+     * This function formats a numeric value with `std::to_chars`. Floating point values
+     * are written with the fewest digits that are parsed back to the same value.
+     *
+     * @param target A pointer to at least `MAX_ELEMENT_CHARS` characters.
+     * @param value The value which should be formatted.
+     * @return The number of written characters.
+     */
+    template<class TYPE>
+    static uint32_t formatElement(char *target, TYPE value);
+
+    /**
+     * This function formats a brain floating point number with the fewest digits that
+     * are parsed back to the same brain floating point number (see `formatElement`).
+     */
+    static uint32_t formatBFloat16(char *target, BFloat16 value);
+
     /**
      * This method appends a single element of type `TYPE` to the last array structure
      * (lowest dimension). This method should only be used to append primitive elements.
@@ -211,16 +340,51 @@ class Array {
     template<class TYPE>
     VarLen32 appendElementFront(TYPE value);
 
+    // The element type of the result of an arithmetic operation with a `LEFT` and a `RIGHT`
+    // operand (see `getPromotedType`).
+    template<class LEFT, class RIGHT>
+    using Promoted = std::conditional_t<std::is_same_v<LEFT, RIGHT>, LEFT,
+        std::conditional_t<std::is_integral_v<LEFT> && std::is_integral_v<RIGHT>, int64_t,
+        std::conditional_t<std::is_integral_v<LEFT> || std::is_integral_v<RIGHT> ||
+            std::is_same_v<LEFT, double> || std::is_same_v<RIGHT, double>, double, float>>>;
+
+    /**
+     * This function returns the enum (`ArrayType`) value of the numeric element type `TYPE`.
+     */
+    template<class TYPE>
+    static constexpr uint8_t getElementType() {
+        if constexpr (std::is_same_v<TYPE, int32_t>) return ArrayType::INTEGER32;
+        else if constexpr (std::is_same_v<TYPE, int64_t>) return ArrayType::INTEGER64;
+        else if constexpr (std::is_same_v<TYPE, BFloat16>) return ArrayType::BFLOAT;
+        else if constexpr (std::is_same_v<TYPE, float>) return ArrayType::FLOAT;
+        else return ArrayType::DOUBLE;
+    }
+
     /**
-     * This method executes a specified binary scalar operation (`OP`).
+     * This function calls `function` with a null pointer to the numeric element type `type`
+     * (only the type of the pointer is used) and returns its result.
+     * 
+     * @param type The element type.
+     * @param function A generic function that takes a pointer.
+     * @throws `std::runtime_error`: If the element type is not numeric.
+     */
+    template<class FUNCTION>
+    static auto dispatchNumericType(uint8_t type, FUNCTION &&function);
+
+    /**
+     * This method executes a specified binary scalar operation (`OP`). The elements and the
+     * scalar are promoted to a common type (see `getPromotedType`) while the kernel loads
+     * them. A float is rounded once for `BFLOAT` arrays, whose result stays a `BFLOAT` array.
      * 
      * @param value The scalar value of type `TYPE`. Should be numeric type.
      * @param isLeft If the scalar is on the left side of the operation.
+     * @param operation The name of the calling function (used for error messages).
+     * @throws `std::runtime_error`: If the array type is not numeric.
      * @return The result of the binary scalar operation as string in array
      * processable format. 
      */
     template<class TYPE, class OP>
-    VarLen32 executeScalarOperation(TYPE value, bool isLeft);
+    VarLen32 executeScalarOperation(TYPE value, bool isLeft, const std::string &operation);
 
     /**
      * This method executes a specified activation function (`OP`).
@@ -232,7 +396,9 @@ class Array {
     VarLen32 executeActivationFunction();
 
     /**
-     * This function executes a specified binary function `OP` with numeric values.
+     * This function executes a specified binary function `OP` with `LEFT` and `RIGHT` values
+     * and stores values of type `RESULT` (see `ArraySimd::getPromotingKernel`). The kernel
+     * is chosen by the instruction set of the executing CPU (see `ArraySimd`).
      * 
      * @param left A pointer to the value of the first parameter of the binary function.
      * @param right A pointer to the value of the second parameter of the binary function.
@@ -241,11 +407,9 @@ class Array {
      * that should store the result.
      * @param scalarLeft If the left parameter points to a single element.
      * @param scalarRight If the right parameter points to a single element. 
-     * @param type The element type.
-     * @throws `std::runtime_error`: If the array type is not supported in this function.
      */
-    template<class OP>
-    static void executeBinaryOperation(const uint8_t *left, const uint8_t *right, uint32_t size, char *&buffer, bool scalarLeft, bool scalarRight, uint8_t type);
+    template<class LEFT, class RIGHT, class RESULT, class OP>
+    static void executeBinaryKernel(const LEFT *left, const RIGHT *right, uint32_t size, char *&buffer, bool scalarLeft, bool scalarRight);
 
     /**
      * This function executes a specified unary function `OP` with numeric values.
@@ -285,10 +449,163 @@ class Array {
     static VarLen32 generate(Array &structure, uint8_t type);
 
     /**
-     * This method returns the index of the largest value stored in this array.
+     * This method returns the index (including NULL values) of the largest (`HIGHEST`) or
+     * smallest value stored in this array. If several elements are equal, the first one is
+     * returned. The elements are visited once.
+     */
+    template<class TYPE, bool HIGHEST>
+    int32_t getExtremePosition();
+
+    /**
+     * This method returns the index (including NULL values) of the largest (`HIGHEST`) or
+     * smallest element. Strings are compared by their length.
+     * 
+     * @throws `std::runtime_error`: If the element type is not supported.
+     */
+    template<bool HIGHEST>
+    int32_t getExtremePosition();
+
+    /**
+     * This method reduces all elements (without NULL values) into a single value.
+     * 
+     * @param op The reduction.
+     * @throws `std::runtime_error`: If the element type is not supported.
+     */
+    double executeReduction(ReductionOperator op);
+
+    /**
+     * This method reduces all elements of the given type. Large arrays are reduced in chunks of
+     * `ArrayThreadPool::CHUNK_SIZE` elements (possibly in parallel), whose results are combined
+     * in the order of the chunks.
+     * 
+     * @param op The reduction.
+     */
+    template<class TYPE>
+    double executeReduction(ReductionOperator op);
+
+    /**
+     * This method computes a measure between the elements of this array and the elements
+     * of another array in a single pass (both arrays are read as flat vectors).
+     * 
+     * @param other The second vector.
+     * @param op The measure.
+     * @param operation The name of the calling function (used for error messages).
+     * @throws `std::runtime_error`: If one of the following points is true:
+     * - If the array element type is not a floating point type.
+     * - If both arrays have different types.
+     * - If NULL values are identified.
+     * - If both arrays have a different number of elements.
+     */
+    double executeDistance(Array &other, DistanceOperator op, const std::string &operation);
+
+    /**
+     * This method checks a cosine similarity of this array and another array. The kernel
+     * divides by the lengths of both vectors, so a vector of length 0 yields NaN.
+     * 
+     * @param similarity The cosine similarity computed by the kernel.
+     * @param other The second vector.
+     * @throws `std::runtime_error`: If one of both vectors has length 0.
+     */
+    void checkCosineSimilarity(double similarity, Array &other);
+
+    /**
+     * This method proofs if every element of the array is zero (the array is a vector of length 0).
+     */
+    bool isZeroVector();
+
+    /**
+     * This method checks if the elements of this array can be combined element-wise
+     * with the elements of another array (of the same type).
+     * 
+     * @param other The second operand.
+     * @param operation The name of the calling function (used for error messages).
+     * @throws `std::runtime_error`: If both arrays have unequal array structures (unequal
+     * dimensions or widths).
+     */
+    void checkBinaryStructure(Array &other, const std::string &operation);
+
+    /**
+     * This method combines the NULL bits of this array and of another array with the same
+     * structure (a position is NULL if it is NULL in either array).
+     * 
+     * @param other The second operand.
+     * @param combined A reference to a vector that receives the combined NULL words (see
+     * `getNullWord`). It stays empty if neither array has NULL values.
+     * @return The number of positions that are not NULL in both arrays.
+     */
+    uint32_t getCombinedNulls(Array &other, std::vector<uint64_t> &combined);
+
+    /**
+     * This method copies the elements of every position that is not NULL in the combined
+     * NULL words (see `getCombinedNulls`). Such positions are never NULL in this array.
+     * 
+     * @param combined The combined NULL words.
+     * @param target A pointer to the first selected element.
      */
     template<class TYPE>
-    int32_t getMaxIndex();
+    void gatherElements(const std::vector<uint64_t> &combined, TYPE *target);
+
+    /**
+     * This method returns the elements of this array (of type `LEFT`) and of another array
+     * (of type `RIGHT`) with the same structure at the positions that are not NULL in both
+     * arrays, so they can be combined by a kernel. An operand whose NULL values are the
+     * combined NULL values is used directly, otherwise its elements are gathered.
+     * 
+     * @param other The second operand.
+     * @param combined The combined NULL words (see `getCombinedNulls`).
+     * @param size The number of positions that are not NULL in both arrays.
+     * @param target A pointer to `size` elements that may receive the left elements (e.g. the
+     * result, so the kernel works in place). If it is `nullptr`, they are gathered into `left`.
+     * @param left A reference to a vector that may receive the left elements.
+     * @param right A reference to a vector that may receive the right elements.
+     * @return The pointers to the first left and the first right element.
+     */
+    template<class LEFT, class RIGHT>
+    std::pair<const LEFT*, const RIGHT*> alignOperands(Array &other, const std::vector<uint64_t> &combined, uint32_t size, LEFT *target, std::vector<LEFT> &left, std::vector<RIGHT> &right);
+
+    /**
+     * This function writes NULL words (see `getNullWord`) as NULL bits of `totalSize` positions.
+     * 
+     * @param buffer A reference to the string buffer where the content needs to be stored.
+     * @param words The NULL words.
+     * @param totalSize The number of positions.
+     */
+    static void writeNullWords(char *&buffer, const std::vector<uint64_t> &words, uint32_t totalSize);
+
+    /**
+     * This method applies the element-wise operation `OP` to this array and another array
+     * with the same structure. A position of the result is NULL if it is NULL in either array,
+     * only the remaining positions are computed. Arrays of different types are promoted to a
+     * common type (see `getPromotedType`) while the kernel loads their elements.
+     * 
+     * @param other The second operand.
+     * @param operation The name of the calling function (used for error messages).
+     * @throws `std::runtime_error`: If an array type is not numeric. If both arrays have
+     * unequal array structures.
+     * @return The result array as string in array processable format.
+     */
+    template<class OP>
+    VarLen32 executeElementwiseOperation(Array &other, const std::string &operation);
+
+    /**
+     * This function applies the element-wise operation `OP` to pairs of arrays with
+     * elements of type `TYPE` (see `executeBatchOperation`).
+     */
+    template<class TYPE, class OP>
+    static void executeBatchKernel(const VarLen32 *left, const VarLen32 *right, size_t count, uint8_t type, VarLen32 *result, const std::string &operation, uint64_t &inputElements);
+
+    /**
+     * This function reduces arrays with elements of type `TYPE` (see `executeBatchReduction`).
+     */
+    template<class TYPE>
+    static void executeBatchReduction(const VarLen32 *arrays, size_t count, uint8_t type, ReductionOperator op, double *result, const std::string &operation, uint64_t &inputElements);
+
+    /**
+     * This function computes a measure between pairs of arrays with elements of type
+     * `TYPE` (see `executeBatchDistance`).
+     */
+    template<class TYPE>
+    static void executeBatchDistance(const VarLen32 *left, const VarLen32 *right, size_t count, uint8_t type, DistanceOperator op, double *result, const std::string &operation, uint64_t &inputElements);
 
     /**
      * This method returns the size of a particular dimension by returning
@@ -301,8 +618,8 @@ class Array {
     uint32_t getDimensionSize(uint32_t dimension);
 
     /**
-     * This method returns the index of the first element that
-     * belongs to the provided width entry.
+     * This method returns the index of the first element (including NULL values)
+     * that belongs to the provided width entry.
      * 
      * @param width A pointer to a width entry of the last dimension.
      * @throws `std::runtime_error`: If the provided width could not be
@@ -310,25 +627,77 @@ class Array {
      */
     uint32_t getOffset(const uint32_t *width);
 
+    /**
+     * This method returns the index of the first element (including NULL values)
+     * that belongs to the provided width entry or to one of its children.
+     * 
+     * @param width A pointer to a width entry.
+     * @param dimension The dimension of the given width entry. 
+     * @throws `std::runtime_error`: If the provided width could not be
+     * found in the width entries of the dimension.
+     */
+    uint32_t getOffset(const uint32_t *width, uint32_t dimension);
+
+    // The read positions of a single pass over the array while it is printed.
+    struct PrintCursor {
+        // The next width of each dimension
+        std::vector<const uint32_t*> widths;
+        // The next position (including NULL values)
+        uint32_t position;
+        // The next element (without NULL values)
+        uint32_t element;
+        // The first character of the next string
+        uint32_t stringOffset;
+        // The preformatted numeric elements (one text per chunk of `ArrayThreadPool::CHUNK_SIZE` elements)
+        std::vector<std::string> formatted;
+        // The number of characters of each preformatted element
+        std::vector<uint8_t> formattedLengths;
+        // The first character of the next element in its preformatted text
+        uint32_t formattedOffset;
+    };
+
     /**
      * This method transforms the array into its string representation (for printing).
-     * This method will be called recursively over each width entry.
+     * This method will be called recursively for each subarray in the order in which they
+     * are stored, so every width, NULL bit and element is read exactly once.
      * 
-     * @param target A reference to a string in which the result should be stored.
-     * @param width A pointer to the width element that is processed.
+     * @param sink The output that receives the result.
+     * @param cursor The read positions, which are advanced past the printed subarray.
      * @param dimension The current dimension.
-     * @throws `std::runtime_error`: If the provided array structure is
-     * not valid (processable).
      */
-    void printArray(std::string &target, const uint32_t *width, uint32_t dimension);
+    void printArray(PrintSink &sink, PrintCursor &cursor, uint32_t dimension);
+
+    /**
+     * This method prints the elements of a subarray in the lowest dimension.
+     *
+     * @param sink The output that receives the result.
+     * @param cursor The read positions, which are advanced past the printed elements.
+     * @param width The number of elements (including NULL values).
+     */
+    template<class TYPE>
+    void printElements(PrintSink &sink, PrintCursor &cursor, uint32_t width);
+
+    /**
+     * This method formats all numeric elements in independent chunks (possibly in parallel),
+     * so the pass over the structure only has to copy their text.
+     *
+     * @param cursor The read positions that receive the formatted elements.
+     */
+    template<class TYPE>
+    void formatElements(PrintCursor &cursor);
 
     /**
-     * This method prints the stored header to the target string, if at least a single
+     * This method prints the stored header to the sink, if at least a single
      * stored index is not the default value (1).
      * 
-     * @param target A reference to the target string to which the header should be appended. 
+     * @param sink The output to which the header should be appended. 
      */
-    void printHeader(std::string &target);
+    void printHeader(PrintSink &sink);
+
+    /**
+     * This method estimates the number of characters of the string representation.
+     */
+    size_t estimatePrintSize();
 
     /**
      * This method proofs if the given position is a NULL value.
@@ -339,15 +708,65 @@ class Array {
      */
     bool isNull(uint32_t position);
 
+    /**
+     * This method returns 64 NULL bits starting at position `64 * word` as a single
+     * integer. The first position is stored in the most significant bit. Bits
+     * behind the last position are zero.
+     * 
+     * @param word The index of the 64-bit word.
+     */
+    uint64_t getNullWord(uint32_t word);
+
+    /**
+     * This method builds the rank index over the NULL bitstrings (only if it
+     * does not exist yet and if the array contains NULL values).
+     */
+    void buildNullIndex();
+
+    /**
+     * This method builds the offsets of each width entry (only if they do not exist yet).
+     * Afterwards the first child and the first element of a width entry can be found
+     * without iterating over the widths.
+     */
+    void buildWidthIndex();
+
+    /**
+     * This method returns the offsets of the given width entry.
+     * 
+     * @param width A pointer to a width entry.
+     * @param dimension The dimension of the given width entry. 
+     * @throws `std::runtime_error`: If the width entry does not belong to the dimension.
+     */
+    const WidthOffset &getWidthOffset(const uint32_t *width, uint32_t dimension);
+
+    /**
+     * This constructor generates an array object which reads all data directly from the
+     * given memory (without copying it).
+     * @param data A pointer to the first byte of the array data.
+     * @param length The number of bytes of the array data.
+     * @param type The enum (`ArrayType`) value of the element type.
+     * @throws `std::runtime_error`: If the given data is empty or does not include the array 
+     * identification header. 
+     */
+    Array(char *data, size_t length, int32_t type);
+
     /**
      * This method initializes every attribute of this class except the type 
-     * attribute.
+     * attribute. Both versions of the binary format are accepted.
      * 
-     * @param data A pointer to the string that stores the array in array 
+     * @param data A pointer to the first character of the array in array 
      * processable format.
      */
     void initArray(char *data);
 
+    /**
+     * This method initializes every attribute of this class except the type
+     * attribute from an array in the first version of the binary format.
+     * 
+     * @param data A pointer to the dimension value (behind the type).
+     */
+    void initArrayV1(char *data);
+
     /**
      * This method cast each element of the array into the specified type.
      * 
@@ -365,9 +784,59 @@ class Array {
      */
     VarLen32 castToString();
 
-    // DEBUG-METHODS
-    void printData();
-    void printNulls();
+    /**
+     * This method executes matrix multiplication (`alpha * op(this) * op(other) + beta * accumulator`).
+     * 
+     * @param other The second matrix representing the right operand.
+     * @param accumulator The matrix that is added to the product or `nullptr`.
+     * @param transposeLeft If this matrix is transposed.
+     * @param transposeRight If the other matrix is transposed.
+     * @param alpha The factor of the product.
+     * @param beta The factor of the accumulator.
+     * @throws `std::runtime_error`: See `matrixMul`.
+     * @return The result array as string in array processable format.
+     */
+    VarLen32 executeMatrixMultiplication(Array &other, Array *accumulator, bool transposeLeft, bool transposeRight, double alpha, double beta);
+
+    /**
+     * This method checks whether the array can be permuted (transposed).
+     * 
+     * @param operation The name of the operation for the error messages.
+     * @throws `std::runtime_error`: If the element type is not numeric. If the array is not
+     * symmetric or contains empty array structures.
+     */
+    void checkPermutation(const std::string &operation);
+
+    /**
+     * This method returns the size of every dimension of a symmetric array.
+     * 
+     * @return The sizes of the dimensions (the first dimension first).
+     */
+    std::vector<uint32_t> getShape();
+
+    /**
+     * This method creates an array whose dimensions are the dimensions of this array in a
+     * new order. The elements and the NULL bitmap are rearranged tile by tile.
+     * 
+     * @param shape The sizes of the dimensions of this array (with an additional leading
+     * dimension of size one, if the number of dimensions grows).
+     * @param indices The index of every dimension in `shape`.
+     * @param axes The positions (in `shape`) of the result dimensions.
+     * @return The permuted array as string in array processable format.
+     */
+    VarLen32 executePermutation(const std::vector<uint32_t> &shape, const std::vector<int32_t> &indices, const std::vector<uint32_t> &axes);
+
+    /**
+     * This method writes the elements and the NULL bitmap of this array in the order of a
+     * permutation. The elements are moved as unsigned integers of their size.
+     * 
+     * @param buffer The buffer position of the first element. Afterwards, it points behind
+     * the NULL bitmap.
+     * @param shape The sizes of the dimensions of this array.
+     * @param axes The positions (in `shape`) of the result dimensions.
+     */
+    template<class TYPE>
+    void permuteElements(char *&buffer, const std::vector<uint32_t> &shape, const std::vector<uint32_t> &axes);
 
 /*##########################################################################################################################################################  
 *                                                              PUBLIC METHODS
@@ -400,7 +869,22 @@ class Array {
     Array(std::string &array);
 
     /**
-     * This function parses the raw string into a processible array format.
+     * This constructor generates an array object that reads all data directly from the
+     * memory of the given variable (the data will not be copied). The memory must outlive
+     * this object. The given data should be in a processible array format.
+     * @param array A reference to the variable which stores the array data.
+     * @param type The enum (`ArrayType`) value of the element type.
+     * @throws `std::runtime_error`: If the given data is empty or does not include the array 
+     * identification header. 
+     */
+    Array(VarLen32 &array, int32_t type);
+
+    /**
+     * This function parses the raw string into a processible array format. A vectorized
+     * pass marks all structural characters, then only these characters are visited to
+     * collect the structure and the values are written directly into the result.
+     * Values may be quoted (`"a,b"`), a `\` escapes the following character and an
+     * unquoted `NULL` (in any case) is a NULL value.
      * 
      * @param source A reference to the source string.
      * @param type The type of each array element (enumeration value).
@@ -459,10 +943,21 @@ class Array {
      * @param buffer A reference to the string buffer where the content needs to be stored.
      * @param nulls  A pointer to the null bitstrings that should be copied.
      * @param size The number of elements in this array (including NULL values).
-     * @param position The start position of the first element. 
+     * @param position The start position of the first element. If the position is not a multiple
+     * of 8, the buffer must point to the byte that stores the bits of the previous positions.
      */
     void copyNulls(char *&buffer, const uint8_t *nulls, uint32_t size, uint32_t position);
 
+    /**
+     * This method copies the null bits of this array into the provided buffer and adds
+     * the bit of a new element in front of the first or behind the last position.
+     * 
+     * @param buffer A reference to the string buffer where the content needs to be stored.
+     * @param isNull If the new element is a NULL value.
+     * @param isFront If the new element is added in front of the first position.
+     */
+    void copyNullsWithNewBit(char *&buffer, bool isNull, bool isFront);
+
     /**
      * This function copies the boolean values from the given vector into the buffer.
      * Thereby each value is transformed into a single bit and stored in a bitstring (with size 8-bit). 
@@ -483,6 +978,17 @@ class Array {
      */
     uint32_t countNulls(uint32_t position);
 
+    /**
+     * This method returns the absolute position (including NULL values) of an element
+     * stored in the element section of an array. This is the inverse of `getElementPosition`.
+     * 
+     * @param position The relative position of the element (excluding NULL values).
+     * Possible value range `[0:size-1]`.
+     * @throws `std::runtime_error`: If the given position is out of range.
+     * @return The absolute position of the element (including NULL values).
+     */
+    uint32_t getLogicalPosition(uint32_t position);
+
     /**
      * This method returns the type of all array elements.
      */
@@ -584,6 +1090,107 @@ class Array {
      */
     int32_t getHighestPosition();
 
+    /**
+     * This method returns the index of the smallest value in this array.
+     * 
+     * @throws `std::runtime_error`: If the given element type is not supported.
+     */
+    int32_t getLowestPosition();
+
+    /**
+     * This method returns the sum of all elements. NULL values are ignored.
+     * 
+     * @throws `std::runtime_error`: If the element type is not numeric.
+     */
+    double sum();
+
+    /**
+     * This method returns the product of all elements. NULL values are ignored.
+     * 
+     * @throws `std::runtime_error`: If the element type is not numeric.
+     */
+    double product();
+
+    /**
+     * This method returns the smallest element. NULL values are ignored.
+     * 
+     * @throws `std::runtime_error`: If the element type is not numeric or if
+     * the array does not contain any values.
+     */
+    double minimum();
+
+    /**
+     * This method returns the largest element. NULL values are ignored.
+     * 
+     * @throws `std::runtime_error`: If the element type is not numeric or if
+     * the array does not contain any values.
+     */
+    double maximum();
+
+    /**
+     * This method returns the arithmetic mean of all elements. NULL values are ignored.
+     * 
+     * @throws `std::runtime_error`: If the element type is not numeric or if
+     * the array does not contain any values.
+     */
+    double mean();
+
+    /**
+     * This method returns the L1 norm (sum of absolute values) of all elements.
+     * NULL values are ignored.
+     * 
+     * @throws `std::runtime_error`: If the element type is not numeric.
+     */
+    double l1Norm();
+
+    /**
+     * This method returns the L2 norm (euclidean length) of all elements.
+     * NULL values are ignored.
+     * 
+     * @throws `std::runtime_error`: If the element type is not numeric.
+     */
+    double l2Norm();
+
+    /**
+     * This method returns the dot product of the elements of this array and the elements
+     * of another array. Both arrays are read as flat vectors.
+     * 
+     * @param other The second vector.
+     * @throws `std::runtime_error`: If the element types are no (equal) floating point types,
+     * if NULL values are identified or if both arrays have a different number of elements.
+     */
+    double dot(Array &other);
+
+    /**
+     * This method returns the cosine similarity of this array and another array. The
+     * similarity is not defined for a vector of length 0 (every element is zero).
+     * 
+     * @param other The second vector.
+     * @throws `std::runtime_error`: If the element types are no (equal) floating point types,
+     * if NULL values are identified, if both arrays have a different number of elements or if
+     * one of both vectors has length 0.
+     */
+    double cosineSimilarity(Array &other);
+
+    /**
+     * This method returns the euclidean distance between this array and another array.
+     * 
+     * @param other The second vector.
+     * @throws `std::runtime_error`: If the element types are no (equal) floating point types,
+     * if NULL values are identified or if both arrays have a different number of elements.
+     */
+    double l2Distance(Array &other);
+
+    /**
+     * This method returns the inner product distance between this array and another array,
+     * which is the negative dot product (smaller values mean more similar vectors).
+     * 
+     * @param other The second vector.
+     * @throws `std::runtime_error`: If the element types are no (equal) floating point types,
+     * if NULL values are identified or if both arrays have a different number of elements.
+     */
+    double innerProduct(Array &other);
+
     /**
      * This method proofs if the given width pointer has the same structure
      * (equal elements) as the width attribute from this array.
@@ -633,10 +1240,23 @@ class Array {
      */
     static bool isFloatingPointType(uint8_t type);
 
+    /**
+     * This function returns the element type of the result of an arithmetic operation with
+     * operands of the given types. Integers are promoted to `INTEGER64` if one operand is a
+     * 64-bit integer, floating point numbers to the wider type (`BFLOAT` < `FLOAT` < `DOUBLE`).
+     * An integer combined with a floating point number results in a `DOUBLE`.
+     * 
+     * @param left The type of the left operand.
+     * @param right The type of the right operand.
+     * @throws `std::runtime_error`: If one of the types is not numeric.
+     * @return The element type of the result.
+     */
+    static uint8_t getPromotedType(uint8_t left, uint8_t right);
+
     /**
      * This function appends a structure or value of type `TYPE` to the array. Thereby the content
      * will be appended to the last array element. This depends on the dimension structure of the
-     * parameter.
+     * parameter. A float can be appended to a `BFLOAT` array (it is rounded first).
      * 
      * @param toAppend A reference to the structure or value that should be appended.
      * @throws `std::runtime_error`: If the structure to be appended has more dimensions or a 
@@ -690,13 +1310,66 @@ class Array {
      */
     VarLen32 operator[](uint32_t position);
 
+    /**
+     * This function applies the element-wise operation `OP` (e.g. `ArrayAddOperator`) to
+     * `count` pairs of arrays at once (e.g. a batch of rows). The type is validated and the
+     * kernel is selected once for all pairs. Every result is written into a single allocation.
+     * 
+     * @param left A pointer to the left operands.
+     * @param right A pointer to the right operands.
+     * @param count The number of pairs.
+     * @param type The element type of all operands.
+     * @param result A pointer to `count` variables that receive the results.
+     * @param operation The name of the operation (used for error messages).
+     * @param inputElements Receives the number of elements of every operand (including NULL values).
+     * @throws `std::runtime_error`: If the type is not numeric or if a pair cannot be
+     * combined (see `operator+`). No result is written in that case.
+     */
+    template<class OP>
+    static void executeBatchOperation(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, VarLen32 *result, const std::string &operation, uint64_t &inputElements);
+
+    /**
+     * This function reduces the elements of `count` arrays at once (e.g. a batch of rows).
+     * The type is validated and the kernel is selected once for all arrays.
+     * 
+     * @param arrays A pointer to the arrays.
+     * @param count The number of arrays.
+     * @param type The element type of all arrays.
+     * @param op The reduction.
+     * @param result A pointer to `count` values that receive the results.
+     * @param operation The name of the operation (used for error messages).
+     * @param inputElements Receives the number of elements of every array (including NULL values).
+     * @throws `std::runtime_error`: If the type is not numeric. If an array has no elements
+     * for `MIN` and `MAX`.
+     */
+    static void executeBatchReduction(const VarLen32 *arrays, size_t count, int32_t type, ReductionOperator op, double *result, const std::string &operation, uint64_t &inputElements);
+
+    /**
+     * This function computes a measure between `count` pairs of arrays at once (e.g. a
+     * batch of rows). The type is validated and the kernel is selected once for all pairs.
+     * 
+     * @param left A pointer to the first vectors.
+     * @param right A pointer to the second vectors.
+     * @param count The number of pairs.
+     * @param type The element type of all vectors.
+     * @param op The measure.
+     * @param result A pointer to `count` values that receive the results.
+     * @param operation The name of the operation (used for error messages).
+     * @param inputElements Receives the number of elements of every vector.
+     * @throws `std::runtime_error`: If the type is not a floating point type. If a vector
+     * has NULL values or both vectors of a pair have a different number of elements. If a
+     * vector of a cosine similarity has length 0.
+     */
+    static void executeBatchDistance(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, DistanceOperator op, double *result, const std::string &operation, uint64_t &inputElements);
+
     /**
      * This method executes elementwise addition on each element.
      * 
      * @param other A reference to the array whose values are to be used for the addition.
-     * @throws `std::runtime_error`: If the array type is not numeric. If both arrays have
-     * different types. If one array has NULL values or empty array structures. If both
-     * arrays have unequal array structures (unequal widths).
+     * Positions that are NULL in either array are NULL in the result. Arrays of different
+     * types are promoted to a common type (see `getPromotedType`) without a converted copy.
+     * @throws `std::runtime_error`: If an array type is not numeric. If both arrays have
+     * unequal array structures (unequal widths).
      * @return The result array as string in array processable format.
      */
     VarLen32 operator+(Array &other);
@@ -705,9 +1378,10 @@ class Array {
      * This method executes elementwise subtraction on each element.
      * 
      * @param other A reference to the array whose values are to be used for the subtraction.
-     * @throws `std::runtime_error`: If the array type is not numeric. If both arrays have
-     * different types. If one array has NULL values or empty array structures. If both
-     * arrays have unequal array structures (unequal widths).
+     * Positions that are NULL in either array are NULL in the result. Arrays of different
+     * types are promoted to a common type (see `getPromotedType`) without a converted copy.
+     * @throws `std::runtime_error`: If an array type is not numeric. If both arrays have
+     * unequal array structures (unequal widths).
      * @return The result array as string in array processable format.
      */
     VarLen32 operator-(Array &other);
@@ -716,9 +1390,10 @@ class Array {
      * This method executes elementwise multiplication on each element.
      * 
      * @param other A reference to the array whose values are to be used for the multiplication.
-     * @throws `std::runtime_error`: If the array type is not numeric. If both arrays have
-     * different types. If one array has NULL values or empty array structures. If both
-     * arrays have unequal array structures (unequal widths).
+     * Positions that are NULL in either array are NULL in the result. Arrays of different
+     * types are promoted to a common type (see `getPromotedType`) without a converted copy.
+     * @throws `std::runtime_error`: If an array type is not numeric. If both arrays have
+     * unequal array structures (unequal widths).
      * @return The result array as string in array processable format.
      */
     VarLen32 operator*(Array &other);
@@ -727,19 +1402,23 @@ class Array {
      * This method executes elementwise division on each element.
      * 
      * @param other A reference to the array whose values are to be used for the division.
-     * @throws `std::runtime_error`: If the array type is not numeric. If both arrays have
-     * different types. If one array has NULL values or empty array structures. If both
-     * arrays have unequal array structures (unequal widths).
+     * Positions that are NULL in either array are NULL in the result. Arrays of different
+     * types are promoted to a common type (see `getPromotedType`) without a converted copy.
+     * @throws `std::runtime_error`: If an array type is not numeric. If both arrays have
+     * unequal array structures (unequal widths).
      * @return The result array as string in array processable format.
      */
     VarLen32 operator/(Array &other); 
 
     /**
      * This method executes scalar addition. All elements of the array will be added
-     * with the provided value.
+     * with the provided value. The elements and the value are promoted to a common type
+     * (see `getPromotedType`), e.g. a double added to an `INTEGER32` array results in a
+     * `DOUBLE` array. The scalar operations of `BFLOAT` arrays take a float, which is
+     * rounded to a brain floating point number first (the result stays a `BFLOAT` array).
      * 
      * @param value The scalar value of type `TYPE`.
-     * @throws 'std::runtime_error': If the array does not store values of type `TYPE`.
+     * @throws 'std::runtime_error': If the array type is not numeric.
      * @return The result array as string in array processable format.
      */
     template<class TYPE>
@@ -747,11 +1426,12 @@ class Array {
 
     /**
      * This method executes scalar subtraction. All elements of the array will be subtracted
-     * with the provided value.
+     * with the provided value. The elements and the value are promoted to a common type
+     * (see `scalarAdd`).
      * 
      * @param value The scalar value of type `TYPE`.
      * @param isLeft If the scalar is on the left side of the operation.
-     * @throws 'std::runtime_error': If the array does not store values of type `TYPE`.
+     * @throws 'std::runtime_error': If the array type is not numeric.
      * @return The result array as string in array processable format.
      */
     template<class TYPE>
@@ -759,10 +1439,11 @@ class Array {
 
     /**
      * This method executes scalar multiplication. All elements of the array will be multiplied
-     * with the provided value.
+     * with the provided value. The elements and the value are promoted to a common type
+     * (see `scalarAdd`).
      * 
      * @param value The scalar value of type `TYPE`.
-     * @throws 'std::runtime_error': If the array does not store values of type `TYPE`.
+     * @throws 'std::runtime_error': If the array type is not numeric.
      * @return The result array as string in array processable format.
      */
     template<class TYPE>
@@ -770,31 +1451,74 @@ class Array {
 
     /**
      * This method executes scalar division. All elements of the array will be divided
-     * with the provided value.
+     * with the provided value. The elements and the value are promoted to a common type
+     * (see `scalarAdd`).
      * 
      * @param value The scalar value of type `TYPE`.
      * @param isLeft If the scalar is on the left side of the operation.
-     * @throws 'std::runtime_error': If the array does not store values of type `TYPE`.
+     * @throws 'std::runtime_error': If the array type is not numeric.
      * @return The result array as string in array processable format.
      */
     template<class TYPE>
     VarLen32 scalarDiv(TYPE value, bool isLeft);
 
     /**
-     * This method executes matrix multiplication.
+     * This method executes matrix multiplication. The last two dimensions of an array form
+     * its matrices, all leading dimensions are batch dimensions (e.g. `[batch][m][k]`). Each
+     * matrix of the left array is multiplied with the matching matrix of the right array. If
+     * only one array has batch dimensions, the matrix of the other array is multiplied with
+     * each of its matrices. The result has the batch dimensions followed by the rows and the
+     * columns of the products.
      * 
      * @param other The second matrix representing the right operand.
      * @throws `std::runtime_error`: If one of the following points is true:
-     * - If the array element type is not a floating point type.
+     * - If the array element type is not numeric.
      * - If both arrays have different types.
      * - If NULL values are identified.
      * - If empty array structures are identified.
      * - If both arrays are not symmetric in each dimension.
+     * - If both arrays have different batch dimensions.
      * - If both array structures does not allow matrix multiplication.
-     * @return The result array as string in array processable format.
+     * @return The result array as string in array processable format. The product of
+     * two `BFLOAT` matrices is a `FLOAT` matrix, the product of two `INTEGER32` matrices
+     * is an `INTEGER64` matrix (integer products wrap around on overflow).
      */
     VarLen32 matrixMul(Array &other);
 
+    /**
+     * This method executes matrix multiplication with transposed operands and a scaled
+     * product (`alpha * op(this) * op(other)`). The operands are transposed by the BLAS
+     * library while reading them, so no transposed copy is created (e.g. `Q * K^T` for
+     * attention scores).
+     * 
+     * @param other The second matrix representing the right operand.
+     * @param transposeLeft If this matrix is transposed.
+     * @param transposeRight If the other matrix is transposed.
+     * @param alpha The factor of the product.
+     * @throws `std::runtime_error`: See `matrixMul`. If integer matrices are multiplied with
+     * a factor that is not an integer.
+     * @return The result array as string in array processable format.
+     */
+    VarLen32 matrixMul(Array &other, bool transposeLeft, bool transposeRight, double alpha);
+
+    /**
+     * This method executes matrix multiplication and adds the product to an existing matrix
+     * (`alpha * op(this) * op(other) + beta * accumulator`). The accumulator is copied into
+     * the result and updated by a single BLAS call.
+     * 
+     * @param other The second matrix representing the right operand.
+     * @param accumulator The matrix that is added to the product.
+     * @param transposeLeft If this matrix is transposed.
+     * @param transposeRight If the other matrix is transposed.
+     * @param alpha The factor of the product.
+     * @param beta The factor of the accumulator.
+     * @throws `std::runtime_error`: See `matrixMul`. If the accumulator does not have the
+     * element type and the structure of the result or contains NULL values. If integer
+     * matrices are multiplied with factors that are not integers.
+     * @return The result array as string in array processable format.
+     */
+    VarLen32 matrixMul(Array &other, Array &accumulator, bool transposeLeft, bool transposeRight, double alpha, double beta);
+
     /**
      * This method transposes the arrays dimension. In particular the first two dimensions
      * will be swapped which leads to a rearrangement of the elements. 
@@ -806,6 +1530,20 @@ class Array {
      */
     VarLen32 transpose();
 
+    /**
+     * This method reorders the arrays dimensions. The n-th dimension of the result is the
+     * dimension of this array given by the n-th axis, e.g. the axes `{3,1,2}` turn a
+     * `[2][3][4]` array into a `[4][2][3]` array. Each dimension keeps its index.
+     * 
+     * @param axes An `INTEGER32` or `INTEGER64` array that contains every dimension number
+     * (starting with 1) exactly once.
+     * @throws `std::runtime_error`: If the element type is not numeric. If the provided array 
+     * is not symmetric or contains empty array structures. If the axes are no permutation of
+     * the dimensions.
+     * @return The permuted array as string in array processable format.
+     */
+    VarLen32 permute(Array &axes);
+
     /**
      * This function generates an array with the given structure filled with the given
      * value. 
@@ -866,6 +1604,14 @@ class Array {
      */
     std::string print();
 
+    /**
+     * This function writes the string representation of the array to a sink in a single
+     * pass (e.g. directly to a client), without building it in memory first.
+     *
+     * @param sink The output that receives the result (flushed at the end).
+     */
+    void print(PrintSink &sink);
+
 };
 
 #include "Array.tpp"
@@ -10,71 +10,308 @@ void Array::writeToBuffer(char *&buffer, const TYPE *data, uint32_t size) {
     buffer += sizeof(TYPE) * size;
 }
 
+template<class TYPE>
+uint32_t Array::formatElement(char *target, TYPE value) {
+    if constexpr (std::is_same_v<TYPE, BFloat16>) {
+        return formatBFloat16(target, value);
+    } else {
+        return std::to_chars(target, target + MAX_ELEMENT_CHARS, value).ptr - target;
+    }
+}
+
+template<class TYPE>
+void Array::printElements(PrintSink &sink, PrintCursor &cursor, uint32_t width) {
+    char digits[MAX_ELEMENT_CHARS];
+    for (uint32_t i = 0; i < width; i++) {
+        // If not first element, add a comma
+        if (i != 0) sink.append(',');
+        auto position = cursor.position++;
+        // Check if it is null
+        if ((this->nulls[position / 8] >> (7 - position % 8)) & 1) {
+            sink.append("null", 4);
+            continue;
+        }
+        if constexpr (std::is_same_v<TYPE, std::string>) {
+            auto length = reinterpret_cast<const uint32_t*>(this->elements)[cursor.element++];
+            sink.append('"');
+            sink.append(this->strings + cursor.stringOffset, length);
+            sink.append('"');
+            cursor.stringOffset += length;
+        } else if (!cursor.formatted.empty()) {
+            auto element = cursor.element++;
+            if (element % ArrayThreadPool::CHUNK_SIZE == 0) cursor.formattedOffset = 0;
+            auto length = cursor.formattedLengths[element];
+            sink.append(cursor.formatted[element / ArrayThreadPool::CHUNK_SIZE].data() + cursor.formattedOffset, length);
+            cursor.formattedOffset += length;
+        } else {
+            auto value = reinterpret_cast<const TYPE*>(this->elements)[cursor.element++];
+            sink.append(digits, formatElement(digits, value));
+        }
+    }
+}
+
+template<class TYPE>
+void Array::formatElements(PrintCursor &cursor) {
+    constexpr size_t chunkSize = ArrayThreadPool::CHUNK_SIZE;
+    cursor.formatted.resize((this->size + chunkSize - 1) / chunkSize);
+    cursor.formattedLengths.resize(this->size);
+    cursor.formattedOffset = 0;
+    auto *values = reinterpret_cast<const TYPE*>(this->elements);
+    ArrayThreadPool::get().parallelFor(this->size, [&](size_t begin, size_t end) {
+        char digits[MAX_ELEMENT_CHARS];
+        for (size_t position = begin; position < end; position += chunkSize) {
+            auto &text = cursor.formatted[position / chunkSize];
+            auto last = std::min(end, position + chunkSize);
+            for (size_t i = position; i < last; i++) {
+                auto length = formatElement(digits, values[i]);
+                text.append(digits, length);
+                cursor.formattedLengths[i] = length;
+            }
+        }
+    });
+}
+
+template<class FUNCTION>
+auto Array::dispatchNumericType(uint8_t type, FUNCTION &&function) {
+    if (type == ArrayType::INTEGER32) {
+        return function(static_cast<int32_t*>(nullptr));
+    } else if (type == ArrayType::INTEGER64) {
+        return function(static_cast<int64_t*>(nullptr));
+    } else if (type == ArrayType::BFLOAT) {
+        return function(static_cast<BFloat16*>(nullptr));
+    } else if (type == ArrayType::FLOAT) {
+        return function(static_cast<float*>(nullptr));
+    } else if (type == ArrayType::DOUBLE) {
+        return function(static_cast<double*>(nullptr));
+    } else {
+        throw std::runtime_error("Array-Type is not supported");
+    }
+}
+
 template<class TYPE, class OP>
-lingodb::runtime::VarLen32 Array::executeScalarOperation(TYPE value, bool isLeft) {
-    // Define result string size (does not change)
-    auto totalElements = getSize(true);
-    std::string result;
-    auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(totalElements), 0, type);
-    result.resize(size);
-    char *buffer = result.data();
-    // Write every content to the result (does not change except elements)
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
-    writeToBuffer(buffer, this->indices, this->dimensions);
-    writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
-    writeToBuffer(buffer, this->widths, getWidthSize());
-    auto *left = isLeft ? reinterpret_cast<const uint8_t*>(&value) : this->elements;
-    auto *right = isLeft ? this->elements : reinterpret_cast<const uint8_t*>(&value);
-    executeBinaryOperation<OP>(left, right, this->size, buffer, isLeft, !isLeft, this->type);
-    copyNulls(buffer, this->nulls, totalElements, 0);
-    return VarLen32::fromString(result);
+lingodb::runtime::VarLen32 Array::executeScalarOperation(TYPE value, bool isLeft, const std::string &operation) {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-" + operation + ": Given element type is not numeric");
+    }
+    return dispatchNumericType(this->type, [&](auto *element) {
+        using ELEMENT = std::remove_pointer_t<decltype(element)>;
+        // There is no brain floating point scalar, so a float keeps brain floating point elements
+        using RESULT = std::conditional_t<std::is_same_v<ELEMENT, BFloat16> && std::is_same_v<TYPE, float>, BFloat16, Promoted<ELEMENT, TYPE>>;
+        const RESULT scalar = static_cast<RESULT>(value);
+        // Define result string size (does not change)
+        auto totalElements = getSize(true);
+        auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(totalElements), 0, getElementType<RESULT>());
+        ArrayBuilder result(size);
+        char *buffer = result.getBuffer();
+        // Write every content to the result (does not change except elements)
+        writeHeader(buffer, getElementType<RESULT>(), this->dimensions, this->size, totalElements, getWidthSize(), 0);
+        writeToBuffer(buffer, this->indices, this->dimensions);
+        writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
+        writeToBuffer(buffer, this->widths, getWidthSize());
+        writePadding(buffer, this->dimensions, getWidthSize());
+        auto *values = reinterpret_cast<const ELEMENT*>(this->elements);
+        if (isLeft) {
+            executeBinaryKernel<RESULT, ELEMENT, RESULT, OP>(&scalar, values, this->size, buffer, true, false);
+        } else {
+            executeBinaryKernel<ELEMENT, RESULT, RESULT, OP>(values, &scalar, this->size, buffer, false, true);
+        }
+        copyNulls(buffer, this->nulls, totalElements, 0);
+        return result.build();
+    });
 }
 
 template<class OP>
 lingodb::runtime::VarLen32 Array::executeActivationFunction() {
     // Define result string size (does not change)
     auto totalElements = getSize(true);
-    std::string result;
     auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(totalElements), 0, type);
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
     // Write every content to the result (does not change except elements)
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
+    writeHeader(buffer, this->type, this->dimensions, this->size, totalElements, getWidthSize(), 0);
     writeToBuffer(buffer, this->indices, this->dimensions);
     writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
     writeToBuffer(buffer, this->widths, getWidthSize());
+    writePadding(buffer, this->dimensions, getWidthSize());
     auto *data = this->elements;
     executeUnaryOperation<OP>(data, this->size, buffer, this->type);
     copyNulls(buffer, this->nulls, totalElements, 0);
-    return VarLen32::fromString(result);
+    return result.build();
+}
+
+template<class LEFT, class RIGHT, class RESULT, class OP>
+void Array::executeBinaryKernel(const LEFT *left, const RIGHT *right, uint32_t size, char *&buffer, bool scalarLeft, bool scalarRight) {
+    auto layout = scalarLeft ? OperandLayout::SCALAR_ARRAY : scalarRight ? OperandLayout::ARRAY_SCALAR : OperandLayout::ARRAY_ARRAY;
+    auto kernel = ArraySimd::getPromotingKernel<LEFT, RIGHT, RESULT, OP>(layout);
+    auto *result = reinterpret_cast<RESULT*>(buffer);
+    // A scalar operand stays at its position for every chunk
+    ArrayThreadPool::get().parallelFor(size, [&](size_t begin, size_t end) {
+        kernel(scalarLeft ? left : left + begin, scalarRight ? right : right + begin, result + begin, end - begin);
+    });
+    buffer += sizeof(RESULT) * size;
+}
+
+template<class TYPE>
+void Array::gatherElements(const std::vector<uint64_t> &combined, TYPE *target) {
+    auto *values = reinterpret_cast<const TYPE*>(this->elements);
+    uint32_t element = 0;
+    for (uint32_t word = 0; word < combined.size(); word++) {
+        uint32_t valid = std::min<uint32_t>(64, this->totalSize - word * 64);
+        uint64_t mask = valid == 64 ? ~0ull : ~(~0ull >> valid);
+        // The positions with an element of this array and with an element of the result
+        uint64_t own = ~getNullWord(word) & mask;
+        uint64_t selected = ~combined[word] & mask;
+        // The elements of this array that are NULL in the other array are skipped, the
+        // elements between them are copied as runs
+        uint64_t skipped = own & ~selected;
+        uint32_t count = __builtin_popcountll(own);
+        uint32_t copied = 0;
+        while (skipped != 0) {
+            uint32_t bit = __builtin_clzll(skipped);
+            uint32_t before = bit == 0 ? 0 : __builtin_popcountll(own >> (64 - bit));
+            target = std::copy(values + element + copied, values + element + before, target);
+            copied = before + 1;
+            skipped &= ~(1ull << (63 - bit));
+        }
+        target = std::copy(values + element + copied, values + element + count, target);
+        element += count;
+    }
+}
+
+template<class LEFT, class RIGHT>
+std::pair<const LEFT*, const RIGHT*> Array::alignOperands(Array &other, const std::vector<uint64_t> &combined, uint32_t size, LEFT *target, std::vector<LEFT> &left, std::vector<RIGHT> &right) {
+    auto *leftValues = reinterpret_cast<const LEFT*>(this->elements);
+    auto *rightValues = reinterpret_cast<const RIGHT*>(other.elements);
+    // Every position of this array that stores an element is selected
+    if (this->size != size) {
+        if (target == nullptr) {
+            left.resize(size);
+            target = left.data();
+        }
+        gatherElements(combined, target);
+        leftValues = target;
+    }
+    if (other.size != size) {
+        right.resize(size);
+        other.gatherElements(combined, right.data());
+        rightValues = right.data();
+    }
+    return {leftValues, rightValues};
 }
 
 template<class OP>
-void Array::executeBinaryOperation(const uint8_t *left, const uint8_t *right, uint32_t size, char *&buffer, bool scalarLeft, bool scalarRight, uint8_t type) {
-    if (type == ArrayType::INTEGER32) {
-        auto *leftVal = reinterpret_cast<const int32_t*>(left);
-        auto *rightVal = reinterpret_cast<const int32_t*>(right);
-        OP::Operator(leftVal, rightVal, size, buffer, scalarLeft, scalarRight);
-    } else if (type == ArrayType::INTEGER64) {
-        auto *leftVal = reinterpret_cast<const int64_t*>(left);
-        auto *rightVal = reinterpret_cast<const int64_t*>(right);
-        OP::Operator(leftVal, rightVal, size, buffer, scalarLeft, scalarRight);
-    } else if (type == ArrayType::FLOAT) {
-        auto *leftVal = reinterpret_cast<const float*>(left);
-        auto *rightVal = reinterpret_cast<const float*>(right);
-        OP::Operator(leftVal, rightVal, size, buffer, scalarLeft, scalarRight);
-    } else if (type == ArrayType::DOUBLE) {
-        auto *leftVal = reinterpret_cast<const double*>(left);
-        auto *rightVal = reinterpret_cast<const double*>(right);
-        OP::Operator(leftVal, rightVal, size, buffer, scalarLeft, scalarRight);
+lingodb::runtime::VarLen32 Array::executeElementwiseOperation(Array &other, const std::string &operation) {
+    if (!isNumericType(this->type) || !isNumericType(other.getType())) {
+        throw std::runtime_error("Array-" + operation + ": Given element type is not numeric");
+    }
+    checkBinaryStructure(other, operation);
+
+    std::vector<uint64_t> combined;
+    auto elements = getCombinedNulls(other, combined);
+    auto widthSize = getWidthSize();
+    auto type = getPromotedType(this->type, other.getType());
+    auto size = getStringSize(this->dimensions, elements, widthSize, getNullBytes(this->totalSize), 0, type);
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
+
+    writeHeader(buffer, type, this->dimensions, elements, this->totalSize, widthSize, 0);
+    writeToBuffer(buffer, this->indices, this->dimensions);
+    writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
+    writeToBuffer(buffer, this->widths, widthSize);
+    writePadding(buffer, this->dimensions, widthSize);
+
+    dispatchNumericType(this->type, [&](auto *leftType) {
+        dispatchNumericType(other.getType(), [&](auto *rightType) {
+            using LEFT = std::remove_pointer_t<decltype(leftType)>;
+            using RIGHT = std::remove_pointer_t<decltype(rightType)>;
+            using RESULT = Promoted<LEFT, RIGHT>;
+            // Left elements of the result type may be gathered into the result, the kernel
+            // then works in place
+            LEFT *target = nullptr;
+            if constexpr (std::is_same_v<LEFT, RESULT>) target = reinterpret_cast<RESULT*>(buffer);
+            std::vector<LEFT> leftGathered;
+            std::vector<RIGHT> rightGathered;
+            auto [left, right] = alignOperands(other, combined, elements, target, leftGathered, rightGathered);
+            executeBinaryKernel<LEFT, RIGHT, RESULT, OP>(left, right, elements, buffer, false, false);
+        });
+    });
+
+    if (combined.empty()) {
+        copyNulls(buffer, this->nulls, this->totalSize, 0);
     } else {
-        throw std::runtime_error("Array-Type is not supported");
+        writeNullWords(buffer, combined, this->totalSize);
+    }
+    return result.build();
+}
+
+template<class OP>
+void Array::executeBatchOperation(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, VarLen32 *result, const std::string &operation, uint64_t &inputElements) {
+    auto typeId = getTypeId(type);
+    if (!isNumericType(typeId)) {
+        throw std::runtime_error("Array-" + operation + ": Given element type is not numeric");
+    }
+    if (typeId == ArrayType::INTEGER32) {
+        executeBatchKernel<int32_t, OP>(left, right, count, typeId, result, operation, inputElements);
+    } else if (typeId == ArrayType::INTEGER64) {
+        executeBatchKernel<int64_t, OP>(left, right, count, typeId, result, operation, inputElements);
+    } else if (typeId == ArrayType::BFLOAT) {
+        executeBatchKernel<BFloat16, OP>(left, right, count, typeId, result, operation, inputElements);
+    } else if (typeId == ArrayType::FLOAT) {
+        executeBatchKernel<float, OP>(left, right, count, typeId, result, operation, inputElements);
+    } else {
+        executeBatchKernel<double, OP>(left, right, count, typeId, result, operation, inputElements);
+    }
+}
+
+template<class TYPE, class OP>
+void Array::executeBatchKernel(const VarLen32 *left, const VarLen32 *right, size_t count, uint8_t type, VarLen32 *result, const std::string &operation, uint64_t &inputElements) {
+    auto kernel = ArraySimd::getBinaryKernel<TYPE, OP>(OperandLayout::ARRAY_ARRAY);
+    // Validate every pair and place each result at an aligned offset of a single allocation
+    std::vector<Array> operands;
+    operands.reserve(2 * count);
+    std::vector<uint32_t> elements(count);
+    std::vector<size_t> offsets(count + 1, 0);
+    // The combined NULL words of each pair (empty if neither array has NULL values)
+    std::vector<std::vector<uint64_t>> combined(count);
+    for (size_t i = 0; i < count; i++) {
+        VarLen32 leftValue = left[i];
+        VarLen32 rightValue = right[i];
+        auto &leftArray = operands.emplace_back(leftValue, type);
+        auto &rightArray = operands.emplace_back(rightValue, type);
+        leftArray.checkBinaryStructure(rightArray, operation);
+        inputElements += static_cast<uint64_t>(leftArray.totalSize) + rightArray.totalSize;
+        elements[i] = leftArray.getCombinedNulls(rightArray, combined[i]);
+        auto size = getStringSize(leftArray.dimensions, elements[i], leftArray.getWidthSize(), getNullBytes(leftArray.totalSize), 0, type);
+        offsets[i + 1] = offsets[i] + ((size + ELEMENT_ALIGNMENT - 1) & ~static_cast<size_t>(ELEMENT_ALIGNMENT - 1));
+    }
+    auto *data = ArrayAllocator::get().allocate(offsets[count]);
+
+    std::vector<TYPE> leftGathered, rightGathered;
+    for (size_t i = 0; i < count; i++) {
+        auto &leftArray = operands[2 * i];
+        auto &rightArray = operands[2 * i + 1];
+        auto widthSize = leftArray.getWidthSize();
+        auto size = getStringSize(leftArray.dimensions, elements[i], widthSize, getNullBytes(leftArray.totalSize), 0, type);
+        ArrayBuilder builder(data + offsets[i], size);
+        char *buffer = builder.getBuffer();
+
+        writeHeader(buffer, type, leftArray.dimensions, elements[i], leftArray.totalSize, widthSize, 0);
+        writeToBuffer(buffer, leftArray.indices, leftArray.dimensions);
+        writeToBuffer(buffer, leftArray.dimensionWidthMap, leftArray.dimensions);
+        writeToBuffer(buffer, leftArray.widths, widthSize);
+        writePadding(buffer, leftArray.dimensions, widthSize);
+
+        auto *target = reinterpret_cast<TYPE*>(buffer);
+        auto [leftValues, rightValues] = leftArray.alignOperands(rightArray, combined[i], elements[i], target, leftGathered, rightGathered);
+        kernel(leftValues, rightValues, target, elements[i]);
+        buffer += sizeof(TYPE) * elements[i];
+
+        if (combined[i].empty()) {
+            leftArray.copyNulls(buffer, leftArray.nulls, leftArray.totalSize, 0);
+        } else {
+            writeNullWords(buffer, combined[i], leftArray.totalSize);
+        }
+        result[i] = builder.build();
     }
 }
 
@@ -86,6 +323,9 @@ void Array::executeUnaryOperation(const uint8_t *data, uint32_t size, char *&buf
     } else if (type == ArrayType::INTEGER64) {
         auto *values = reinterpret_cast<const int64_t*>(data);
         OP::Operator(values, size, buffer);
+    } else if (type == ArrayType::BFLOAT) {
+        auto *values = reinterpret_cast<const BFloat16*>(data);
+        OP::Operator(values, size, buffer);
     } else if (type == ArrayType::FLOAT) {
         auto *values = reinterpret_cast<const float*>(data);
         OP::Operator(values, size, buffer);
@@ -105,24 +345,21 @@ lingodb::runtime::VarLen32 Array::appendElement(TYPE value) {
     auto widthSize = getWidthSize();
     auto lastWidth = this->widths[widthSize-1] + 1;
 
-    std::string result;
     size_t size = getStringSize(this->dimensions, numberElements, widthSize, nullBytes, 0, this->type);
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
     // Write complete content to result string
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &numberElements, 1);
+    writeHeader(buffer, this->type, this->dimensions, numberElements, getSize(true) + 1, widthSize, 0);
     writeToBuffer(buffer, this->indices, this->dimensions);
     writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
     writeToBuffer(buffer, this->widths, widthSize-1);
     writeToBuffer(buffer, &lastWidth, 1);
+    writePadding(buffer, this->dimensions, widthSize);
     copyElements(buffer);
     writeToBuffer(buffer, &value, 1);
-    writeToBuffer(buffer, this->nulls, nullBytes);
-    return VarLen32::fromString(result);
+    copyNullsWithNewBit(buffer, false, false);
+    return result.build();
 }
 
 template<class TYPE>
@@ -134,16 +371,12 @@ lingodb::runtime::VarLen32 Array::appendElementFront(TYPE value) {
     auto lastWidthSize = getWidthSize(this->dimensions);
     auto changedWidth = this->widths[widthSize - lastWidthSize] + 1;
 
-    std::string result;
     size_t size = getStringSize(this->dimensions, numberElements, widthSize, nullBytes, 0, this->type);
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
     // Write complete content to result string
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &numberElements, 1);
+    writeHeader(buffer, this->type, this->dimensions, numberElements, getSize(true) + 1, widthSize, 0);
     writeToBuffer(buffer, this->indices, this->dimensions);
     writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
     // Write widths from upper dimensions
@@ -151,10 +384,11 @@ lingodb::runtime::VarLen32 Array::appendElementFront(TYPE value) {
     writeToBuffer(buffer, &changedWidth, 1);
     // Write not changed widths in last dimension
     writeToBuffer(buffer, this->widths + widthSize - lastWidthSize + 1, lastWidthSize-1);
+    writePadding(buffer, this->dimensions, widthSize);
     writeToBuffer(buffer, &value, 1);
     copyElements(buffer);
-    writeToBuffer(buffer, this->nulls, nullBytes);
-    return VarLen32::fromString(result);
+    copyNullsWithNewBit(buffer, false, true);
+    return result.build();
 }
 
 template<class TYPE, class ARRAYTYPE>
@@ -176,16 +410,12 @@ lingodb::runtime::VarLen32 Array::generate(TYPE *value, Array &structure, uint8_
     }
 
     // Prepare result string
-    std::string result;
     auto resultSize = getStringSize(size, elementCopies, widthSize, getNullBytes(elementCopies), stringSize*elementCopies, type);
-    result.resize(resultSize);
-    char *buffer = result.data();
+    ArrayBuilder result(resultSize);
+    char *buffer = result.getBuffer();
 
     // Write content to result
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &type, 1);
-    writeToBuffer(buffer, &size, 1);
-    writeToBuffer(buffer, &elementCopies, 1);
+    writeHeader(buffer, type, size, elementCopies, elementCopies, widthSize, stringSize*elementCopies);
     // Create new index values
     for (uint32_t i = 0; i < size; i++) {
         uint32_t index = 1;
@@ -201,24 +431,29 @@ lingodb::runtime::VarLen32 Array::generate(TYPE *value, Array &structure, uint8_
             writeToBuffer(buffer, &width, 1);
         }
     }
+    writePadding(buffer, size, widthSize);
     // Check if array element type is string
     if (!std::is_same<TYPE, char>::value){
         // If false, copy only n times the value
         for (uint32_t i = 0; i < elementCopies; i++) {
             writeToBuffer(buffer, value, 1);
         }
+        // Generated array does not contain any NULL values
+        memset(buffer, 0, getNullBytes(elementCopies));
+        buffer += getNullBytes(elementCopies);
     } else {
         // If true, copy n times string length and n times the string itself
         for (uint32_t i = 0; i < elementCopies; i++) {
             writeToBuffer(buffer, &stringSize, 1);
         }
+        memset(buffer, 0, getNullBytes(elementCopies));
         buffer += getNullBytes(elementCopies);
         for (uint32_t i = 0; i < elementCopies; i++) {
             writeToBuffer(buffer, value, stringSize);
         }
     }
 
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 template<class ARRAYTYPE>
@@ -240,17 +475,12 @@ lingodb::runtime::VarLen32 Array::generate(Array &structure, uint8_t type) {
     }
 
     // Prepare result string
-    std::string result;
     auto resultSize = getStringSize(size, 0, widthSize, getNullBytes(elementCopies), 0, type);
-    result.resize(resultSize);
-    char *buffer = result.data();
+    ArrayBuilder result(resultSize);
+    char *buffer = result.getBuffer();
 
-    uint32_t zero = 0;
     // Write content to result
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &type, 1);
-    writeToBuffer(buffer, &size, 1);
-    writeToBuffer(buffer, &zero, 1);
+    writeHeader(buffer, type, size, 0, elementCopies, widthSize, 0);
     // Create new index values
     for (uint32_t i = 0; i < size; i++) {
         uint32_t index = 1;
@@ -266,7 +496,9 @@ lingodb::runtime::VarLen32 Array::generate(Array &structure, uint8_t type) {
             writeToBuffer(buffer, &width, 1);
         }
     }
+    writePadding(buffer, size, widthSize);
     // Write null bits
+    memset(buffer, 0, getNullBytes(elementCopies));
     for (uint32_t i = 0; i < elementCopies; i++) {
         // Check if new null byte must be selected
         if (i != 0 && i % 8 == 0) {
@@ -277,24 +509,22 @@ lingodb::runtime::VarLen32 Array::generate(Array &structure, uint8_t type) {
         *buffer |= (1 << shift);
     }
 
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
-template<class TYPE>
-int32_t Array::getMaxIndex() {
+template<class TYPE, bool HIGHEST>
+int32_t Array::getExtremePosition() {
     auto *elements = reinterpret_cast<const TYPE*>(this->elements);
-    int32_t result = -1;
-    auto size = getSize(true);
-
-    for (uint32_t i = 0; i < size; i++) {
-        if (isNull(i)) continue;
-        uint32_t position = getElementPosition(i);
-        if (result == -1) result = i;
-        uint32_t resultPosition = getElementPosition(result);
-        if (elements[position] > elements[resultPosition]) result = i;
+    uint32_t result = 0;
+    TYPE best = elements[0];
+    // Elements are stored without NULL values, so a single pass is sufficient
+    for (uint32_t i = 1; i < this->size; i++) {
+        if (HIGHEST ? elements[i] > best : elements[i] < best) {
+            best = elements[i];
+            result = i;
+        }
     }
-
-    return result;
+    return getLogicalPosition(result);
 }
 
 template<class TYPE>
@@ -315,8 +545,8 @@ void Array::castAndCopyElement(char *&buffer, uint32_t position, uint8_t type) {
             if (i == position) length = lengths[i];
             else offset += lengths[i];
         }
-        // Construct string and try a cast to the provided type
-        std::string value(this->strings + offset, length);
+        // Try a cast of the string to the provided type
+        std::string_view value(this->strings + offset, length);
         switch (type) {
             case ArrayType::INTEGER32:
                 castAndCopyElement<int32_t>(buffer, value);
@@ -324,6 +554,9 @@ void Array::castAndCopyElement(char *&buffer, uint32_t position, uint8_t type) {
             case ArrayType::INTEGER64:
                 castAndCopyElement<int64_t>(buffer, value);
                 break;
+            case ArrayType::BFLOAT:
+                castAndCopyElement<BFloat16>(buffer, value);
+                break;
             case ArrayType::FLOAT:
                 castAndCopyElement<float>(buffer, value);
                 break;
@@ -353,6 +586,11 @@ void Array::castAndCopyElement(char *&buffer, uint32_t position, uint8_t type) {
             writeToBuffer(buffer, &value, 1);
             break;
         }
+        case ArrayType::BFLOAT: {
+            auto value = static_cast<BFloat16>(element);
+            writeToBuffer(buffer, &value, 1);
+            break;
+        }
         case ArrayType::FLOAT: {
             auto value = static_cast<float>(element);
             writeToBuffer(buffer, &value, 1);
@@ -364,8 +602,8 @@ void Array::castAndCopyElement(char *&buffer, uint32_t position, uint8_t type) {
             break;
         }
         case ArrayType::STRING: {
-            auto value = std::to_string(element);
-            uint32_t length = value.length();
+            char digits[MAX_ELEMENT_CHARS];
+            uint32_t length = formatElement(digits, element);
             writeToBuffer(buffer, &length, 1);
             break;
         }
@@ -0,0 +1,152 @@
+#ifndef LINGODB_RUNTIME_ARRAYALLOCATOR_H
+#define LINGODB_RUNTIME_ARRAYALLOCATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace lingodb::runtime {
+
+/**
+ * This class defines the allocator from which the memory of every resulting array (and every
+ * `VarLen32` created from a string) is taken. Each thread uses its own current allocator, which
+ * can be replaced with a `Scope`. Memory is never released individually, but in bulk with `reset`.
+ *
+ * @note Callers should install a `Scope` for each query (or pipeline) and reset its allocator
+ * once the results are no longer used. Without a scope, results are taken from a thread-local
+ * arena that is only released by `resetDefault` (or when the thread exits).
+ */
+class ArrayAllocator {
+    protected:
+    // The number of allocations requested from this allocator.
+    uint64_t allocations = 0;
+    // The number of bytes requested from this allocator.
+    uint64_t allocatedBytes = 0;
+    // The number of allocations this allocator requested from the system.
+    uint64_t systemAllocations = 0;
+    // The number of bytes currently held by this allocator.
+    uint64_t reservedBytes = 0;
+
+    public:
+
+    virtual ~ArrayAllocator() = default;
+
+    /**
+     * This method allocates memory that remains valid until `reset` is called.
+     *
+     * @param size The number of bytes.
+     * @return A pointer to the first byte (aligned to 64 bytes).
+     */
+    virtual uint8_t *allocate(size_t size) = 0;
+
+    /**
+     * This method releases all memory handed out by this allocator at once.
+     * Every pointer returned by `allocate` becomes invalid.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * This method returns the number of allocations requested from this allocator.
+     */
+    uint64_t getAllocations();
+
+    /**
+     * This method returns the number of bytes requested from this allocator.
+     */
+    uint64_t getAllocatedBytes();
+
+    /**
+     * This method returns the number of allocations this allocator requested from the system.
+     */
+    uint64_t getSystemAllocations();
+
+    /**
+     * This method returns the number of bytes currently held by this allocator.
+     */
+    uint64_t getReservedBytes();
+
+    /**
+     * This method sets the allocation counters to zero (the reserved bytes remain).
+     */
+    void resetStatistics();
+
+    /**
+     * This function returns the allocator of the calling thread. If no allocator
+     * has been installed with a `Scope`, a thread-local `ArenaAllocator` is used.
+     */
+    static ArrayAllocator &get();
+
+    /**
+     * This function resets the thread-local `ArenaAllocator` of the calling thread (see `get`),
+     * i.e. every result created without a `Scope` on this thread becomes invalid. An installed
+     * allocator is not affected.
+     */
+    static void resetDefault();
+
+    /**
+     * This class installs an allocator for the calling thread as long as it exists
+     * (e.g. for the duration of a query or pipeline). The previous allocator will be
+     * restored afterwards.
+     */
+    class Scope {
+        private:
+        // The allocator that was installed before.
+        ArrayAllocator *previous;
+
+        public:
+        Scope(ArrayAllocator &allocator);
+        ~Scope();
+        Scope(const Scope &other) = delete;
+        Scope &operator=(const Scope &other) = delete;
+    };
+};
+
+/**
+ * This class is a bump allocator. It requests large chunks from the system and hands
+ * out consecutive parts of them. `reset` keeps the largest chunk to serve the next
+ * query without any system allocation.
+ */
+class ArenaAllocator : public ArrayAllocator {
+    private:
+    // A single chunk of memory.
+    struct Chunk {
+        uint8_t *data;
+        size_t size;
+    };
+    // Every chunk held by this allocator.
+    std::vector<Chunk> chunks;
+    // A pointer to the next free byte of the current chunk.
+    uint8_t *position = nullptr;
+    // A pointer behind the last byte of the current chunk.
+    uint8_t *end = nullptr;
+    // The size of the next requested chunk.
+    size_t chunkSize;
+
+    /**
+     * This method requests a new chunk from the system.
+     *
+     * @param size The number of bytes of the chunk.
+     * @return A pointer to the first byte of the chunk.
+     */
+    uint8_t *addChunk(size_t size);
+
+    public:
+
+    // The alignment of each allocation.
+    static constexpr size_t ALIGNMENT = 64;
+    // The size of the first chunk.
+    static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+    // The maximum size of a chunk (allocations larger than the next chunk get their own chunk).
+    static constexpr size_t MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+
+    ArenaAllocator();
+    ~ArenaAllocator();
+    ArenaAllocator(const ArenaAllocator &other) = delete;
+    ArenaAllocator &operator=(const ArenaAllocator &other) = delete;
+
+    uint8_t *allocate(size_t size) override;
+    void reset() override;
+};
+
+}
+#endif
@@ -1,158 +1,288 @@
+#ifndef LINGODB_RUNTIME_ARRAYARITHMETIC_H
+#define LINGODB_RUNTIME_ARRAYARITHMETIC_H
+
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <cmath>
 #include <string>
+#include <type_traits>
+#include <vector>
 #include <cblas.h>
+#include "../include/BFloat16.h"
 
 namespace lingodb::runtime {
 
 struct ArrayAddOperator {
 
     /**
-     * This function executes an addition operation on a list of values of type `TYPE` and
-     * copies the result in the given buffer.
+     * This function executes an addition on two values of type `TYPE`. The
+     * element-wise kernels (see `ArraySimd`) apply this function to every element
+     * that is not processed by vector instructions.
      * 
-     * @param left A pointer to a value of type `TYPE`.
-     * @param right A pointer to a value of type `TYPE`.
-     * @param size The length of both value lists.
-     * @param buffer A reference to a char pointer which points to the string
-     * that should store the result.
-     * @param scalarLeft If the left parameter points to a single element.
-     * @param scalarRight If the right parameter points to a single element.
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return The result of the operation.
      */
     template<class TYPE>
-    static void Operator(const TYPE *left, const TYPE *right, uint32_t size, char *&buffer, bool scalarLeft, bool scalarRight) {
-        for (size_t i = 0; i < size; i++) {
-            TYPE result = *left + *right;
-            memcpy(buffer, &result, sizeof(TYPE));
-            buffer += sizeof(TYPE);
-            if (!scalarLeft) left++;
-            if (!scalarRight) right++;
-        }
+    static TYPE apply(TYPE left, TYPE right) {
+        return left + right;
     }
 };
 
-struct ArraySubOperator{
+struct ArraySubOperator {
 
     /**
-     * This function executes a subtraction operation on a list of values of type `TYPE` and
-     * copies the result in the given buffer.
+     * This function executes a subtraction on two values of type `TYPE`. The
+     * element-wise kernels (see `ArraySimd`) apply this function to every element
+     * that is not processed by vector instructions.
      * 
-     * @param left A pointer to a value of type `TYPE`.
-     * @param right A pointer to a value of type `TYPE`.
-     * @param size The length of both value lists.
-     * @param buffer A reference to a char pointer which points to the string
-     * that should store the result.
-     * @param scalarLeft If the left parameter points to a single element.
-     * @param scalarRight If the right parameter points to a single element.
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return The result of the operation.
      */
     template<class TYPE>
-    static void Operator(const TYPE *left, const TYPE *right, uint32_t size, char *&buffer, bool scalarLeft, bool scalarRight) {
-        for (size_t i = 0; i < size; i++) {
-            TYPE result = *left - *right;
-            memcpy(buffer, &result, sizeof(TYPE));
-            buffer += sizeof(TYPE);
-            if (!scalarLeft) left++;
-            if (!scalarRight) right++;
-        }
+    static TYPE apply(TYPE left, TYPE right) {
+        return left - right;
     }
 };
 
-struct ArrayMulOperator{
+struct ArrayMulOperator {
 
     /**
-     * This function executes an multiplication operation on a list of values of type `TYPE` and
-     * copies the result in the given buffer.
+     * This function executes a multiplication on two values of type `TYPE`. The
+     * element-wise kernels (see `ArraySimd`) apply this function to every element
+     * that is not processed by vector instructions.
      * 
-     * @param left A pointer to a value of type `TYPE`.
-     * @param right A pointer to a value of type `TYPE`.
-     * @param size The length of both value lists.
-     * @param buffer A reference to a char pointer which points to the string
-     * that should store the result.
-     * @param scalarLeft If the left parameter points to a single element.
-     * @param scalarRight If the right parameter points to a single element.
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return The result of the operation.
      */
     template<class TYPE>
-    static void Operator(const TYPE *left, const TYPE *right, uint32_t size, char *&buffer, bool scalarLeft, bool scalarRight) {
-        for (size_t i = 0; i < size; i++) {
-            TYPE result = *left * *right;
-            memcpy(buffer, &result, sizeof(TYPE));
-            buffer += sizeof(TYPE);
-            if (!scalarLeft) left++;
-            if (!scalarRight) right++;
-        }
+    static TYPE apply(TYPE left, TYPE right) {
+        return left * right;
     }
 };
 
-struct ArrayDivOperator{
+struct ArrayDivOperator {
 
     /**
-     * This function executes an division operation on a list of values of type `TYPE` and
-     * copies the result in the given buffer.
+     * This function executes a division on two values of type `TYPE`. The
+     * element-wise kernels (see `ArraySimd`) apply this function to every element
+     * that is not processed by vector instructions.
      * 
-     * @param left A pointer to a value of type `TYPE`.
-     * @param right A pointer to a value of type `TYPE`.
-     * @param size The length of both value lists.
-     * @param buffer A reference to a char pointer which points to the string
-     * that should store the result.
-     * @param scalarLeft If the left parameter points to a single element.
-     * @param scalarRight If the right parameter points to a single element.
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return The result of the operation.
      */
     template<class TYPE>
-    static void Operator(const TYPE *left, const TYPE *right, uint32_t size, char *&buffer, bool scalarLeft, bool scalarRight) {
-        for (size_t i = 0; i < size; i++) {
-            TYPE result = *left / *right;
-            memcpy(buffer, &result, sizeof(TYPE));
-            buffer += sizeof(TYPE);
-            if (!scalarLeft) left++;
-            if (!scalarRight) right++;
-        }
+    static TYPE apply(TYPE left, TYPE right) {
+        return left / right;
     }
-
 };
 
+/**
+ * This function computes `C = alpha * op(A) * op(B) + beta * C` with row-major matrices, where
+ * `op` transposes a matrix if its flag is set. The transposition is executed by the BLAS
+ * library while reading, so no transposed copy is created.
+ *
+ * @param transposeA If `A` is transposed.
+ * @param transposeB If `B` is transposed.
+ * @param rows The number of rows of `op(A)` and `C`.
+ * @param columns The number of columns of `op(B)` and `C`.
+ * @param inner The number of columns of `op(A)` (the rows of `op(B)`).
+ * @param alpha The factor of the product.
+ * @param A The elements of the left matrix.
+ * @param B The elements of the right matrix.
+ * @param beta The factor of `C` (`C` is not read if it is zero).
+ * @param C The elements of the result matrix.
+ */
 template <class TYPE, class RETURN_TYPE>
-inline void Gemm(int rowsA, int columnsB, int rowsB, const TYPE *A, const TYPE *B, RETURN_TYPE *C) {
+inline void Gemm(bool transposeA, bool transposeB, int rows, int columns, int inner, RETURN_TYPE alpha,
+                 const TYPE *A, const TYPE *B, RETURN_TYPE beta, RETURN_TYPE *C) {
     static_assert(sizeof(TYPE) == 0, "Gemm not implemented for this type");
 }
 
+/**
+ * This function returns the BLAS transposition flag of a matrix.
+ */
+inline CBLAS_TRANSPOSE getTranspose(bool transpose) {
+    return transpose ? CblasTrans : CblasNoTrans;
+}
+
 template <>
-inline void Gemm<double, double>(int rowsA, int columnsB, int rowsB, const double *A, const double *B, double *C) {
-    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, rowsA, columnsB, rowsB, 1.0, A, rowsB, B, columnsB, 0.0, C, columnsB);
+inline void Gemm<double, double>(bool transposeA, bool transposeB, int rows, int columns, int inner, double alpha,
+                                 const double *A, const double *B, double beta, double *C) {
+    cblas_dgemm(CblasRowMajor, getTranspose(transposeA), getTranspose(transposeB), rows, columns, inner, alpha,
+                A, transposeA ? rows : inner, B, transposeB ? inner : columns, beta, C, columns);
 }
 
 template <>
-inline void Gemm<float, float>(int rowsA, int columnsB, int rowsB, const float *A, const float *B, float *C) {
-    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, rowsA, columnsB, rowsB, 1.0f, A, rowsB, B, columnsB, 0.0f, C, columnsB);
+inline void Gemm<float, float>(bool transposeA, bool transposeB, int rows, int columns, int inner, float alpha,
+                               const float *A, const float *B, float beta, float *C) {
+    cblas_sgemm(CblasRowMajor, getTranspose(transposeA), getTranspose(transposeB), rows, columns, inner, alpha,
+                A, transposeA ? rows : inner, B, transposeB ? inner : columns, beta, C, columns);
 }
 
 template <>
-inline void Gemm<uint16_t, float>(int rowsA, int columnsB, int rowsB, const uint16_t *A, const uint16_t *B, float *C) {
-    cblas_sbgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, rowsA, columnsB, rowsB, 1.0f, A, rowsB, B, columnsB, 0.0f, C, columnsB);
+inline void Gemm<BFloat16, float>(bool transposeA, bool transposeB, int rows, int columns, int inner, float alpha,
+                                  const BFloat16 *A, const BFloat16 *B, float beta, float *C) {
+#ifdef ARRAY_HAS_SBGEMM
+    auto *left = reinterpret_cast<const bfloat16*>(A);
+    auto *right = reinterpret_cast<const bfloat16*>(B);
+    cblas_sbgemm(CblasRowMajor, getTranspose(transposeA), getTranspose(transposeB), rows, columns, inner, alpha,
+                 left, transposeA ? rows : inner, right, transposeB ? inner : columns, beta, C, columns);
+#else
+    // The BLAS library does not provide sbgemm, so both matrices are expanded to floats (exact)
+    std::vector<float> left(A, A + static_cast<size_t>(rows) * inner);
+    std::vector<float> right(B, B + static_cast<size_t>(inner) * columns);
+    Gemm<float, float>(transposeA, transposeB, rows, columns, inner, alpha, left.data(), right.data(), beta, C);
+#endif
+}
+
+/**
+ * This function computes `C = alpha * op(A) * op(B) + beta * C` with row-major integer matrices
+ * (see `Gemm`). It is a cache-blocked and register-tiled kernel, because BLAS libraries only
+ * multiply floating point matrices. The results are accumulated with 64-bit integers and wrap
+ * around on overflow. Large products are split across the `ArrayThreadPool`.
+ *
+ * @param C The elements of the result matrix (not read if `beta` is zero).
+ */
+template <class TYPE>
+void IntegerGemm(bool transposeA, bool transposeB, int rows, int columns, int inner, int64_t alpha,
+                 const TYPE *A, const TYPE *B, int64_t beta, int64_t *C);
+
+template <>
+inline void Gemm<int32_t, int64_t>(bool transposeA, bool transposeB, int rows, int columns, int inner, int64_t alpha,
+                                   const int32_t *A, const int32_t *B, int64_t beta, int64_t *C) {
+    IntegerGemm(transposeA, transposeB, rows, columns, inner, alpha, A, B, beta, C);
+}
+
+template <>
+inline void Gemm<int64_t, int64_t>(bool transposeA, bool transposeB, int rows, int columns, int inner, int64_t alpha,
+                                   const int64_t *A, const int64_t *B, int64_t beta, int64_t *C) {
+    IntegerGemm(transposeA, transposeB, rows, columns, inner, alpha, A, B, beta, C);
+}
+
+/**
+ * This function computes `y = alpha * op(A) * x + beta * y` with a row-major matrix `A`, where
+ * `op` transposes the matrix if the flag is set.
+ *
+ * @param transpose If `A` is transposed.
+ * @param rows The number of rows of `A` (as stored).
+ * @param columns The number of columns of `A` (as stored).
+ * @param alpha The factor of the product.
+ * @param A The elements of the matrix.
+ * @param x The elements of the vector.
+ * @param beta The factor of `y` (`y` is not read if it is zero).
+ * @param y The elements of the result vector.
+ */
+template <class TYPE, class RETURN_TYPE>
+inline void Gemv(bool transpose, int rows, int columns, RETURN_TYPE alpha, const TYPE *A, const TYPE *x,
+                 RETURN_TYPE beta, RETURN_TYPE *y) {
+    static_assert(sizeof(TYPE) == 0, "Gemv not implemented for this type");
+}
+
+template <>
+inline void Gemv<double, double>(bool transpose, int rows, int columns, double alpha, const double *A, const double *x,
+                                 double beta, double *y) {
+    cblas_dgemv(CblasRowMajor, getTranspose(transpose), rows, columns, alpha, A, columns, x, 1, beta, y, 1);
+}
+
+template <>
+inline void Gemv<float, float>(bool transpose, int rows, int columns, float alpha, const float *A, const float *x,
+                               float beta, float *y) {
+    cblas_sgemv(CblasRowMajor, getTranspose(transpose), rows, columns, alpha, A, columns, x, 1, beta, y, 1);
+}
+
+template <>
+inline void Gemv<BFloat16, float>(bool transpose, int rows, int columns, float alpha, const BFloat16 *A, const BFloat16 *x,
+                                  float beta, float *y) {
+    // Both operands are expanded to floats (exact)
+    std::vector<float> matrix(A, A + static_cast<size_t>(rows) * columns);
+    std::vector<float> vector(x, x + (transpose ? rows : columns));
+    Gemv<float, float>(transpose, rows, columns, alpha, matrix.data(), vector.data(), beta, y);
+}
+
+/**
+ * This function computes the dot product of two vectors.
+ *
+ * @param size The number of elements of both vectors.
+ * @param x The elements of the left vector.
+ * @param y The elements of the right vector.
+ * @return The dot product.
+ */
+template <class TYPE, class RETURN_TYPE>
+inline RETURN_TYPE Dot(int size, const TYPE *x, const TYPE *y) {
+    static_assert(sizeof(TYPE) == 0, "Dot not implemented for this type");
+}
+
+template <>
+inline double Dot<double, double>(int size, const double *x, const double *y) {
+    return cblas_ddot(size, x, 1, y, 1);
+}
+
+template <>
+inline float Dot<float, float>(int size, const float *x, const float *y) {
+    return cblas_sdot(size, x, 1, y, 1);
+}
+
+template <>
+inline float Dot<BFloat16, float>(int size, const BFloat16 *x, const BFloat16 *y) {
+    float result = 0;
+    for (int i = 0; i < size; i++) result += static_cast<float>(x[i]) * static_cast<float>(y[i]);
+    return result;
 }
 
 struct MatrixMultiplicationOperator {
 
     /**
      * This function executes a matrix multiplication operation with lists of values of type `TYPE` and
-     * copies the result in the given buffer.
+     * writes the result (of type `RETURN_TYPE`) directly in the given buffer. The result is
+     * `alpha * op(left) * op(right) + beta * accumulator` (see `Gemm`). Floating point
+     * products with a vector use `Gemv` and products of two vectors use `Dot`.
      * 
      * @param left A pointer to a value of type `TYPE`.
      * @param right A pointer to a value of type `TYPE`.
-     * @param rowsA The number of rows of the left matrix.
-     * @param rowsB The number of rows of the right matrix.
-     * @param columnsB The number of columns of the right matrix.
-     * @param buffer A reference to a char pointer which points to the string
-     * that should store the result.
+     * @param transposeLeft If the left matrix is transposed.
+     * @param transposeRight If the right matrix is transposed.
+     * @param rows The number of rows of the result.
+     * @param columns The number of columns of the result.
+     * @param inner The number of columns of the (transposed) left matrix.
+     * @param alpha The factor of the product.
+     * @param accumulator The matrix that is added to the product or `nullptr`.
+     * @param beta The factor of the accumulator.
+     * @param buffer A reference to a char pointer which points to the (aligned) elements of
+     * the string that should store the result.
      */
-	template <class TYPE>
-	static void Operator(const TYPE *left, const TYPE *right, uint32_t rowsA, uint32_t rowsB, uint32_t columnsB, char *&buffer) {
-		size_t sizeC = rowsA * columnsB;
-		std::vector<TYPE> result;
-		result.reserve(sizeC);
-
-		Gemm<TYPE, TYPE>(rowsA, columnsB, rowsB, left, right, result.data());
+	template <class TYPE, class RETURN_TYPE = TYPE>
+	static void Operator(const TYPE *left, const TYPE *right, bool transposeLeft, bool transposeRight, uint32_t rows,
+                         uint32_t columns, uint32_t inner, RETURN_TYPE alpha, const RETURN_TYPE *accumulator,
+                         RETURN_TYPE beta, char *&buffer) {
+		size_t sizeC = static_cast<size_t>(rows) * columns;
+        auto *result = reinterpret_cast<RETURN_TYPE*>(buffer);
+        if (accumulator) std::copy(accumulator, accumulator + sizeC, result);
+        else beta = 0;
 
-		memcpy(buffer, result.data(), sizeof(TYPE) * sizeC);
-        buffer += sizeof(TYPE) * sizeC;
+        if constexpr (std::is_integral_v<RETURN_TYPE>) {
+            // The integer kernel handles vectors itself (and wraps around on overflow)
+            Gemm<TYPE, RETURN_TYPE>(transposeLeft, transposeRight, rows, columns, inner, alpha, left, right, beta, result);
+        } else if (rows == 1 && columns == 1) {
+            // Both operands are vectors (independent of their transposition)
+            auto product = alpha * Dot<TYPE, RETURN_TYPE>(inner, left, right);
+            *result = beta == 0 ? product : product + beta * *result;
+        } else if (columns == 1) {
+            // The right operand is a vector: op(left) * right
+            Gemv<TYPE, RETURN_TYPE>(transposeLeft, transposeLeft ? inner : rows, transposeLeft ? rows : inner,
+                                    alpha, left, right, beta, result);
+        } else if (rows == 1) {
+            // The left operand is a vector: (op(right)^T * left)^T
+            Gemv<TYPE, RETURN_TYPE>(!transposeRight, transposeRight ? columns : inner, transposeRight ? inner : columns,
+                                    alpha, right, left, beta, result);
+        } else {
+		    Gemm<TYPE, RETURN_TYPE>(transposeLeft, transposeRight, rows, columns, inner, alpha, left, right, beta, result);
+        }
+        buffer += sizeof(RETURN_TYPE) * sizeC;
 	}
 };
 
@@ -177,4 +307,5 @@ struct ArraySigmoidOperator {
 	}
 };
 
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
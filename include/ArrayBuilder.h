@@ -0,0 +1,60 @@
+#ifndef LINGODB_RUNTIME_ARRAYBUILDER_H
+#define LINGODB_RUNTIME_ARRAYBUILDER_H
+
+#include <cstdint>
+#include <cstddef>
+#include "VarLen32.h"
+
+namespace lingodb::runtime {
+
+/**
+ * This class allocates the memory of a resulting array exactly once (from the current
+ * `ArrayAllocator`). The array data is written directly into this memory, which is then
+ * handed out as `VarLen32` without any further copy.
+ * 
+ * @note The memory is not initialized. Every byte must be written before calling `build`.
+ */
+class ArrayBuilder {
+    private:
+    // A pointer to the first byte of the result.
+    uint8_t *data;
+    // The number of bytes of the result.
+    uint32_t size;
+
+    public:
+
+    /**
+     * This constructor allocates the memory for the result from the current allocator.
+     * 
+     * @param size The number of bytes of the result.
+     */
+    ArrayBuilder(size_t size);
+
+    /**
+     * This constructor writes the result into memory provided by the caller (e.g. a part
+     * of a single allocation for a batch of results).
+     * 
+     * @param data A pointer to the first byte (aligned to 64 bytes).
+     * @param size The number of bytes of the result.
+     */
+    ArrayBuilder(uint8_t *data, size_t size);
+
+    ArrayBuilder(const ArrayBuilder &other) = delete;
+    ArrayBuilder &operator=(const ArrayBuilder &other) = delete;
+
+    /**
+     * This method returns a pointer to the first byte of the result.
+     */
+    char *getBuffer();
+
+    /**
+     * This method hands out the written memory as variable. The memory remains
+     * valid until the allocator is reset.
+     * 
+     * @return The resulting array as string in array processable format.
+     */
+    VarLen32 build();
+};
+
+}
+#endif
@@ -0,0 +1,138 @@
+#ifndef LINGODB_RUNTIME_ARRAYGENERATOR_H
+#define LINGODB_RUNTIME_ARRAYGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../include/Array.h"
+
+namespace lingodb::runtime {
+
+/**
+ * This struct describes the arrays created by an `ArrayGenerator`.
+ */
+struct ArraySpecification {
+    // The widths and the index offset of a single dimension
+    struct Dimension {
+        // The smallest and the largest width of a subarray (the same value for rectangular arrays)
+        uint32_t minWidth = 1;
+        uint32_t maxWidth = 1;
+        // The index of the first element (printed as `[lower:upper]` header if it is not 1)
+        int32_t lowerBound = 1;
+    };
+
+    // The element type (as passed to `ArrayRuntime`)
+    int32_t type = 0;
+    // Every dimension, starting with the outermost one
+    std::vector<Dimension> dimensions;
+    // The probability of an element being NULL
+    double nullDensity = 0;
+    // The smallest and the largest length of a string element
+    uint32_t minStringLength = 1;
+    uint32_t maxStringLength = 16;
+    // The range of numeric elements
+    double minValue = -1000;
+    double maxValue = 1000;
+};
+
+/**
+ * This class creates random arrays of a given specification, either in the binary format or
+ * as array literals. Every width is drawn uniformly from the range of its dimension, every
+ * string length from the range of the string lengths. The arrays only depend on the seeds
+ * (the random numbers are not taken from the standard distributions, whose results differ
+ * between standard libraries). Generators with the same structure seed create arrays with
+ * the same structure.
+ */
+class ArrayGenerator {
+    private:
+    ArraySpecification specification;
+    // The internal element type
+    uint8_t typeId;
+    // The state of the random numbers of the structure and of the elements
+    uint64_t structureState;
+    uint64_t valueState;
+    // The widths of the current array (per dimension, in the order in which they are stored)
+    std::vector<std::vector<uint32_t>> levels;
+    // The NULL flags of the current array
+    std::vector<bool> nulls;
+    // The lengths of the string elements of the current array
+    std::vector<uint32_t> stringLengths;
+    // The memory of arrays that are only generated to be printed
+    ArenaAllocator scratch;
+
+    /**
+     * This function returns the next random number of the given state (SplitMix64).
+     */
+    static uint64_t nextRandom(uint64_t &state);
+
+    /**
+     * This method returns a random number in `[min, max]` from the given state.
+     */
+    static uint32_t nextInRange(uint64_t &state, uint32_t min, uint32_t max);
+
+    /**
+     * This method draws the structure, the NULL values and the string lengths of the next array.
+     *
+     * @return The number of elements (including NULL values).
+     */
+    uint32_t drawStructure();
+
+    /**
+     * This method writes `size` random elements to the buffer.
+     */
+    template<class TYPE>
+    void writeElements(char *&buffer, uint32_t size);
+
+    public:
+
+    /**
+     * This constructor validates the specification.
+     *
+     * @param specification The arrays to create.
+     * @param seed The seed of the structures (and of the elements).
+     * @param valueSeed The seed of the elements (if generators should share their structures).
+     * @throws `std::runtime_error`: If the type is not supported, no dimension is specified, or
+     * a range is empty. If the density is not in `[0, 1]`.
+     */
+    ArrayGenerator(const ArraySpecification &specification, uint64_t seed);
+    ArrayGenerator(const ArraySpecification &specification, uint64_t seed, uint64_t valueSeed);
+
+    /**
+     * This method creates the next array. Its memory is taken from the `ArrayAllocator`.
+     *
+     * @throws `std::runtime_error`: If the array exceeds the limits of the binary format.
+     * @return The array in the binary format.
+     */
+    VarLen32 next();
+
+    /**
+     * This method creates the next `count` arrays.
+     *
+     * @param rows The target of the arrays.
+     * @param count The number of arrays.
+     */
+    void next(VarLen32 *rows, size_t count);
+
+    /**
+     * This method creates the next array and prints it as array literal (see `Array::print`).
+     *
+     * @param sink The output that receives the literal.
+     */
+    void nextLiteral(PrintSink &sink);
+
+    /**
+     * This method creates the next array as array literal.
+     */
+    std::string nextLiteral();
+
+    /**
+     * This function returns the type specification of an element type name (`int32`, `int64`,
+     * `bfloat`, `float`, `double` or `string`).
+     *
+     * @throws `std::runtime_error`: If the name is unknown.
+     */
+    static int32_t getType(const std::string &name);
+};
+
+}
+#endif
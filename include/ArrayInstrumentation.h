@@ -0,0 +1,235 @@
+#ifndef LINGODB_RUNTIME_ARRAYINSTRUMENTATION_H
+#define LINGODB_RUNTIME_ARRAYINSTRUMENTATION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <chrono>
+#include <string>
+#include "../include/VarLen32.h"
+
+namespace lingodb::runtime {
+
+/**
+ * This class records how often each `ArrayRuntime` function is called and how much work it
+ * does. Every thread counts into its own counters, which are only summed up by `snapshot`.
+ * The counters are only updated if the library is built with `ARRAY_INSTRUMENTATION`
+ * (CMake option of the same name), otherwise every measurement is compiled out and
+ * `snapshot` returns zeros.
+ */
+class ArrayInstrumentation {
+    public:
+
+    // The instrumented functions of `ArrayRuntime` (batch variants are counted separately).
+    enum Operation : uint32_t {
+        FROM_STRING,
+        APPEND,
+        SLICE,
+        SUBSCRIPT,
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        SCALAR_ADD,
+        SCALAR_SUB,
+        SCALAR_MUL,
+        SCALAR_DIV,
+        MATRIX_MUL,
+        MATRIX_MUL_ADD,
+        FILL,
+        TRANSPOSE,
+        PERMUTE,
+        SIGMOID,
+        GET_HIGHEST_POSITION,
+        GET_LOWEST_POSITION,
+        SUM,
+        PRODUCT,
+        MINIMUM,
+        MAXIMUM,
+        MEAN,
+        L1_NORM,
+        L2_NORM,
+        DOT,
+        COSINE_SIMILARITY,
+        L2_DISTANCE,
+        INNER_PRODUCT,
+        CAST,
+        INCREMENT,
+        PRINT,
+        BATCH_ADD,
+        BATCH_SUB,
+        BATCH_MUL,
+        BATCH_DIV,
+        BATCH_SUM,
+        BATCH_PRODUCT,
+        BATCH_MINIMUM,
+        BATCH_MAXIMUM,
+        BATCH_L1_NORM,
+        BATCH_L2_NORM,
+        BATCH_DOT,
+        BATCH_COSINE_SIMILARITY,
+        BATCH_L2_DISTANCE,
+        BATCH_INNER_PRODUCT,
+        OPERATION_COUNT
+    };
+
+    // The counters of a single operation.
+    struct Counters {
+        uint64_t calls = 0;
+        // The bytes of the input arrays (or literals) and of the results
+        uint64_t inputBytes = 0;
+        uint64_t outputBytes = 0;
+        // The elements of the input arrays (including NULL values)
+        uint64_t elements = 0;
+        uint64_t nanoseconds = 0;
+        // The allocations (and their bytes) requested from the `ArrayAllocator`
+        uint64_t allocations = 0;
+        uint64_t allocatedBytes = 0;
+    };
+
+    // The counters of every operation, summed up over all threads.
+    struct Snapshot {
+        std::array<Counters, OPERATION_COUNT> operations;
+
+        /**
+         * This method returns a table with one line per called operation.
+         */
+        std::string toString() const;
+
+        /**
+         * This method returns the counters of every called operation as JSON object
+         * (`{"enabled":true,"operations":{"add":{"calls":1,...},...}}`).
+         */
+        std::string toJson() const;
+    };
+
+    /**
+     * This class measures a single call of an operation. The call is counted and timed
+     * when the measurement is destroyed (also if the operation throws).
+     */
+    class Measurement {
+        private:
+        Operation operation;
+        Counters counters;
+        std::chrono::steady_clock::time_point start;
+        // The allocation counters of the current allocator before the operation
+        uint64_t allocations;
+        uint64_t allocatedBytes;
+
+        public:
+        Measurement(Operation operation);
+        ~Measurement();
+        Measurement(const Measurement &other) = delete;
+        Measurement &operator=(const Measurement &other) = delete;
+
+        /**
+         * This method adds an input of the operation.
+         *
+         * @param bytes The number of bytes of the input.
+         * @param elements The number of elements of the input (including NULL values).
+         */
+        void addInput(uint64_t bytes, uint64_t elements);
+
+        /**
+         * This method adds the bytes of the input arrays of a batch operation. The operation
+         * reports their elements with `addElements`, as it reads them anyway.
+         *
+         * @param arrays The input arrays.
+         * @param count The number of arrays.
+         */
+        void addInputs(const VarLen32 *arrays, size_t count);
+
+        /**
+         * This method adds the elements of the inputs of the operation (including NULL values).
+         */
+        void addElements(uint64_t elements);
+
+        /**
+         * This method adds the literal parsed by the operation.
+         *
+         * @param literal The array literal.
+         * @param result The parsed array (the source of the number of elements).
+         * @param type The element type of the array.
+         */
+        void addLiteral(VarLen32 literal, VarLen32 result, int32_t type);
+
+        /**
+         * This method adds the result of the operation and returns it.
+         */
+        VarLen32 addOutput(VarLen32 result);
+
+        /**
+         * This method adds a numeric result of the operation and returns it.
+         */
+        template<class TYPE>
+        TYPE addOutput(TYPE result) {
+            this->counters.outputBytes += sizeof(TYPE);
+            return result;
+        }
+
+        /**
+         * This method adds the bytes of a result that is not returned (e.g. printed text).
+         */
+        void addOutputBytes(uint64_t bytes);
+
+        /**
+         * This method adds the results of a batch operation.
+         */
+        void addOutputs(const VarLen32 *results, size_t count);
+        void addOutputs(const double *results, size_t count);
+    };
+
+    /**
+     * This function returns whether the library counts operations (see `ARRAY_INSTRUMENTATION`).
+     */
+    static constexpr bool isEnabled() {
+#ifdef ARRAY_INSTRUMENTATION
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * This function sums up the counters of every thread (including threads that have
+     * already exited). Operations that are running concurrently may be counted partially.
+     */
+    static Snapshot snapshot();
+
+    /**
+     * This function sets the counters of every thread to zero.
+     */
+    static void reset();
+
+    /**
+     * This function returns the name of an operation (the name of the `ArrayRuntime` function,
+     * prefixed with `batch` for batch variants, e.g. `batchAdd`).
+     */
+    static const char *getName(Operation operation);
+};
+
+}
+
+// Measures the current `ArrayRuntime` function (compiled out without `ARRAY_INSTRUMENTATION`).
+#ifdef ARRAY_INSTRUMENTATION
+#define ARRAY_MEASURE(OPERATION) \
+    lingodb::runtime::ArrayInstrumentation::Measurement measurement(lingodb::runtime::ArrayInstrumentation::OPERATION)
+#define ARRAY_MEASURE_INPUT(BINARY, ARRAY) measurement.addInput((BINARY).getLen(), (ARRAY).getSize(true))
+#define ARRAY_MEASURE_LITERAL(LITERAL, RESULT, TYPE) measurement.addLiteral(LITERAL, RESULT, TYPE)
+#define ARRAY_MEASURE_INPUTS(ARRAYS, COUNT) measurement.addInputs(ARRAYS, COUNT)
+#define ARRAY_MEASURE_ELEMENTS(ELEMENTS) measurement.addElements(ELEMENTS)
+#define ARRAY_MEASURE_OUTPUT(RESULT) measurement.addOutput(RESULT)
+#define ARRAY_MEASURE_OUTPUTS(RESULTS, COUNT) measurement.addOutputs(RESULTS, COUNT)
+#define ARRAY_MEASURE_OUTPUT_BYTES(BYTES) measurement.addOutputBytes(BYTES)
+#else
+#define ARRAY_MEASURE(OPERATION) static_cast<void>(0)
+#define ARRAY_MEASURE_INPUT(BINARY, ARRAY) static_cast<void>(0)
+#define ARRAY_MEASURE_LITERAL(LITERAL, RESULT, TYPE) static_cast<void>(0)
+#define ARRAY_MEASURE_INPUTS(ARRAYS, COUNT) static_cast<void>(0)
+#define ARRAY_MEASURE_ELEMENTS(ELEMENTS) static_cast<void>(0)
+#define ARRAY_MEASURE_OUTPUT(RESULT) (RESULT)
+#define ARRAY_MEASURE_OUTPUTS(RESULTS, COUNT) static_cast<void>(0)
+#define ARRAY_MEASURE_OUTPUT_BYTES(BYTES) static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef LINGODB_RUNTIME_ARRAYPRINTSINK_H
+#define LINGODB_RUNTIME_ARRAYPRINTSINK_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <functional>
+
+namespace lingodb::runtime {
+
+/**
+ * This class receives the string representation of arrays (see `Array::print`). The text is
+ * collected in a fixed buffer and handed to `write` in large parts, so a printed array never
+ * has to exist completely in memory. `flush` must be called after the last `append`.
+ */
+class PrintSink {
+    public:
+    // The number of characters collected before they are written.
+    static constexpr size_t BUFFER_SIZE = 16 * 1024;
+
+    private:
+    // The characters that have not been written yet.
+    char buffer[BUFFER_SIZE];
+    // The number of characters in the buffer.
+    size_t used = 0;
+    // The number of characters written so far (without the buffer).
+    uint64_t written = 0;
+
+    protected:
+
+    /**
+     * This method writes characters to the destination of this sink.
+     *
+     * @param data A pointer to the first character.
+     * @param size The number of characters.
+     */
+    virtual void write(const char *data, size_t size) = 0;
+
+    public:
+
+    PrintSink() = default;
+    virtual ~PrintSink() = default;
+    PrintSink(const PrintSink &other) = delete;
+    PrintSink &operator=(const PrintSink &other) = delete;
+
+    /**
+     * This method appends characters to the output.
+     *
+     * @param data A pointer to the first character.
+     * @param size The number of characters.
+     */
+    void append(const char *data, size_t size) {
+        if (size > BUFFER_SIZE - this->used) {
+            flush();
+            // Large parts are written without copying them
+            if (size >= BUFFER_SIZE) {
+                write(data, size);
+                this->written += size;
+                return;
+            }
+        }
+        memcpy(this->buffer + this->used, data, size);
+        this->used += size;
+    }
+
+    /**
+     * This method appends a single character to the output.
+     */
+    void append(char symbol) {
+        if (this->used == BUFFER_SIZE) flush();
+        this->buffer[this->used++] = symbol;
+    }
+
+    /**
+     * This method writes all collected characters.
+     */
+    void flush() {
+        if (this->used == 0) return;
+        write(this->buffer, this->used);
+        this->written += this->used;
+        this->used = 0;
+    }
+
+    /**
+     * This method returns the number of characters appended to this sink (including the
+     * characters that have not been written yet).
+     */
+    uint64_t getAppended() const {
+        return this->written + this->used;
+    }
+};
+
+/**
+ * This class appends the output to a string.
+ */
+class StringPrintSink : public PrintSink {
+    private:
+    // The string that receives the output.
+    std::string &target;
+
+    protected:
+    void write(const char *data, size_t size) override;
+
+    public:
+    StringPrintSink(std::string &target);
+};
+
+/**
+ * This class writes the output to a file descriptor (e.g. a socket or a pipe).
+ */
+class FilePrintSink : public PrintSink {
+    private:
+    // The file descriptor that receives the output.
+    int descriptor;
+
+    protected:
+    /**
+     * @throws `std::runtime_error`: If the output could not be written.
+     */
+    void write(const char *data, size_t size) override;
+
+    public:
+    FilePrintSink(int descriptor);
+};
+
+/**
+ * This class passes the output to a callback (e.g. to send it to a client).
+ */
+class CallbackPrintSink : public PrintSink {
+    public:
+    // The signature of the callback: a pointer to the first character and the number of characters.
+    using Callback = std::function<void(const char *, size_t)>;
+
+    private:
+    // The function that receives the output.
+    Callback callback;
+
+    protected:
+    void write(const char *data, size_t size) override;
+
+    public:
+    CallbackPrintSink(Callback callback);
+};
+
+}
+#endif
@@ -44,6 +44,8 @@ namespace lingodb::runtime {
         static VarLen32 scalarDiv(VarLen32 array, int32_t type, double value, bool isLeft);
 
         static VarLen32 matrixMul(VarLen32 left, VarLen32 right, int32_t leftType, int32_t rightType);
+        static VarLen32 matrixMul(VarLen32 left, VarLen32 right, int32_t leftType, int32_t rightType, bool transposeLeft, bool transposeRight, double alpha);
+        static VarLen32 matrixMulAdd(VarLen32 left, VarLen32 right, VarLen32 accumulator, int32_t leftType, int32_t rightType, int32_t accumulatorType, bool transposeLeft, bool transposeRight, double alpha, double beta);
 
         static VarLen32 fill(int32_t value, VarLen32 array, int32_t type);
         static VarLen32 fill(int64_t value, VarLen32 array, int32_t type);
@@ -53,15 +55,50 @@ namespace lingodb::runtime {
         static VarLen32 fill(VarLen32 array, int32_t type);
 
         static VarLen32 transpose(VarLen32 array, int32_t type);
+        static VarLen32 permute(VarLen32 array, int32_t type, VarLen32 axes, int32_t axesType);
 
         static VarLen32 sigmoid(VarLen32 array, int32_t type);
 
         static int32_t getHighestPosition(VarLen32 array, int32_t type);
+        static int32_t getLowestPosition(VarLen32 array, int32_t type);
+
+        static double sum(VarLen32 array, int32_t type);
+        static double product(VarLen32 array, int32_t type);
+        static double minimum(VarLen32 array, int32_t type);
+        static double maximum(VarLen32 array, int32_t type);
+        static double mean(VarLen32 array, int32_t type);
+        static double l1Norm(VarLen32 array, int32_t type);
+        static double l2Norm(VarLen32 array, int32_t type);
+
+        static double dot(VarLen32 left, VarLen32 right, int32_t leftType, int32_t rightType);
+        static double cosineSimilarity(VarLen32 left, VarLen32 right, int32_t leftType, int32_t rightType);
+        static double l2Distance(VarLen32 left, VarLen32 right, int32_t leftType, int32_t rightType);
+        static double innerProduct(VarLen32 left, VarLen32 right, int32_t leftType, int32_t rightType);
 
         static VarLen32 cast(VarLen32 array, int32_t srcType, int32_t dstType);
 
         static VarLen32 increment(VarLen32 array, int32_t type);
 
+        static void print(VarLen32 array, int32_t type, PrintSink &sink);
+
+        // Batch variants that process `count` rows per call (e.g. a morsel of a vectorised executor)
+        static void add(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, VarLen32 *result);
+        static void sub(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, VarLen32 *result);
+        static void mul(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, VarLen32 *result);
+        static void div(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, VarLen32 *result);
+
+        static void sum(const VarLen32 *arrays, size_t count, int32_t type, double *result);
+        static void product(const VarLen32 *arrays, size_t count, int32_t type, double *result);
+        static void minimum(const VarLen32 *arrays, size_t count, int32_t type, double *result);
+        static void maximum(const VarLen32 *arrays, size_t count, int32_t type, double *result);
+        static void l1Norm(const VarLen32 *arrays, size_t count, int32_t type, double *result);
+        static void l2Norm(const VarLen32 *arrays, size_t count, int32_t type, double *result);
+
+        static void dot(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, double *result);
+        static void cosineSimilarity(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, double *result);
+        static void l2Distance(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, double *result);
+        static void innerProduct(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, double *result);
+
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+#ifndef LINGODB_RUNTIME_ARRAYSIMD_H
+#define LINGODB_RUNTIME_ARRAYSIMD_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace lingodb::runtime {
+
+/**
+ * This enum defines the instruction sets for which element-wise kernels exist.
+ * A higher level includes every lower level.
+ */
+enum class SimdLevel : uint8_t {
+    SCALAR = 0,
+    SSE2 = 1,
+    // Requires AVX2 and FMA
+    AVX2 = 2,
+    // Requires AVX-512F and AVX-512DQ
+    AVX512 = 3
+};
+
+/**
+ * This enum defines which operand of a binary operation is a single value
+ * that is applied to every element of the other operand.
+ */
+enum class OperandLayout : uint8_t {
+    ARRAY_ARRAY = 0,
+    SCALAR_ARRAY = 1,
+    ARRAY_SCALAR = 2
+};
+
+/**
+ * This enum defines the reductions that combine all elements into a single value.
+ */
+enum class ReductionOperator : uint8_t {
+    SUM = 0,
+    // The sum of all absolute values (L1 norm)
+    ABSOLUTE_SUM = 1,
+    // The sum of all squared values (square of the L2 norm)
+    SQUARED_SUM = 2,
+    PRODUCT = 3,
+    MIN = 4,
+    MAX = 5
+};
+
+/**
+ * This enum defines the measures between two vectors of equal length.
+ */
+enum class DistanceOperator : uint8_t {
+    // The sum of all products of corresponding values
+    DOT = 0,
+    // The sum of all squared differences of corresponding values
+    SQUARED_L2 = 1,
+    // The dot product divided by the product of both vector lengths
+    COSINE = 2
+};
+
+/**
+ * A kernel that applies a binary operation element-wise to operands of different types.
+ * The arguments are the left operand, the right operand, the result and the number of
+ * elements. Both operands are converted to `RESULT` while they are loaded. A scalar
+ * operand points to a single value. None of the pointers must be aligned.
+ */
+template<class LEFT, class RIGHT, class RESULT>
+using PromotingKernel = void (*)(const LEFT *, const RIGHT *, RESULT *, size_t);
+
+/**
+ * A kernel that applies a binary operation element-wise (see `PromotingKernel`) to
+ * operands and results of the same type.
+ */
+template<class TYPE>
+using BinaryKernel = PromotingKernel<TYPE, TYPE, TYPE>;
+
+/**
+ * A kernel that reduces all given values into a single value. The arguments are the
+ * values and the number of values (at least one for `MIN` and `MAX`).
+ */
+template<class TYPE>
+using ReductionKernel = double (*)(const TYPE *, size_t);
+
+/**
+ * A kernel that computes a measure between two vectors. The arguments are both vectors
+ * and their number of values.
+ */
+template<class TYPE>
+using DistanceKernel = double (*)(const TYPE *, const TYPE *, size_t);
+
+/**
+ * A kernel that marks the structural characters of an array literal (`{`, `}`, `,`, `"` and
+ * `\`). The arguments are the text, its number of characters and the result, which receives
+ * one 64-bit mask per 64 characters (bit `i` marks character `i` of the block).
+ */
+using StructuralKernel = void (*)(const char *, size_t, uint64_t *);
+
+/**
+ * This class selects the element-wise kernels for the instruction set of
+ * the executing CPU. The CPU is inspected once, on first use.
+ */
+class ArraySimd {
+    public:
+
+    /**
+     * This function returns the instruction set that is currently used for all kernels.
+     */
+    static SimdLevel getLevel();
+
+    /**
+     * This function returns the best instruction set supported by the executing CPU.
+     */
+    static SimdLevel getSupportedLevel();
+
+    /**
+     * This function restricts the instruction set used for all kernels (e.g. to
+     * compare kernels with each other). A level that is not supported by the CPU
+     * is lowered to the supported level.
+     *
+     * @param level The requested instruction set.
+     */
+    static void setLevel(SimdLevel level);
+
+    /**
+     * This function returns the kernel that applies the operation `OP` (see
+     * `ArrayArithmetic.h`) to values of type `TYPE` with the current instruction set.
+     * Combinations without a vector instruction (e.g. integer division) use a
+     * scalar kernel. Brain floating point numbers are computed as floats and each
+     * result is rounded once.
+     *
+     * @param layout Which operand is a single value.
+     * @return A pointer to the kernel.
+     */
+    template<class TYPE, class OP>
+    static BinaryKernel<TYPE> getBinaryKernel(OperandLayout layout);
+
+    /**
+     * This function returns the kernel that applies the operation `OP` to a `LEFT` and a
+     * `RIGHT` operand and stores values of type `RESULT` with the current instruction set.
+     * The operands are converted to `RESULT` in the registers, so no converted copy of an
+     * operand is written. Conversions without a vector instruction (e.g. 64-bit integers
+     * to doubles below AVX-512) use a scalar kernel. `RESULT` must be the promoted type
+     * of both operands (see `Array::getPromotedType`).
+     *
+     * @param layout Which operand is a single value.
+     * @return A pointer to the kernel.
+     */
+    template<class LEFT, class RIGHT, class RESULT, class OP>
+    static PromotingKernel<LEFT, RIGHT, RESULT> getPromotingKernel(OperandLayout layout);
+
+    /**
+     * This function returns the kernel that reduces values of type `TYPE` with the
+     * current instruction set. Floating point values are summed pairwise (the rounding
+     * error grows with the logarithm of the number of values). Brain floating point
+     * numbers are reduced as floats. Integer sums use 64-bit integers, integer products
+     * and norms use doubles. Arrays with more than `ArrayThreadPool::CHUNK_SIZE` values are
+     * reduced per chunk, so their results do not depend on the number of threads.
+     *
+     * @param op The reduction.
+     * @return A pointer to the kernel.
+     */
+    template<class TYPE>
+    static ReductionKernel<TYPE> getReductionKernel(ReductionOperator op);
+
+    /**
+     * This function returns the kernel that computes a measure between two vectors of
+     * type `TYPE` with the current instruction set. The kernel reads both vectors once and
+     * does not allocate any memory.
+     *
+     * @param op The measure.
+     * @return A pointer to the kernel.
+     */
+    template<class TYPE>
+    static DistanceKernel<TYPE> getDistanceKernel(DistanceOperator op);
+
+    /**
+     * This function returns the kernel that marks the structural characters of an
+     * array literal with the current instruction set (see `Array::fromString`).
+     *
+     * @return A pointer to the kernel.
+     */
+    static StructuralKernel getStructuralKernel();
+};
+
+}
+#endif
@@ -0,0 +1,190 @@
+#ifndef LINGODB_RUNTIME_ARRAYTHREADPOOL_H
+#define LINGODB_RUNTIME_ARRAYTHREADPOOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace lingodb::runtime {
+
+/**
+ * This class splits large array operations into chunks (morsels) that are executed by a
+ * shared set of worker threads. Each worker owns a queue of chunks and steals chunks from
+ * the other queues once its own queue is empty. The calling thread executes chunks as well
+ * until its operation is finished.
+ *
+ * Operations below the threshold, and operations started from inside a chunk, run on the
+ * calling thread. Idle workers sleep, so they do not compete with the threads of the BLAS
+ * library (`matrixMul` only splits integer products and batches of small products). Chunks
+ * must not allocate memory from the `ArrayAllocator`, because each thread has its own allocator.
+ */
+class ArrayThreadPool {
+    public:
+    // The number of elements of a chunk (independent of the number of threads, so every
+    // split and every combination of partial results is deterministic).
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+    // The default minimum number of elements of an operation that is split.
+    static constexpr size_t DEFAULT_THRESHOLD = 256 * 1024;
+
+    private:
+    // A single call of `parallelFor`.
+    struct Job {
+        const std::function<void(size_t, size_t)> *task;
+        // The number of chunks that have not been finished yet
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable finished;
+        // The exception of the first failed chunk (in the order of the chunks)
+        std::exception_ptr error;
+        size_t errorChunk;
+    };
+    // A chunk of a job.
+    struct Chunk {
+        Job *job;
+        size_t index;
+        size_t begin;
+        size_t end;
+    };
+    // The chunks of a single worker.
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    // One queue per worker.
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    // The total number of threads (including the calling thread).
+    std::atomic<uint32_t> threadCount;
+    std::atomic<size_t> threshold;
+    // The number of chunks in all queues.
+    std::atomic<size_t> pending;
+    bool stopping;
+    // Held shared by every parallel operation and exclusively while the workers are stopped.
+    std::shared_mutex lifecycle;
+    // Guards the start of the workers.
+    std::mutex startMutex;
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+
+    ArrayThreadPool();
+
+    /**
+     * This method starts the workers (if they are not running yet).
+     */
+    void start();
+
+    /**
+     * This method stops all workers after they finished their current chunk.
+     */
+    void stop();
+
+    /**
+     * This method is executed by each worker until the pool is stopped.
+     *
+     * @param index The index of the queue of the worker.
+     */
+    void work(size_t index);
+
+    /**
+     * This method removes a chunk from the queues. The queue `preferred` is
+     * served from the front, every other queue from the back (stealing).
+     *
+     * @return `True` if a chunk has been found, otherwise `False`.
+     */
+    bool take(size_t preferred, Chunk &chunk);
+
+    /**
+     * This method executes a chunk and records its failure.
+     */
+    static void run(Chunk &chunk);
+
+    /**
+     * This method splits `[0, count)` into chunks of `chunkSize` and executes them on the
+     * workers and on the calling thread (see `parallelFor`).
+     */
+    void execute(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)> &task);
+
+    public:
+
+    ~ArrayThreadPool();
+    ArrayThreadPool(const ArrayThreadPool &other) = delete;
+    ArrayThreadPool &operator=(const ArrayThreadPool &other) = delete;
+
+    /**
+     * This function returns the pool shared by all array operations.
+     */
+    static ArrayThreadPool &get();
+
+    /**
+     * This method sets the number of threads that execute an operation (including the
+     * calling thread). A value of 1 executes every operation on the calling thread. This
+     * method waits until the running operations are finished.
+     *
+     * @param count The number of threads (0 selects the number of hardware threads).
+     * @throws `std::runtime_error`: If it is called from inside a chunk (by a task of
+     * `parallelFor`), which would wait for its own operation.
+     */
+    void setThreadCount(uint32_t count);
+
+    /**
+     * This method returns the number of threads that execute an operation.
+     */
+    uint32_t getThreadCount();
+
+    /**
+     * This method sets the minimum number of elements of an operation that is split. It
+     * does not wait for the running operations (also not inside a chunk), the new threshold
+     * applies to operations started afterwards.
+     */
+    void setThreshold(size_t elements);
+
+    /**
+     * This method returns the minimum number of elements of an operation that is split.
+     */
+    size_t getThreshold();
+
+    /**
+     * This method returns whether an operation on the given number of elements is split
+     * (the threshold is reached, several threads are available and the calling thread
+     * does not execute a chunk itself).
+     */
+    bool isParallel(size_t elements);
+
+    /**
+     * This method executes `task` for consecutive ranges of `[0, count)` with at most
+     * `CHUNK_SIZE` elements each. The ranges are executed in parallel if `isParallel(count)`
+     * holds, otherwise `task` is called once for the whole range. This method returns after
+     * every range has been executed.
+     *
+     * @param count The number of elements.
+     * @param task The function that processes the elements `[begin, end)`.
+     * @throws The exception of the first failed range (after every range has been finished).
+     */
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)> &task);
+
+    /**
+     * This method executes `task` for consecutive ranges of `[0, count)` like `parallelFor`,
+     * but for units that stand for `work` elements each (e.g. blocks of a matrix product).
+     * The units are executed in parallel if `isParallel(count * work)` holds. A range holds
+     * as many units as fit into `CHUNK_SIZE` elements, but at least a single unit.
+     *
+     * @param count The number of units.
+     * @param work The number of elements of a unit.
+     * @param task The function that processes the units `[begin, end)`.
+     * @throws The exception of the first failed range (after every range has been finished).
+     */
+    void parallelForUnits(size_t count, size_t work, const std::function<void(size_t, size_t)> &task);
+};
+
+}
+#endif
@@ -0,0 +1,105 @@
+#ifndef LINGODB_RUNTIME_BFLOAT16_H
+#define LINGODB_RUNTIME_BFLOAT16_H
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <type_traits>
+
+namespace lingodb::runtime {
+
+/**
+ * This class stores a brain floating point number (bfloat16). It consists of the upper
+ * 16 bits of a float (sign, 8 exponent bits and 7 mantissa bits), so it covers the range
+ * of a float with less precision. Every operation converts the values to floats and
+ * rounds the result back to the nearest brain floating point number.
+ */
+class BFloat16 {
+    private:
+    // The upper 16 bits of the corresponding float.
+    uint16_t bits;
+
+    public:
+
+    BFloat16() = default;
+
+    /**
+     * This constructor rounds a float to the nearest brain floating point number
+     * (ties to even). NaN remains NaN.
+     */
+    BFloat16(float value) : bits(fromFloat(value)) {}
+
+    /**
+     * This constructor rounds a double to the nearest brain floating point number
+     * (ties to even) without rounding twice.
+     */
+    BFloat16(double value) : bits(fromDouble(value)) {}
+
+    template<class TYPE, std::enable_if_t<std::is_integral_v<TYPE>, int> = 0>
+    BFloat16(TYPE value) : BFloat16(static_cast<double>(value)) {}
+
+    operator float() const {
+        return toFloat(this->bits);
+    }
+
+    /**
+     * This method returns the stored bits (the upper 16 bits of the corresponding float).
+     */
+    uint16_t getBits() const {
+        return this->bits;
+    }
+
+    /**
+     * This function rounds the bits of a float to the upper 16 bits (ties to even).
+     * A NaN is kept quiet, so it cannot turn into an infinity.
+     *
+     * @param value The float that should be rounded.
+     * @return The bits of the brain floating point number.
+     */
+    static uint16_t fromFloat(float value) {
+        uint32_t input;
+        memcpy(&input, &value, sizeof(float));
+        if (std::isnan(value)) {
+            return static_cast<uint16_t>((input >> 16) | 0x0040);
+        }
+        input += 0x7FFF + ((input >> 16) & 1);
+        return static_cast<uint16_t>(input >> 16);
+    }
+
+    /**
+     * This function rounds a double to the bits of a brain floating point number. The
+     * double is first rounded to odd (towards zero, the last bit marks an inexact result),
+     * so the final rounding to the upper 16 bits gives the same result as a direct one.
+     *
+     * @param value The double that should be rounded.
+     * @return The bits of the brain floating point number.
+     */
+    static uint16_t fromDouble(double value) {
+        auto rounded = static_cast<float>(value);
+        if (std::isnan(value) || rounded == value) {
+            return fromFloat(rounded);
+        }
+        uint32_t input;
+        memcpy(&input, &rounded, sizeof(float));
+        // Step back towards zero if the float has been rounded away from zero
+        if (std::fabs(static_cast<double>(rounded)) > std::fabs(value)) input--;
+        input |= 1;
+        memcpy(&rounded, &input, sizeof(float));
+        return fromFloat(rounded);
+    }
+
+    /**
+     * This function expands the bits of a brain floating point number to a float (exact).
+     */
+    static float toFloat(uint16_t bits) {
+        uint32_t output = static_cast<uint32_t>(bits) << 16;
+        float result;
+        memcpy(&result, &output, sizeof(float));
+        return result;
+    }
+};
+
+static_assert(sizeof(BFloat16) == sizeof(uint16_t), "BFloat16 must not contain padding");
+
+}
+#endif
@@ -1,3 +1,6 @@
+#ifndef LINGODB_RUNTIME_VARLEN32_H
+#define LINGODB_RUNTIME_VARLEN32_H
+
 #include <cstdint>
 #include <string>
 
@@ -15,6 +18,9 @@ class VarLen32 {
     static VarLen32 fromString(std::string value);
 
     std::string str();
+    uint8_t *getPtr();
+    uint32_t getLen();
 };
 
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,25 +1,26 @@
 #include "../include/Array.h"
-#include <iostream>
 
 using lingodb::runtime::Array;
 
 const std::string Array::ARRAYHEADER = "array";
 
-Array::Array(std::string &array, int32_t type) {
-    // Check if string is not empty
-    if (array.size() == 0) {
+Array::Array(std::string &array, int32_t type) : Array(array.data(), array.size(), type) {}
+
+Array::Array(VarLen32 &array, int32_t type) : Array(reinterpret_cast<char*>(array.getPtr()), array.getLen(), type) {}
+
+Array::Array(char *data, size_t length, int32_t type) {
+    // Check if data is not empty
+    if (length < ARRAYHEADER.size() + 1) {
         throw std::runtime_error("Array is empty");
     }
     
-    char *data = array.data();
-    std::string header(data, ARRAYHEADER.size());
-    if (header != ARRAYHEADER) {
+    if (memcmp(data, ARRAYHEADER.data(), ARRAYHEADER.size()) != 0) {
         throw std::runtime_error("Array is not processable");
     }
-    auto typeId = getTypeId(type);
-    data += ARRAYHEADER.size();
-    data += 1;
-    this->type = typeId;
+    if (static_cast<uint8_t>(data[ARRAYHEADER.size()]) == FORMAT_VERSION && length < sizeof(Header)) {
+        throw std::runtime_error("Array is not processable");
+    }
+    this->type = getTypeId(type);
     initArray(data);
 }
 
@@ -34,16 +35,37 @@ Array::Array(std::string &array) {
     if (header != ARRAYHEADER) {
         throw std::runtime_error("Array is not processable");
     }
-    data += ARRAYHEADER.size();
-    this->type = *data;
-    data += 1;
+    // Version 1 stores the type in place of the version
+    uint8_t version = data[ARRAYHEADER.size()];
+    this->type = version == FORMAT_VERSION ? data[ARRAYHEADER.size() + 1] : version;
     initArray(data);
-    if (type == ArrayType::INTEGER32 || type == ArrayType::STRING) {
-        printData();
-    }
 }
 
 void Array::initArray(char *data) {
+    if (static_cast<uint8_t>(data[ARRAYHEADER.size()]) != FORMAT_VERSION) {
+        initArrayV1(data + ARRAYHEADER.size() + 1);
+    } else {
+        // Every count and offset can be read from the header
+        Header header;
+        memcpy(&header, data, sizeof(Header));
+        this->dimensions = header.dimensions;
+        this->size = header.size;
+        this->totalSize = header.totalSize;
+        this->widthSize = header.widthSize;
+        this->stringSize = header.stringSize;
+        this->indices = reinterpret_cast<int32_t*>(data + sizeof(Header));
+        this->dimensionWidthMap = reinterpret_cast<uint32_t*>(this->indices + this->dimensions);
+        this->widths = this->dimensionWidthMap + this->dimensions;
+        this->elements = reinterpret_cast<uint8_t*>(data + header.elementOffset);
+        this->nulls = reinterpret_cast<uint8_t*>(data + header.nullOffset);
+        this->strings = data + header.stringOffset;
+    }
+    // The rank index over the NULL values and the width offsets will be built on first use
+    this->nullRanks.clear();
+    this->widthOffsets.clear();
+}
+
+void Array::initArrayV1(char *data) {
     // Assign each attribute
     this->dimensions = *reinterpret_cast<uint32_t*>(data);
     data += sizeof(uint32_t);
@@ -54,41 +76,50 @@ void Array::initArray(char *data) {
     this->dimensionWidthMap = reinterpret_cast<uint32_t*>(data);
     data += this->dimensions * sizeof(uint32_t);
     this->widths = reinterpret_cast<uint32_t*>(data);
+    this->widthSize = 0;
     for (size_t i = 0; i < this->dimensions; i++) {
-        data += this->dimensionWidthMap[i] * sizeof(uint32_t);
+        this->widthSize += this->dimensionWidthMap[i];
+    }
+    data += this->widthSize * sizeof(uint32_t);
+    // Number of elements (with NULL values) is the sum of all widths in the last dimension
+    auto *lastWidths = reinterpret_cast<uint32_t*>(data) - this->dimensionWidthMap[this->dimensions-1];
+    this->totalSize = 0;
+    for (uint32_t i = 0; i < this->dimensionWidthMap[this->dimensions-1]; i++) {
+        this->totalSize += lastWidths[i];
     }
     this->elements = reinterpret_cast<uint8_t*>(data);
     data += this->size * getTypeSize(type);
     this->nulls = reinterpret_cast<uint8_t*>(data);
-    data += getNullBytes(getSize(true));
+    data += getNullBytes(this->totalSize);
     this->strings = data;
+    this->stringSize = 0;
+    if (this->type == ArrayType::STRING) {
+        auto *lengths = reinterpret_cast<uint32_t*>(this->elements);
+        for (uint32_t i = 0; i < this->size; i++) {
+            this->stringSize += lengths[i];
+        }
+    }
 }
 
 lingodb::runtime::VarLen32 Array::createEmptyArray(int32_t type) {
     auto typeId = getTypeId(type);
-    std::string result;
     uint32_t dimension = 1;
     uint32_t elements = 0;
     auto size = getStringSize(1, 0, 1, 0, 0, typeId);
-    result.resize(size);
-    auto *buffer = &result[0];
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
     // Header
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.size());
-    // Type
-    writeToBuffer(buffer, &typeId, 1);
-    // Dimension
-    writeToBuffer(buffer, &dimension, 1);
-    // Size
-    writeToBuffer(buffer, &elements, 1);
+    writeHeader(buffer, typeId, dimension, elements, elements, 1, 0);
     // Indices
     writeToBuffer(buffer, &dimension, 1);
     // WidthMap
     writeToBuffer(buffer, &dimension, 1);
     // Widths
     writeToBuffer(buffer, &elements, 1);
+    writePadding(buffer, dimension, 1);
 
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 lingodb::runtime::VarLen32 Array::increment() {
@@ -96,20 +127,13 @@ lingodb::runtime::VarLen32 Array::increment() {
     auto dimension = this->dimensions + 1;
     auto totalElements = getSize(true);
     auto stringLengths = getStringLength();
-    std::string result;
     auto size = getStringSize(dimension, this->size, getWidthSize() + 1, getNullBytes(totalElements), stringLengths, this->type);
-    result.resize(size);
-    auto *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
     uint32_t value = 1;
     // Header
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.size());
-    // Type
-    writeToBuffer(buffer, &typeId, 1);
-    // Dimension
-    writeToBuffer(buffer, &dimension, 1);
-    // Size
-    writeToBuffer(buffer, &this->size, 1);
+    writeHeader(buffer, typeId, dimension, this->size, totalElements, getWidthSize() + 1, stringLengths);
     // Indices
     writeToBuffer(buffer, &value, 1);
     writeToBuffer(buffer, this->indices, this->dimensions);
@@ -119,12 +143,13 @@ lingodb::runtime::VarLen32 Array::increment() {
     // Widths
     writeToBuffer(buffer, &value, 1);
     writeToBuffer(buffer, this->widths, getWidthSize());
+    writePadding(buffer, dimension, getWidthSize() + 1);
 
     copyElements(buffer);
     copyNulls(buffer, this->nulls, totalElements, 0);
     copyStrings(buffer);
 
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 uint8_t Array::getTypeId(int32_t type) {
@@ -172,14 +197,72 @@ bool Array::isFloatingPointType(uint8_t type) {
 }
 
 size_t Array::getStringSize(uint32_t dimensions, uint32_t size, uint32_t widths, uint32_t nullSize, uint32_t stringSize, uint8_t type) {
-    size_t result = ARRAYHEADER.size() + 1;
-    result += (sizeof(uint32_t) * 2) + (dimensions * sizeof(int32_t)) + (dimensions * sizeof(uint32_t)) + (widths * sizeof(uint32_t));
+    size_t result = getElementOffset(dimensions, widths);
     result += size * getTypeSize(type);
     result += nullSize;
     result += stringSize;
     return result;
 }
 
+uint32_t Array::getElementOffset(uint32_t dimensions, uint32_t widths) {
+    uint32_t result = sizeof(Header) + (dimensions * sizeof(int32_t)) + (dimensions * sizeof(uint32_t)) + (widths * sizeof(uint32_t));
+    return (result + ELEMENT_ALIGNMENT - 1) & ~(ELEMENT_ALIGNMENT - 1);
+}
+
+void Array::writeHeader(char *&buffer, uint8_t type, uint32_t dimensions, uint32_t size, uint32_t totalSize, uint32_t widths, uint32_t stringSize) {
+    Header header;
+    memcpy(header.identifier, ARRAYHEADER.data(), sizeof(header.identifier));
+    header.version = FORMAT_VERSION;
+    header.type = type;
+    header.reserved = 0;
+    header.dimensions = dimensions;
+    header.size = size;
+    header.totalSize = totalSize;
+    header.widthSize = widths;
+    header.stringSize = stringSize;
+    header.elementOffset = getElementOffset(dimensions, widths);
+    header.nullOffset = header.elementOffset + size * getTypeSize(type);
+    header.stringOffset = header.nullOffset + getNullBytes(totalSize);
+    memcpy(buffer, &header, sizeof(Header));
+    buffer += sizeof(Header);
+}
+
+void Array::writePadding(char *&buffer, uint32_t dimensions, uint32_t widths) {
+    auto unaligned = sizeof(Header) + (dimensions * sizeof(int32_t)) + (dimensions * sizeof(uint32_t)) + (widths * sizeof(uint32_t));
+    auto padding = getElementOffset(dimensions, widths) - unaligned;
+    memset(buffer, 0, padding);
+    buffer += padding;
+}
+
+uint32_t Array::getRectangularWidthSize(const std::vector<uint32_t> &sizes) {
+    // Every subarray of a dimension has one width entry
+    uint32_t result = 0;
+    uint32_t entries = 1;
+    for (auto size : sizes) {
+        result += entries;
+        entries *= size;
+    }
+    return result;
+}
+
+void Array::writeRectangularStructure(char *&buffer, const std::vector<uint32_t> &sizes, const std::vector<int32_t> &indices) {
+    auto dimensions = static_cast<uint32_t>(sizes.size());
+    writeToBuffer(buffer, indices.data(), dimensions);
+    uint32_t entries = 1;
+    for (uint32_t i = 0; i < dimensions; i++) {
+        writeToBuffer(buffer, &entries, 1);
+        entries *= sizes[i];
+    }
+    entries = 1;
+    for (uint32_t i = 0; i < dimensions; i++) {
+        for (uint32_t j = 0; j < entries; j++) {
+            writeToBuffer(buffer, &sizes[i], 1);
+        }
+        entries *= sizes[i];
+    }
+    writePadding(buffer, dimensions, getRectangularWidthSize(sizes));
+}
+
 size_t Array::getTypeSize(uint8_t type) {
     switch (type) 
     {
@@ -187,6 +270,8 @@ size_t Array::getTypeSize(uint8_t type) {
         return sizeof(int32_t);
     case ArrayType::INTEGER64:
         return sizeof(int64_t);
+    case ArrayType::BFLOAT:
+        return sizeof(BFloat16);
     case ArrayType::FLOAT:
         return sizeof(float);
     case ArrayType::DOUBLE:
@@ -205,32 +290,3 @@ uint8_t Array::getType() {
 uint32_t Array::getDimension() {
     return this->dimensions;
 }
-
-void Array::printData() {
-    size_t metadataLen = 0;
-    std::cout << "INDICES:" << std::endl;
-    for (size_t i = 0; i < this->dimensions; i++) {
-        std::cout << this->indices[i] << ",";
-    }
-    std::cout << std::endl;
-    std::cout << "WIDTH-LENGTHS:" << std::endl;
-    for (size_t i = 0; i < this->dimensions; i++) {
-        std::cout << this->dimensionWidthMap[i] << ",";
-        metadataLen += this->dimensionWidthMap[i];
-    }
-    std::cout << std::endl;
-    std::cout << "WIDTH-ENTRIES:" << std::endl;
-    for (size_t i = 0; i < metadataLen; i++) {
-        std::cout << this->widths[i] << ","; 
-    }
-    std::cout << std::endl;
-    printNulls();
-}
-
-void Array::printNulls() {
-    std::cout << "NULLS:" << std::endl;
-    for (size_t i = 0; i < getSize(true); i++) {
-        std::cout << isNull(i) << ",";
-    }
-    std::cout << std::endl;
-}
\ No newline at end of file
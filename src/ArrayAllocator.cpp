@@ -0,0 +1,113 @@
+#include "../include/ArrayAllocator.h"
+#include <algorithm>
+#include <new>
+
+using lingodb::runtime::ArrayAllocator;
+using lingodb::runtime::ArenaAllocator;
+
+namespace {
+    // The allocator installed for the calling thread (nullptr if the default should be used).
+    thread_local ArrayAllocator *current = nullptr;
+
+    // The allocator of the calling thread if no allocator is installed.
+    ArenaAllocator &getDefault() {
+        thread_local ArenaAllocator defaultAllocator;
+        return defaultAllocator;
+    }
+}
+
+uint64_t ArrayAllocator::getAllocations() {
+    return this->allocations;
+}
+
+uint64_t ArrayAllocator::getAllocatedBytes() {
+    return this->allocatedBytes;
+}
+
+uint64_t ArrayAllocator::getSystemAllocations() {
+    return this->systemAllocations;
+}
+
+uint64_t ArrayAllocator::getReservedBytes() {
+    return this->reservedBytes;
+}
+
+void ArrayAllocator::resetStatistics() {
+    this->allocations = 0;
+    this->allocatedBytes = 0;
+    this->systemAllocations = 0;
+}
+
+ArrayAllocator &ArrayAllocator::get() {
+    if (current != nullptr) return *current;
+    return getDefault();
+}
+
+void ArrayAllocator::resetDefault() {
+    getDefault().reset();
+}
+
+ArrayAllocator::Scope::Scope(ArrayAllocator &allocator) {
+    this->previous = current;
+    current = &allocator;
+}
+
+ArrayAllocator::Scope::~Scope() {
+    current = this->previous;
+}
+
+ArenaAllocator::ArenaAllocator() {
+    this->chunkSize = MIN_CHUNK_SIZE;
+}
+
+ArenaAllocator::~ArenaAllocator() {
+    for (auto &chunk : this->chunks) {
+        ::operator delete[](chunk.data, std::align_val_t(ALIGNMENT));
+    }
+}
+
+uint8_t *ArenaAllocator::addChunk(size_t size) {
+    auto *data = static_cast<uint8_t*>(::operator new[](size, std::align_val_t(ALIGNMENT)));
+    this->chunks.push_back(Chunk{data, size});
+    this->systemAllocations++;
+    this->reservedBytes += size;
+    return data;
+}
+
+uint8_t *ArenaAllocator::allocate(size_t size) {
+    this->allocations++;
+    this->allocatedBytes += size;
+    if (static_cast<size_t>(this->end - this->position) < size) {
+        // Large allocations get their own chunk, so the current chunk can still be used
+        if (size > this->chunkSize) {
+            return addChunk(size);
+        }
+        this->position = addChunk(this->chunkSize);
+        this->end = this->position + this->chunkSize;
+        // Grow chunks geometrically to reduce the number of system allocations
+        this->chunkSize = std::min(this->chunkSize * 2, MAX_CHUNK_SIZE);
+    }
+    auto *result = this->position;
+    // Next allocation starts at an aligned address
+    size_t aligned = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    this->position += std::min(aligned, static_cast<size_t>(this->end - this->position));
+    return result;
+}
+
+void ArenaAllocator::reset() {
+    if (this->chunks.empty()) return;
+    // Keep the largest chunk and release every other chunk
+    auto largest = *std::max_element(this->chunks.begin(), this->chunks.end(), [](const Chunk &a, const Chunk &b) {
+        return a.size < b.size;
+    });
+    for (auto &chunk : this->chunks) {
+        if (chunk.data != largest.data) {
+            ::operator delete[](chunk.data, std::align_val_t(ALIGNMENT));
+        }
+    }
+    this->chunks.clear();
+    this->chunks.push_back(largest);
+    this->reservedBytes = largest.size;
+    this->position = largest.data;
+    this->end = largest.data + largest.size;
+}
@@ -12,27 +12,24 @@ lingodb::runtime::VarLen32 Array::appendElement(std::string value) {
     uint32_t length = value.length();
     auto stringLengths = getStringLength() + length;
 
-    std::string result;
     size_t size = getStringSize(this->dimensions, numberElements, widthSize, getNullBytes(totalElements), stringLengths, this->type);
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
     // Write complete content to result string
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &numberElements, 1);
+    writeHeader(buffer, this->type, this->dimensions, numberElements, totalElements, widthSize, stringLengths);
     writeToBuffer(buffer, this->indices, this->dimensions);
     writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
     writeToBuffer(buffer, this->widths, widthSize-1);
     writeToBuffer(buffer, &lastWidth, 1);
+    writePadding(buffer, this->dimensions, widthSize);
     copyElements(buffer);
     writeToBuffer(buffer, &length, 1);
-    copyNulls(buffer, this->nulls, totalElements, 0);
+    copyNullsWithNewBit(buffer, false, false);
     copyStrings(buffer);
     writeToBuffer(buffer, value.data(), length);
     
-    return VarLen32::fromString(result);
+    return result.build();
 };
 
 template<>
@@ -46,16 +43,12 @@ lingodb::runtime::VarLen32 Array::appendElementFront(std::string value) {
     uint32_t length = value.length();
     auto stringLengths = getStringLength() + length;
 
-    std::string result;
     size_t size = getStringSize(this->dimensions, numberElements, widthSize, getNullBytes(totalElements), stringLengths, this->type);
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
     // Write complete content to result string
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &numberElements, 1);
+    writeHeader(buffer, this->type, this->dimensions, numberElements, totalElements, widthSize, stringLengths);
     writeToBuffer(buffer, this->indices, this->dimensions);
     writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
     // Write widths from upper dimensions
@@ -63,12 +56,13 @@ lingodb::runtime::VarLen32 Array::appendElementFront(std::string value) {
     writeToBuffer(buffer, &changedWidth, 1);
     // Write not changed widths in last dimension
     writeToBuffer(buffer, this->widths + widthSize - lastWidthSize + 1, lastWidthSize-1);
+    writePadding(buffer, this->dimensions, widthSize);
     writeToBuffer(buffer, &length, 1);
     copyElements(buffer);
-    copyNulls(buffer, this->nulls, totalElements, 0);
+    copyNullsWithNewBit(buffer, false, true);
     writeToBuffer(buffer, value.data(), length);
     copyStrings(buffer);
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 template<>
@@ -105,18 +99,12 @@ lingodb::runtime::VarLen32 Array::append(Array &toAppend) {
         type
     );
     // result will store the extended array
-    std::string result;
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
-    // Add identifier and type
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-
-    // Add number dimensions and elements to the result
+    // Add identifier, type, number of dimensions and elements to the result
     uint32_t numberElements = leftElements + rightElements;
-    writeToBuffer(buffer, &leftDimension, 1);
-    writeToBuffer(buffer, &numberElements, 1);
+    writeHeader(buffer, this->type, leftDimension, numberElements, leftTotalElements + rightTotalElements, widthSize, leftStringLength + rightStringLength);
 
     // Add indicies
     writeToBuffer(buffer, this->indices, leftDimension);
@@ -174,6 +162,7 @@ lingodb::runtime::VarLen32 Array::append(Array &toAppend) {
         }
         leftIdx++;
     }
+    writePadding(buffer, leftDimension, widthSize);
     // Add elements to result
     copyElements(buffer);
     toAppend.copyElements(buffer);
@@ -190,7 +179,7 @@ lingodb::runtime::VarLen32 Array::append(Array &toAppend) {
     copyStrings(buffer);
     toAppend.copyStrings(buffer);
 
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 lingodb::runtime::VarLen32 Array::append() {
@@ -201,32 +190,21 @@ lingodb::runtime::VarLen32 Array::append() {
     auto stringLengths = getStringLength();
     auto lastWidth = this->widths[widthSize-1] + 1;
 
-    std::string result;
     size_t size = getStringSize(this->dimensions, this->size, widthSize, nullBytes, stringLengths, this->type);
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
     // Write complete content to result string
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
+    writeHeader(buffer, this->type, this->dimensions, this->size, totalElements, widthSize, stringLengths);
     writeToBuffer(buffer, this->indices, this->dimensions);
     writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
     writeToBuffer(buffer, this->widths, widthSize-1);
     writeToBuffer(buffer, &lastWidth, 1);
+    writePadding(buffer, this->dimensions, widthSize);
     copyElements(buffer);
-    writeToBuffer(buffer, this->nulls, nullBytes);
-    // Add new null bit
-    if ((totalElements-1) % 8 != 0) {
-        buffer--;
-    }
-    uint8_t newIndex = (totalElements-1) % 8;
-    uint8_t newShift = 8 - newIndex - 1;
-    *buffer |= (1 << newShift);
-    buffer++;
+    copyNullsWithNewBit(buffer, true, false);
     copyStrings(buffer);
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 template<>
@@ -247,6 +225,9 @@ lingodb::runtime::VarLen32 Array::append(int64_t &toAppend) {
 
 template<>
 lingodb::runtime::VarLen32 Array::append(float &toAppend) {
+    if (type == ArrayType::BFLOAT) {
+        return appendElement(BFloat16(toAppend));
+    }
     if (type != ArrayType::FLOAT) {
         throw std::runtime_error("Array-Append: Array elements are not of type float");
     }
@@ -287,6 +268,9 @@ lingodb::runtime::VarLen32 Array::appendFront(int64_t &toAppend) {
 
 template<>
 lingodb::runtime::VarLen32 Array::appendFront(float &toAppend) {
+    if (type == ArrayType::BFLOAT) {
+        return appendElementFront(BFloat16(toAppend));
+    }
     if (type != ArrayType::FLOAT) {
         throw std::runtime_error("Array-Append: Array elements are not of type float");
     }
@@ -1,290 +1,221 @@
 #include "../include/Array.h"
 
 using lingodb::runtime::Array;
+using lingodb::runtime::ArrayThreadPool;
+using lingodb::runtime::MatrixMultiplicationOperator;
+
+namespace {
+
+// Products with fewer multiply-adds are too small for the threads of the BLAS library, so
+// batches of them are split across the `ArrayThreadPool` instead.
+constexpr size_t SMALL_PRODUCT = 64 * 64 * 64;
+
+/**
+ * This struct describes the (batched) matrix multiplication `op(left) * op(right)`.
+ */
+struct MatrixProduct {
+    bool transposeLeft;
+    bool transposeRight;
+    // The structure of a single result matrix and the columns of op(left)
+    uint32_t rows;
+    uint32_t columns;
+    uint32_t inner;
+    // The number of matrices and the distance of the matrices of both operands (in elements),
+    // a distance of 0 multiplies the same matrix with every matrix of the other operand
+    uint32_t batches;
+    size_t leftStride;
+    size_t rightStride;
+};
+
+/**
+ * This function removes the batch dimensions from the shape of an operand, so only the
+ * (up to two) matrix dimensions remain.
+ *
+ * @param shape The shape of the operand.
+ * @return The batch dimensions.
+ */
+std::vector<uint32_t> splitMatrixShape(std::vector<uint32_t> &shape) {
+    if (shape.size() <= 2) return {};
+    std::vector<uint32_t> batch(shape.begin(), shape.end() - 2);
+    shape.erase(shape.begin(), shape.end() - 2);
+    return batch;
+}
 
-lingodb::runtime::VarLen32 Array::operator+(Array &other) {
-    if (!isNumericType(this->type)) {
-        throw std::runtime_error("Array-Add: Given element type is not numeric");
-    }
-    if (type != other.getType()) {
-        throw std::runtime_error("Array-Add: Arrays have different types");
-    }
-    if (hasNullValue() || other.hasNullValue()) {
-        throw std::runtime_error("Array-Add: NULL values are not allowed");
-    }
-    if (hasEmptyValue() || other.hasEmptyValue()) {
-        throw std::runtime_error("Array-Add: Empty array elements are not allowed");
-    }
-    if (!equalWidths(other.getWidths())) {
-        throw std::runtime_error("Array-Add: Given arrays have different structures");
+/**
+ * This function executes every matrix product of a batch and writes the results one after
+ * another into the buffer. Large products are executed one at a time by the (multi-threaded)
+ * BLAS library, batches of small products are split across the `ArrayThreadPool`.
+ *
+ * @param left The elements of the left operand.
+ * @param right The elements of the right operand.
+ * @param product The structure of the products.
+ * @param alpha The factor of each product.
+ * @param accumulator The matrices that are added to the products or `nullptr`.
+ * @param beta The factor of the accumulator.
+ * @param buffer A reference to a char pointer which points to the elements of the result.
+ */
+template<class TYPE, class RETURN_TYPE>
+void executeMatrixProducts(const TYPE *left, const TYPE *right, const MatrixProduct &product, RETURN_TYPE alpha,
+                           const RETURN_TYPE *accumulator, RETURN_TYPE beta, char *&buffer) {
+    size_t resultSize = static_cast<size_t>(product.rows) * product.columns;
+    auto execute = [&](size_t batch) {
+        char *target = buffer + sizeof(RETURN_TYPE) * resultSize * batch;
+        MatrixMultiplicationOperator::Operator<TYPE, RETURN_TYPE>(left + product.leftStride * batch,
+            right + product.rightStride * batch, product.transposeLeft, product.transposeRight, product.rows,
+            product.columns, product.inner, alpha, accumulator ? accumulator + resultSize * batch : nullptr, beta, target);
+    };
+    size_t work = resultSize * product.inner;
+    if (product.batches > 1 && work < SMALL_PRODUCT) {
+        ArrayThreadPool::get().parallelFor(product.batches * work, [&](size_t begin, size_t end) {
+            // Every product is executed by the chunk that contains its first multiply-add
+            for (size_t batch = (begin + work - 1) / work; batch * work < end; batch++) execute(batch);
+        });
+    } else {
+        for (size_t batch = 0; batch < product.batches; batch++) execute(batch);
     }
+    buffer += sizeof(RETURN_TYPE) * resultSize * product.batches;
+}
 
-    std::string result;
-    auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(this->size), 0, type);
-    result.resize(size);
-    char *buffer = result.data();
-
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
-    writeToBuffer(buffer, this->indices, this->dimensions);
-    writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
-    writeToBuffer(buffer, this->widths, getWidthSize());
-
-    executeBinaryOperation<ArrayAddOperator>(this->elements, other.getElements(), this->size, buffer, false, false, type);
-
-    copyNulls(buffer, this->nulls, this->size, 0);
-
-    return VarLen32::fromString(result);
 }
 
-lingodb::runtime::VarLen32 Array::operator-(Array &other) {
-    if (!isNumericType(this->type)) {
-        throw std::runtime_error("Array-Sub: Given element type is not numeric");
-    }
-    if (type != other.getType()) {
-        throw std::runtime_error("Array-Sub: Arrays have different types");
-    }
-    if (hasNullValue() || other.hasNullValue()) {
-        throw std::runtime_error("Array-Sub: NULL values are not allowed");
-    }
-    if (hasEmptyValue() || other.hasEmptyValue()) {
-        throw std::runtime_error("Array-Sub: Empty array elements are not allowed");
+void Array::checkBinaryStructure(Array &other, const std::string &operation) {
+    // Equal widths imply an equal number of positions, empty subarrays simply have no elements
+    bool equal = this->dimensions == other.dimensions && getWidthSize() == other.getWidthSize() &&
+        memcmp(this->dimensionWidthMap, other.dimensionWidthMap, sizeof(uint32_t) * this->dimensions) == 0 &&
+        equalWidths(other.getWidths());
+    if (!equal) {
+        throw std::runtime_error("Array-" + operation + ": Given arrays have different structures");
     }
-    if (!equalWidths(other.getWidths())) {
-        throw std::runtime_error("Array-Sub: Given arrays have different structures");
-    }
-
-    std::string result;
-    auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(this->size), 0, type);
-    result.resize(size);
-    char *buffer = result.data();
-
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
-    writeToBuffer(buffer, this->indices, this->dimensions);
-    writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
-    writeToBuffer(buffer, this->widths, getWidthSize());
+}
 
-    executeBinaryOperation<ArraySubOperator>(this->elements, other.getElements(), this->size, buffer, false, false, type);
+uint8_t Array::getPromotedType(uint8_t left, uint8_t right) {
+    return dispatchNumericType(left, [&](auto *leftType) {
+        return dispatchNumericType(right, [&](auto *rightType) {
+            using LEFT = std::remove_pointer_t<decltype(leftType)>;
+            using RIGHT = std::remove_pointer_t<decltype(rightType)>;
+            return getElementType<Promoted<LEFT, RIGHT>>();
+        });
+    });
+}
 
-    copyNulls(buffer, this->nulls, this->size, 0);
+lingodb::runtime::VarLen32 Array::operator+(Array &other) {
+    return executeElementwiseOperation<ArrayAddOperator>(other, "Add");
+}
 
-    return VarLen32::fromString(result);
+lingodb::runtime::VarLen32 Array::operator-(Array &other) {
+    return executeElementwiseOperation<ArraySubOperator>(other, "Sub");
 }
 
 lingodb::runtime::VarLen32 Array::operator*(Array &other) {
-    if (!isNumericType(this->type)) {
-        throw std::runtime_error("Array-Mul: Given element type is not numeric");
-    }
-    if (type != other.getType()) {
-        throw std::runtime_error("Array-Mul: Arrays have different types");
-    }
-    if (hasNullValue() || other.hasNullValue()) {
-        throw std::runtime_error("Array-Mul: NULL values are not allowed");
-    }
-    if (hasEmptyValue() || other.hasEmptyValue()) {
-        throw std::runtime_error("Array-Mul: Empty array elements are not allowed");
-    }
-    if (!equalWidths(other.getWidths())) {
-        throw std::runtime_error("Array-Mul: Given arrays have different structures");
-    }
-
-    std::string result;
-    auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(this->size), 0, type);
-    result.resize(size);
-    char *buffer = result.data();
-
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
-    writeToBuffer(buffer, this->indices, this->dimensions);
-    writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
-    writeToBuffer(buffer, this->widths, getWidthSize());
-
-    executeBinaryOperation<ArrayMulOperator>(this->elements, other.getElements(), this->size, buffer, false, false, type);
-
-    copyNulls(buffer, this->nulls, this->size, 0);
-
-    return VarLen32::fromString(result);
+    return executeElementwiseOperation<ArrayMulOperator>(other, "Mul");
 }
 
 lingodb::runtime::VarLen32 Array::operator/(Array &other) {
-    if (!isNumericType(this->type)) {
-        throw std::runtime_error("Array-Div: Given element type is not numeric");
-    }
-    if (type != other.getType()) {
-        throw std::runtime_error("Array-Div: Arrays have different types");
-    }
-    if (hasNullValue() || other.hasNullValue()) {
-        throw std::runtime_error("Array-Div: NULL values are not allowed");
-    }
-    if (hasEmptyValue() || other.hasEmptyValue()) {
-        throw std::runtime_error("Array-Div: Empty array elements are not allowed");
-    }
-    if (!equalWidths(other.getWidths())) {
-        throw std::runtime_error("Array-Div: Given arrays have different structures");
-    }
-
-    std::string result;
-    auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(this->size), 0, type);
-    result.resize(size);
-    char *buffer = result.data();
-
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
-    writeToBuffer(buffer, this->indices, this->dimensions);
-    writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
-    writeToBuffer(buffer, this->widths, getWidthSize());
-
-    executeBinaryOperation<ArrayDivOperator>(this->elements, other.getElements(), this->size, buffer, false, false, type);
-
-    copyNulls(buffer, this->nulls, this->size, 0);
-
-    return VarLen32::fromString(result);
+    return executeElementwiseOperation<ArrayDivOperator>(other, "Div");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarAdd(int32_t value) {
-    if (type != ArrayType::INTEGER32) {
-        throw std::runtime_error("Array-Add: Array elements are not of type integer (32-bit)");
-    }
-    return executeScalarOperation<int32_t, ArrayAddOperator>(value, true);
+    return executeScalarOperation<int32_t, ArrayAddOperator>(value, true, "Add");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarAdd(int64_t value) {
-    if (type != ArrayType::INTEGER64) {
-        throw std::runtime_error("Array-Add: Array elements are not of type integer (64-bit)");
-    }
-    return executeScalarOperation<int64_t, ArrayAddOperator>(value, true);
+    return executeScalarOperation<int64_t, ArrayAddOperator>(value, true, "Add");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarAdd(float value) {
-    if (type != ArrayType::FLOAT) {
-        throw std::runtime_error("Array-Add: Array elements are not of type float");
-    }
-    return executeScalarOperation<float, ArrayAddOperator>(value, true);
+    return executeScalarOperation<float, ArrayAddOperator>(value, true, "Add");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarAdd(double value) {
-    if (type != ArrayType::DOUBLE) {
-        throw std::runtime_error("Array-Add: Array elements are not of type double");
-    }
-    return executeScalarOperation<double, ArrayAddOperator>(value, true);
+    return executeScalarOperation<double, ArrayAddOperator>(value, true, "Add");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarSub(int32_t value, bool isLeft) {
-    if (type != ArrayType::INTEGER32) {
-        throw std::runtime_error("Array-Add: Array elements are not of type integer (32-bit)");
-    }
-    return executeScalarOperation<int32_t, ArraySubOperator>(value, isLeft);
+    return executeScalarOperation<int32_t, ArraySubOperator>(value, isLeft, "Sub");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarSub(int64_t value, bool isLeft) {
-    if (type != ArrayType::INTEGER64) {
-        throw std::runtime_error("Array-Add: Array elements are not of type integer (64-bit)");
-    }
-    return executeScalarOperation<int64_t, ArraySubOperator>(value, isLeft);
+    return executeScalarOperation<int64_t, ArraySubOperator>(value, isLeft, "Sub");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarSub(float value, bool isLeft) {
-    if (type != ArrayType::FLOAT) {
-        throw std::runtime_error("Array-Add: Array elements are not of type float");
-    }
-    return executeScalarOperation<float, ArraySubOperator>(value, isLeft);
+    return executeScalarOperation<float, ArraySubOperator>(value, isLeft, "Sub");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarSub(double value, bool isLeft) {
-    if (type != ArrayType::DOUBLE) {
-        throw std::runtime_error("Array-Add: Array elements are not of type double");
-    }
-    return executeScalarOperation<double, ArraySubOperator>(value, isLeft);
+    return executeScalarOperation<double, ArraySubOperator>(value, isLeft, "Sub");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarMul(int32_t value) {
-    if (type != ArrayType::INTEGER32) {
-        throw std::runtime_error("Array-Add: Array elements are not of type integer (32-bit)");
-    }
-    return executeScalarOperation<int32_t, ArrayMulOperator>(value, true);
+    return executeScalarOperation<int32_t, ArrayMulOperator>(value, true, "Mul");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarMul(int64_t value) {
-    if (type != ArrayType::INTEGER64) {
-        throw std::runtime_error("Array-Add: Array elements are not of type integer (64-bit)");
-    }
-    return executeScalarOperation<int64_t, ArrayMulOperator>(value, true);
+    return executeScalarOperation<int64_t, ArrayMulOperator>(value, true, "Mul");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarMul(float value) {
-    if (type != ArrayType::FLOAT) {
-        throw std::runtime_error("Array-Add: Array elements are not of type float");
-    }
-    return executeScalarOperation<float, ArrayMulOperator>(value, true);
+    return executeScalarOperation<float, ArrayMulOperator>(value, true, "Mul");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarMul(double value) {
-    if (type != ArrayType::DOUBLE) {
-        throw std::runtime_error("Array-Add: Array elements are not of type double");
-    }
-    return executeScalarOperation<double, ArrayMulOperator>(value, true);
+    return executeScalarOperation<double, ArrayMulOperator>(value, true, "Mul");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarDiv(int32_t value, bool isLeft) {
-    if (type != ArrayType::INTEGER32) {
-        throw std::runtime_error("Array-Add: Array elements are not of type integer (32-bit)");
-    }
-    return executeScalarOperation<int32_t, ArrayDivOperator>(value, isLeft);
+    return executeScalarOperation<int32_t, ArrayDivOperator>(value, isLeft, "Div");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarDiv(int64_t value, bool isLeft) {
-    if (type != ArrayType::INTEGER64) {
-        throw std::runtime_error("Array-Add: Array elements are not of type integer (64-bit)");
-    }
-    return executeScalarOperation<int64_t, ArrayDivOperator>(value, isLeft);
+    return executeScalarOperation<int64_t, ArrayDivOperator>(value, isLeft, "Div");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarDiv(float value, bool isLeft) {
-    if (type != ArrayType::FLOAT) {
-        throw std::runtime_error("Array-Add: Array elements are not of type float");
-    }
-    return executeScalarOperation<float, ArrayDivOperator>(value, isLeft);
+    return executeScalarOperation<float, ArrayDivOperator>(value, isLeft, "Div");
 }
 
 template<>
 lingodb::runtime::VarLen32 Array::scalarDiv(double value, bool isLeft) {
-    if (type != ArrayType::DOUBLE) {
-        throw std::runtime_error("Array-Add: Array elements are not of type double");
-    }
-    return executeScalarOperation<double, ArrayDivOperator>(value, isLeft);
+    return executeScalarOperation<double, ArrayDivOperator>(value, isLeft, "Div");
 }
 
 lingodb::runtime::VarLen32 Array::matrixMul(Array &other) {
-    if (!isFloatingPointType(this->type)) {
-        throw std::runtime_error("Array-MatrixMul: Given element type must be a floating point type");
+    return executeMatrixMultiplication(other, nullptr, false, false, 1.0, 0.0);
+}
+
+lingodb::runtime::VarLen32 Array::matrixMul(Array &other, bool transposeLeft, bool transposeRight, double alpha) {
+    return executeMatrixMultiplication(other, nullptr, transposeLeft, transposeRight, alpha, 0.0);
+}
+
+lingodb::runtime::VarLen32 Array::matrixMul(Array &other, Array &accumulator, bool transposeLeft, bool transposeRight, double alpha, double beta) {
+    return executeMatrixMultiplication(other, &accumulator, transposeLeft, transposeRight, alpha, beta);
+}
+
+lingodb::runtime::VarLen32 Array::executeMatrixMultiplication(Array &other, Array *accumulator, bool transposeLeft, bool transposeRight, double alpha, double beta) {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-MatrixMul: Given element type must be a numeric type");
     }
     if (this->type != other.getType()) {
         throw std::runtime_error("Array-MatrixMul: Arrays have different types");
     }
+    if (!isFloatingPointType(this->type) && (alpha != std::trunc(alpha) || beta != std::trunc(beta))) {
+        throw std::runtime_error("Array-MatrixMul: Integer matrices require integer factors");
+    }
     if (hasNullValue() || other.hasNullValue()) {
         throw std::runtime_error("Array-MatrixMul: NULL values are not allowed");
     }
@@ -294,54 +225,98 @@ lingodb::runtime::VarLen32 Array::matrixMul(Array &other) {
     if (!isSymmetric() || !other.isSymmetric()) {
         throw std::runtime_error("Array-MatrixMul: This function allows only symmetric arrays");
     }
-    auto otherDimension = other.getDimension();
-    auto *otherWidths = other.getWidths();
-    if (this->dimensions > 2 || otherDimension > 2) {
-        throw std::runtime_error("Array-MatrixMul: This function allows only up to 2 dimensional arrays");
+
+    // The last two dimensions form the matrices, all leading dimensions are batch dimensions
+    auto leftShape = getShape();
+    auto rightShape = other.getShape();
+    auto leftBatch = splitMatrixShape(leftShape);
+    auto rightBatch = splitMatrixShape(rightShape);
+    if (!leftBatch.empty() && !rightBatch.empty() && leftBatch != rightBatch) {
+        throw std::runtime_error("Array-MatrixMul: Arrays have different batch dimensions");
     }
 
-    auto rowsA = this->widths[0];
-    auto colsA = this->dimensions == 1 ? 1 : this->widths[1];
-    auto rowsB = otherWidths[0];
-    auto colsB = otherDimension == 1 ? 1 : otherWidths[1];
+    // One dimensional arrays are column vectors, transposed they become row vectors
+    auto rowsA = leftShape[0];
+    auto colsA = leftShape.size() == 1 ? 1 : leftShape[1];
+    auto rowsB = rightShape[0];
+    auto colsB = rightShape.size() == 1 ? 1 : rightShape[1];
+    size_t leftStride = leftBatch.empty() ? 0 : static_cast<size_t>(rowsA) * colsA;
+    size_t rightStride = rightBatch.empty() ? 0 : static_cast<size_t>(rowsB) * colsB;
+    if (transposeLeft) std::swap(rowsA, colsA);
+    if (transposeRight) std::swap(rowsB, colsB);
 
     if (colsA != rowsB) {
         throw std::runtime_error("Array-MatrixMul: Array-structures are not compatible for this function");
     }
 
-    uint32_t dimension = 2;
-    uint32_t elements = rowsA * colsB;
-
-    std::string result;
-    auto size = getStringSize(dimension, elements, rowsA+1, getNullBytes(elements), 0, type);
-    result.resize(size);
-    char *buffer = result.data();
-
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &dimension, 1);
-    writeToBuffer(buffer, &elements, 1);
-    uint32_t index = 1;
-    for (uint32_t i = 0; i < dimension; i++) {
-        writeToBuffer(buffer, &index, 1);
-    }
-    writeToBuffer(buffer, &index, 1);
-    writeToBuffer(buffer, &rowsA, 1);
-
-    writeToBuffer(buffer, &rowsA, 1);
-    for (uint32_t i = 0; i < rowsA; i++) {
-        writeToBuffer(buffer, &colsB, 1);
-    }
-
-    if (this->type == ArrayType::FLOAT) {
+    // An array without batch dimensions is multiplied with every matrix of the other array
+    auto shape = leftBatch.empty() ? rightBatch : leftBatch;
+    uint32_t batches = 1;
+    for (auto size : shape) batches *= size;
+    shape.push_back(rowsA);
+    shape.push_back(colsB);
+    auto dimension = static_cast<uint32_t>(shape.size());
+    uint32_t elements = batches * rowsA * colsB;
+    // Brain floating point numbers are multiplied with float accumulators and return floats,
+    // 32-bit integers are multiplied with 64-bit accumulators and return 64-bit integers
+    uint8_t resultType = this->type;
+    if (this->type == ArrayType::BFLOAT) {
+        resultType = ArrayType::FLOAT;
+    } else if (this->type == ArrayType::INTEGER32) {
+        resultType = ArrayType::INTEGER64;
+    }
+
+    const uint8_t *accumulatorElements = nullptr;
+    if (accumulator) {
+        if (accumulator->getType() != resultType) {
+            throw std::runtime_error("Array-MatrixMul: The accumulator must have the element type of the result");
+        }
+        if (accumulator->hasNullValue() || accumulator->hasEmptyValue() || !accumulator->isSymmetric()) {
+            throw std::runtime_error("Array-MatrixMul: The accumulator must be a symmetric array without NULL values");
+        }
+        if (accumulator->getShape() != shape) {
+            throw std::runtime_error("Array-MatrixMul: The accumulator does not have the structure of the result");
+        }
+        accumulatorElements = accumulator->getElements();
+    }
+
+    auto widthSize = getRectangularWidthSize(shape);
+    auto size = getStringSize(dimension, elements, widthSize, getNullBytes(elements), 0, resultType);
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
+
+    writeHeader(buffer, resultType, dimension, elements, elements, widthSize, 0);
+    writeRectangularStructure(buffer, shape, std::vector<int32_t>(dimension, 1));
+
+    MatrixProduct product{transposeLeft, transposeRight, rowsA, colsB, colsA, batches, leftStride, rightStride};
+    if (this->type == ArrayType::BFLOAT) {
+        auto *leftVal = reinterpret_cast<const BFloat16*>(this->elements);
+        auto *rightVal = reinterpret_cast<const BFloat16*>(other.getElements());
+        executeMatrixProducts<BFloat16, float>(leftVal, rightVal, product, static_cast<float>(alpha),
+            reinterpret_cast<const float*>(accumulatorElements), static_cast<float>(beta), buffer);
+    } else if (this->type == ArrayType::FLOAT) {
         auto *leftVal = reinterpret_cast<const float*>(this->elements);
         auto *rightVal = reinterpret_cast<const float*>(other.getElements());
-        MatrixMultiplicationOperator::Operator(leftVal, rightVal, rowsA, rowsB, colsB, buffer);
+        executeMatrixProducts<float, float>(leftVal, rightVal, product, static_cast<float>(alpha),
+            reinterpret_cast<const float*>(accumulatorElements), static_cast<float>(beta), buffer);
+    } else if (this->type == ArrayType::INTEGER32) {
+        auto *leftVal = reinterpret_cast<const int32_t*>(this->elements);
+        auto *rightVal = reinterpret_cast<const int32_t*>(other.getElements());
+        executeMatrixProducts<int32_t, int64_t>(leftVal, rightVal, product, static_cast<int64_t>(alpha),
+            reinterpret_cast<const int64_t*>(accumulatorElements), static_cast<int64_t>(beta), buffer);
+    } else if (this->type == ArrayType::INTEGER64) {
+        auto *leftVal = reinterpret_cast<const int64_t*>(this->elements);
+        auto *rightVal = reinterpret_cast<const int64_t*>(other.getElements());
+        executeMatrixProducts<int64_t, int64_t>(leftVal, rightVal, product, static_cast<int64_t>(alpha),
+            reinterpret_cast<const int64_t*>(accumulatorElements), static_cast<int64_t>(beta), buffer);
     } else {
         auto *leftVal = reinterpret_cast<const double*>(this->elements);
         auto *rightVal = reinterpret_cast<const double*>(other.getElements());
-        MatrixMultiplicationOperator::Operator(leftVal, rightVal, rowsA, rowsB, colsB, buffer);
+        executeMatrixProducts<double, double>(leftVal, rightVal, product, alpha,
+            reinterpret_cast<const double*>(accumulatorElements), beta, buffer);
     }
+    // Result does not contain any NULL values
+    memset(buffer, 0, getNullBytes(elements));
 
-    return VarLen32::fromString(result);
+    return result.build();
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "../include/Array.h"
+
+using lingodb::runtime::Array;
+using lingodb::runtime::ReductionOperator;
+using lingodb::runtime::DistanceOperator;
+
+void Array::executeBatchReduction(const VarLen32 *arrays, size_t count, int32_t type, ReductionOperator op, double *result, const std::string &operation, uint64_t &inputElements) {
+    auto typeId = getTypeId(type);
+    if (!isNumericType(typeId)) {
+        throw std::runtime_error("Array-" + operation + ": Given element type is not numeric");
+    }
+    switch (typeId) {
+    case ArrayType::INTEGER32:
+        return executeBatchReduction<int32_t>(arrays, count, typeId, op, result, operation, inputElements);
+    case ArrayType::INTEGER64:
+        return executeBatchReduction<int64_t>(arrays, count, typeId, op, result, operation, inputElements);
+    case ArrayType::BFLOAT:
+        return executeBatchReduction<BFloat16>(arrays, count, typeId, op, result, operation, inputElements);
+    case ArrayType::FLOAT:
+        return executeBatchReduction<float>(arrays, count, typeId, op, result, operation, inputElements);
+    default:
+        return executeBatchReduction<double>(arrays, count, typeId, op, result, operation, inputElements);
+    }
+}
+
+template<class TYPE>
+void Array::executeBatchReduction(const VarLen32 *arrays, size_t count, uint8_t type, ReductionOperator op, double *result, const std::string &operation, uint64_t &inputElements) {
+    auto kernel = ArraySimd::getReductionKernel<TYPE>(op);
+    bool needsValues = op == ReductionOperator::MIN || op == ReductionOperator::MAX;
+    for (size_t i = 0; i < count; i++) {
+        VarLen32 value = arrays[i];
+        Array array(value, type);
+        inputElements += array.totalSize;
+        if (needsValues && array.size == 0) {
+            throw std::runtime_error("Array-" + operation + ": Array does not contain any values");
+        }
+        result[i] = kernel(reinterpret_cast<const TYPE*>(array.elements), array.size);
+    }
+}
+
+void Array::executeBatchDistance(const VarLen32 *left, const VarLen32 *right, size_t count, int32_t type, DistanceOperator op, double *result, const std::string &operation, uint64_t &inputElements) {
+    auto typeId = getTypeId(type);
+    if (!isFloatingPointType(typeId)) {
+        throw std::runtime_error("Array-" + operation + ": Given element type must be a floating point type");
+    }
+    switch (typeId) {
+    case ArrayType::BFLOAT:
+        return executeBatchDistance<BFloat16>(left, right, count, typeId, op, result, operation, inputElements);
+    case ArrayType::FLOAT:
+        return executeBatchDistance<float>(left, right, count, typeId, op, result, operation, inputElements);
+    default:
+        return executeBatchDistance<double>(left, right, count, typeId, op, result, operation, inputElements);
+    }
+}
+
+template<class TYPE>
+void Array::executeBatchDistance(const VarLen32 *left, const VarLen32 *right, size_t count, uint8_t type, DistanceOperator op, double *result, const std::string &operation, uint64_t &inputElements) {
+    auto kernel = ArraySimd::getDistanceKernel<TYPE>(op);
+    for (size_t i = 0; i < count; i++) {
+        VarLen32 leftValue = left[i];
+        VarLen32 rightValue = right[i];
+        Array leftArray(leftValue, type);
+        Array rightArray(rightValue, type);
+        inputElements += static_cast<uint64_t>(leftArray.totalSize) + rightArray.totalSize;
+        if (leftArray.hasNullValue() || rightArray.hasNullValue()) {
+            throw std::runtime_error("Array-" + operation + ": NULL values are not allowed");
+        }
+        if (leftArray.size != rightArray.size) {
+            throw std::runtime_error("Array-" + operation + ": Arrays have a different number of elements");
+        }
+        result[i] = kernel(reinterpret_cast<const TYPE*>(leftArray.elements), reinterpret_cast<const TYPE*>(rightArray.elements), leftArray.size);
+        if (op == DistanceOperator::COSINE) leftArray.checkCosineSimilarity(result[i], rightArray);
+    }
+}
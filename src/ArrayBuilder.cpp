@@ -0,0 +1,23 @@
+#include "../include/ArrayBuilder.h"
+#include "../include/ArrayAllocator.h"
+
+using lingodb::runtime::ArrayBuilder;
+
+ArrayBuilder::ArrayBuilder(size_t size) {
+    // Memory of the current allocator is not initialized
+    this->data = ArrayAllocator::get().allocate(size);
+    this->size = size;
+}
+
+ArrayBuilder::ArrayBuilder(uint8_t *data, size_t size) {
+    this->data = data;
+    this->size = size;
+}
+
+char *ArrayBuilder::getBuffer() {
+    return reinterpret_cast<char*>(this->data);
+}
+
+lingodb::runtime::VarLen32 ArrayBuilder::build() {
+    return VarLen32(this->data, this->size);
+}
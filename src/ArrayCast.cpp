@@ -15,113 +15,112 @@ lingodb::runtime::VarLen32 Array::castToNumeric(uint8_t type) {
     }
     // Create result string and copy each metadata to it (keeps the same)
     auto totalElements = getSize(true);
-    std::string result;
     auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(totalElements), 0, type);
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
+    writeHeader(buffer, type, this->dimensions, this->size, totalElements, getWidthSize(), 0);
     writeToBuffer(buffer, this->indices, this->dimensions);
     writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
     writeToBuffer(buffer, this->widths, getWidthSize());
+    writePadding(buffer, this->dimensions, getWidthSize());
 
     // Iterate over each element and cast it to the provided type
-    for (uint32_t i = 0; i < this->size; i++) {
-        switch (this->type) {
-            case ArrayType::INTEGER32:
-                castAndCopyElement<int32_t>(buffer, i, type);
-                break;
-            case ArrayType::INTEGER64:
-                castAndCopyElement<int64_t>(buffer, i, type);
-                break;
-            case ArrayType::FLOAT:
-                castAndCopyElement<float>(buffer, i, type);
-                break;
-            case ArrayType::DOUBLE:
-                castAndCopyElement<double>(buffer, i, type);
-                break;
-            case ArrayType::STRING:
-                castAndCopyElement<uint32_t>(buffer, i, type);
-                break;
-            default:
-                throw std::runtime_error("Numeric-Cast-Operation: Given array type is not supported");
+    // Numeric elements are converted in independent chunks (strings are parsed sequentially)
+    auto convert = [this, type](char *buffer, size_t begin, size_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            switch (this->type) {
+                case ArrayType::INTEGER32:
+                    castAndCopyElement<int32_t>(buffer, i, type);
+                    break;
+                case ArrayType::INTEGER64:
+                    castAndCopyElement<int64_t>(buffer, i, type);
+                    break;
+                case ArrayType::BFLOAT:
+                    castAndCopyElement<BFloat16>(buffer, i, type);
+                    break;
+                case ArrayType::FLOAT:
+                    castAndCopyElement<float>(buffer, i, type);
+                    break;
+                case ArrayType::DOUBLE:
+                    castAndCopyElement<double>(buffer, i, type);
+                    break;
+                case ArrayType::STRING:
+                    castAndCopyElement<uint32_t>(buffer, i, type);
+                    break;
+                default:
+                    throw std::runtime_error("Numeric-Cast-Operation: Given array type is not supported");
+            }
         }
+    };
+    if (this->type == ArrayType::STRING) {
+        convert(buffer, 0, this->size);
+    } else {
+        auto typeSize = getTypeSize(type);
+        ArrayThreadPool::get().parallelFor(this->size, [&](size_t begin, size_t end) {
+            convert(buffer + begin * typeSize, begin, end);
+        });
     }
+    buffer += getTypeSize(type) * this->size;
     copyNulls(buffer, this->nulls, totalElements, 0);
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 lingodb::runtime::VarLen32 Array::castToString() {
     auto totalElements = getSize(true);
-    std::vector<std::string> elements;
+    // All formatted elements are stored consecutively, so only the lengths are needed
+    std::string text;
+    std::vector<uint32_t> lengths;
+    lengths.reserve(this->size);
+    char digits[MAX_ELEMENT_CHARS];
 
     // Iterate over each element and cast it to a string
-    uint32_t offset = 0;
     for (uint32_t i = 0; i < this->size; i++) {
+        uint32_t length = 0;
         switch (this->type) {
-            case ArrayType::INTEGER32: {
-                auto *values = reinterpret_cast<int32_t *>(this->elements);
-                elements.push_back(std::to_string(values[i]));
+            case ArrayType::INTEGER32:
+                length = formatElement(digits, reinterpret_cast<int32_t *>(this->elements)[i]);
                 break;
-            }
-            case ArrayType::INTEGER64: {
-                auto *values = reinterpret_cast<int64_t *>(this->elements);
-                elements.push_back(std::to_string(values[i]));
+            case ArrayType::INTEGER64:
+                length = formatElement(digits, reinterpret_cast<int64_t *>(this->elements)[i]);
                 break;
-            }
-            case ArrayType::FLOAT: {
-                auto *values = reinterpret_cast<float *>(this->elements);
-                elements.push_back(std::to_string(values[i]));
+            case ArrayType::BFLOAT:
+                length = formatElement(digits, reinterpret_cast<BFloat16 *>(this->elements)[i]);
                 break;
-            }
-            case ArrayType::DOUBLE: {
-                auto *values = reinterpret_cast<double *>(this->elements);
-                elements.push_back(std::to_string(values[i]));
+            case ArrayType::FLOAT:
+                length = formatElement(digits, reinterpret_cast<float *>(this->elements)[i]);
                 break;
-            }
-            case ArrayType::STRING: {
-                auto *values = reinterpret_cast<uint32_t *>(this->elements);
-                elements.push_back(std::string(this->strings + offset, values[i]));
-                offset += values[i];
+            case ArrayType::DOUBLE:
+                length = formatElement(digits, reinterpret_cast<double *>(this->elements)[i]);
                 break;
+            case ArrayType::STRING: {
+                // Strings are already stored in this format
+                lengths.push_back(reinterpret_cast<uint32_t *>(this->elements)[i]);
+                continue;
             }
             default:
                 throw std::runtime_error("String-Cast-Operation: Given array type is not supported");
         }
+        text.append(digits, length);
+        lengths.push_back(length);
     }
-
-    // Calculate total string length
-    uint32_t lengths = 0;
-    for (auto &entry : elements) {
-        lengths += entry.length();
-    }
+    const char *strings = this->type == ArrayType::STRING ? this->strings : text.data();
+    uint32_t stringSize = this->type == ArrayType::STRING ? getStringLength() : text.size();
 
     // Create result string and copy each metadata to it (keeps the same)
-    std::string result;
     uint8_t type = ArrayType::STRING;
-    auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(totalElements), lengths, type);
-    result.resize(size);
-    char *buffer = result.data();
+    auto size = getStringSize(this->dimensions, this->size, getWidthSize(), getNullBytes(totalElements), stringSize, type);
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &type, 1);
-    writeToBuffer(buffer, &this->dimensions, 1);
-    writeToBuffer(buffer, &this->size, 1);
+    writeHeader(buffer, type, this->dimensions, this->size, totalElements, getWidthSize(), stringSize);
     writeToBuffer(buffer, this->indices, this->dimensions);
     writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
     writeToBuffer(buffer, this->widths, getWidthSize());
+    writePadding(buffer, this->dimensions, getWidthSize());
 
-    for (auto &entry : elements) {
-        uint32_t length = entry.length();
-        writeToBuffer(buffer, &length, 1);
-    }
-
+    writeToBuffer(buffer, lengths.data(), lengths.size());
     copyNulls(buffer, this->nulls, totalElements, 0);
-    for (auto &entry : elements) {
-        writeToBuffer(buffer, entry.data(), entry.length());
-    }
-    return VarLen32::fromString(result);
-}
\ No newline at end of file
+    writeToBuffer(buffer, strings, stringSize);
+    return result.build();
+}
@@ -0,0 +1,77 @@
+#include "../include/Array.h"
+
+using lingodb::runtime::Array;
+using lingodb::runtime::DistanceOperator;
+
+namespace {
+
+template<class TYPE>
+bool isZero(const uint8_t *elements, uint32_t size) {
+    auto *values = reinterpret_cast<const TYPE*>(elements);
+    return std::all_of(values, values + size, [](TYPE value) { return static_cast<float>(value) == 0; });
+}
+
+}
+
+double Array::executeDistance(Array &other, DistanceOperator op, const std::string &operation) {
+    if (!isFloatingPointType(this->type)) {
+        throw std::runtime_error("Array-" + operation + ": Given element type must be a floating point type");
+    }
+    if (this->type != other.getType()) {
+        throw std::runtime_error("Array-" + operation + ": Arrays have different types");
+    }
+    if (hasNullValue() || other.hasNullValue()) {
+        throw std::runtime_error("Array-" + operation + ": NULL values are not allowed");
+    }
+    if (this->size != other.size) {
+        throw std::runtime_error("Array-" + operation + ": Arrays have a different number of elements");
+    }
+    switch (this->type) {
+    case ArrayType::BFLOAT:
+        return ArraySimd::getDistanceKernel<BFloat16>(op)(reinterpret_cast<const BFloat16*>(this->elements), reinterpret_cast<const BFloat16*>(other.elements), this->size);
+    case ArrayType::FLOAT:
+        return ArraySimd::getDistanceKernel<float>(op)(reinterpret_cast<const float*>(this->elements), reinterpret_cast<const float*>(other.elements), this->size);
+    case ArrayType::DOUBLE:
+        return ArraySimd::getDistanceKernel<double>(op)(reinterpret_cast<const double*>(this->elements), reinterpret_cast<const double*>(other.elements), this->size);
+    default:
+        throw std::runtime_error("Array-Type is not supported");
+    }
+}
+
+double Array::dot(Array &other) {
+    return executeDistance(other, DistanceOperator::DOT, "Dot");
+}
+
+double Array::cosineSimilarity(Array &other) {
+    auto similarity = executeDistance(other, DistanceOperator::COSINE, "CosineSimilarity");
+    checkCosineSimilarity(similarity, other);
+    return similarity;
+}
+
+double Array::l2Distance(Array &other) {
+    return std::sqrt(executeDistance(other, DistanceOperator::SQUARED_L2, "L2Distance"));
+}
+
+double Array::innerProduct(Array &other) {
+    return -executeDistance(other, DistanceOperator::DOT, "InnerProduct");
+}
+
+void Array::checkCosineSimilarity(double similarity, Array &other) {
+    // Only a NaN result has to be checked (NaN elements yield NaN as well)
+    if (std::isnan(similarity) && (isZeroVector() || other.isZeroVector())) {
+        throw std::runtime_error("Array-CosineSimilarity: The similarity is not defined for vectors of length 0");
+    }
+}
+
+bool Array::isZeroVector() {
+    switch (this->type) {
+    case ArrayType::BFLOAT:
+        return isZero<BFloat16>(this->elements, this->size);
+    case ArrayType::FLOAT:
+        return isZero<float>(this->elements, this->size);
+    case ArrayType::DOUBLE:
+        return isZero<double>(this->elements, this->size);
+    default:
+        throw std::runtime_error("Array-Type is not supported");
+    }
+}
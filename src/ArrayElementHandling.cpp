@@ -1,22 +1,15 @@
 #include "../include/Array.h"
+#include <charconv>
 
 using lingodb::runtime::Array;
+using lingodb::runtime::BFloat16;
 
 const uint8_t* Array::getElements() {
     return this->elements;
 }
 
 uint32_t Array::getSize(bool withNulls) {
-    if (withNulls) {
-        // With nulls iterate over widths of last dimension and count values
-        auto *start = getFirstWidth(this->dimensions);
-        auto limit = this->dimensionWidthMap[this->dimensions-1];
-        uint32_t result = 0;
-        for (uint32_t i = 0; i < limit; i++) {
-            result += start[i];
-        }
-        return result;
-    }
+    if (withNulls) return this->totalSize;
     return this->size;
 }
 
@@ -36,13 +29,7 @@ uint32_t Array::getDimensionSize(uint32_t dimension) {
 
 uint32_t Array::getStringLength() {
     if (this->type != ArrayType::STRING) return 0;
-    uint32_t result = 0;
-    // Iterate over each string length value
-    auto *lengths = reinterpret_cast<uint32_t*>(this->elements);
-    for (size_t i = 0; i < this->size; i++) {
-        result += lengths[i];
-    }
-    return result;
+    return this->stringSize;
 }
 
 uint32_t Array::getStringLength(uint32_t position) {
@@ -54,24 +41,6 @@ uint32_t Array::getStringLength(uint32_t position) {
     return lengths[position];
 }
 
-int32_t Array::getHighestPosition() {
-    if (this->size == 0) return 0;
-    switch (this->type) {
-    case ArrayType::INTEGER32:
-        return getMaxIndex<int32_t>();
-    case ArrayType::INTEGER64:
-        return getMaxIndex<int64_t>();
-    case ArrayType::FLOAT:
-        return getMaxIndex<float>();
-    case ArrayType::DOUBLE:
-        return getMaxIndex<double>();
-    case ArrayType::STRING:
-        return getMaxIndex<uint32_t>();
-    default:
-        throw std::runtime_error("Array-HighestPosition: Given array type is not supported in arrays");
-    }
-}
-
 void Array::copyElements(char *&buffer) {
     if (this->size == 0) return;
     switch (this->type) {
@@ -81,6 +50,9 @@ void Array::copyElements(char *&buffer) {
     case ArrayType::INTEGER64:
         writeToBuffer(buffer, reinterpret_cast<int64_t*>(this->elements), this->size);
         break;
+    case ArrayType::BFLOAT:
+        writeToBuffer(buffer, reinterpret_cast<BFloat16*>(this->elements), this->size);
+        break;
     case ArrayType::FLOAT:
         writeToBuffer(buffer, reinterpret_cast<float*>(this->elements), this->size);
         break;
@@ -112,6 +84,12 @@ void Array::copyElement(char *&buffer, uint32_t position) {
         writeToBuffer(buffer, value, 1);
         break;
     }
+    case ArrayType::BFLOAT: 
+    {
+        BFloat16 *value = reinterpret_cast<BFloat16*>(this->elements) + position;
+        writeToBuffer(buffer, value, 1);
+        break;
+    }
     case ArrayType::FLOAT: 
     {
         float *value = reinterpret_cast<float*>(this->elements) + position;
@@ -154,62 +132,120 @@ void Array::copyString(char *&buffer, uint32_t position) {
     writeToBuffer(buffer, this->strings + offset, lengths[position]);
 }
 
+namespace {
+
+/**
+ * This function parses a number with `std::from_chars`. Surrounding whitespace and a leading
+ * `+` are ignored, every other character must belong to the number.
+ *
+ * @return `std::errc::invalid_argument` if the characters are not a number,
+ * `std::errc::result_out_of_range` if the number cannot be represented by `TYPE`.
+ */
+template<class TYPE>
+std::errc parseNumber(std::string_view value, TYPE &result) {
+    size_t begin = 0;
+    size_t end = value.size();
+    while (begin < end && isspace(static_cast<unsigned char>(value[begin]))) begin++;
+    while (end > begin && isspace(static_cast<unsigned char>(value[end - 1]))) end--;
+    if (end - begin > 1 && value[begin] == '+' && value[begin + 1] != '-') begin++;
+    auto [last, error] = std::from_chars(value.data() + begin, value.data() + end, result);
+    if (error == std::errc() && last != value.data() + end) {
+        return std::errc::invalid_argument;
+    }
+    return error;
+}
+
+}
+
 template<>
-void Array::castAndCopyElement<int32_t>(char *&buffer, std::string &value) {
-    try {
-        int32_t castValue = std::stoi(value);
-        writeToBuffer(buffer, &castValue, 1);
-    } catch (std::invalid_argument &exc) {
-        throw std::runtime_error(value + " is not of type INTEGER");
-    } catch (std::out_of_range &exc) {
-        throw std::runtime_error(value + " is out of range of 32-Bit INTEGER");
+void Array::castAndCopyElement<int32_t>(char *&buffer, std::string_view value) {
+    int32_t castValue;
+    auto error = parseNumber(value, castValue);
+    if (error == std::errc::invalid_argument) {
+        throw std::runtime_error(std::string(value) + " is not of type INTEGER");
+    } else if (error == std::errc::result_out_of_range) {
+        throw std::runtime_error(std::string(value) + " is out of range of 32-Bit INTEGER");
     }
+    writeToBuffer(buffer, &castValue, 1);
 }
 
 template<>
-void Array::castAndCopyElement<int64_t>(char *&buffer, std::string &value) {
-    try {
-        int64_t castValue = std::stol(value);
-        writeToBuffer(buffer, &castValue, 1);
-    } catch (std::invalid_argument &exc) {
-        throw std::runtime_error(value + " is not of type INTEGER");
-    } catch (std::out_of_range &exc) {
-        throw std::runtime_error(value + " is out of range of 64-Bit INTEGER");
+void Array::castAndCopyElement<int64_t>(char *&buffer, std::string_view value) {
+    int64_t castValue;
+    auto error = parseNumber(value, castValue);
+    if (error == std::errc::invalid_argument) {
+        throw std::runtime_error(std::string(value) + " is not of type INTEGER");
+    } else if (error == std::errc::result_out_of_range) {
+        throw std::runtime_error(std::string(value) + " is out of range of 64-Bit INTEGER");
+    }
+    writeToBuffer(buffer, &castValue, 1);
+}
+
+template<>
+void Array::castAndCopyElement<BFloat16>(char *&buffer, std::string_view value) {
+    // Parse a double, so the value is rounded only once
+    double parsedValue;
+    auto error = parseNumber(value, parsedValue);
+    if (error == std::errc::invalid_argument) {
+        throw std::runtime_error(std::string(value) + " is not of type BFLOAT");
+    }
+    BFloat16 castValue(parsedValue);
+    if (error == std::errc::result_out_of_range || (std::isinf(static_cast<float>(castValue)) && !std::isinf(parsedValue))) {
+        throw std::runtime_error(std::string(value) + " is out of range of BFLOAT");
     }
+    writeToBuffer(buffer, &castValue, 1);
 }
 
 template<>
-void Array::castAndCopyElement<float>(char *&buffer, std::string &value) {
-    try {
-        float castValue = std::stof(value);
-        writeToBuffer(buffer, &castValue, 1);
-    } catch (std::invalid_argument &exc) {
-        throw std::runtime_error(value + " is not of type FLOAT");
-    } catch (std::out_of_range &exc) {
-        throw std::runtime_error(value + " is out of range of FLOAT");
+void Array::castAndCopyElement<float>(char *&buffer, std::string_view value) {
+    float castValue;
+    auto error = parseNumber(value, castValue);
+    if (error == std::errc::invalid_argument) {
+        throw std::runtime_error(std::string(value) + " is not of type FLOAT");
+    } else if (error == std::errc::result_out_of_range) {
+        throw std::runtime_error(std::string(value) + " is out of range of FLOAT");
     }
+    writeToBuffer(buffer, &castValue, 1);
 }
 
 template<>
-void Array::castAndCopyElement<double>(char *&buffer, std::string &value) {
-    try {
-        double castValue = std::stod(value);
-        writeToBuffer(buffer, &castValue, 1);
-    } catch (std::invalid_argument &exc) {
-        throw std::runtime_error(value + " is not of type DOUBLE");
-    } catch (std::out_of_range &exc) {
-        throw std::runtime_error(value + " is out of range of DOUBLE");
+void Array::castAndCopyElement<double>(char *&buffer, std::string_view value) {
+    double castValue;
+    auto error = parseNumber(value, castValue);
+    if (error == std::errc::invalid_argument) {
+        throw std::runtime_error(std::string(value) + " is not of type DOUBLE");
+    } else if (error == std::errc::result_out_of_range) {
+        throw std::runtime_error(std::string(value) + " is out of range of DOUBLE");
     }
+    writeToBuffer(buffer, &castValue, 1);
 }
 
 template<>
-void Array::castAndCopyElement<std::string>(char *&buffer, std::string &value) {
-    writeToBuffer(buffer, &value, value.size());
+void Array::castAndCopyElement<std::string>(char *&buffer, std::string_view value) {
+    writeToBuffer(buffer, value.data(), value.size());
+}
+
+uint32_t Array::formatBFloat16(char *target, BFloat16 value) {
+    float widened = value;
+    auto *end = std::to_chars(target, target + MAX_ELEMENT_CHARS, widened).ptr;
+    if (!std::isfinite(widened)) return end - target;
+    // The shortest float is exact, but fewer digits may already identify the brain floating point number
+    char digits[MAX_ELEMENT_CHARS];
+    for (int precision = 1; precision < 9; precision++) {
+        auto *last = std::to_chars(digits, digits + MAX_ELEMENT_CHARS, widened, std::chars_format::general, precision).ptr;
+        if (last - digits >= end - target) break;
+        double parsed;
+        std::from_chars(digits, last, parsed);
+        if (BFloat16(parsed).getBits() == value.getBits()) {
+            memcpy(target, digits, last - digits);
+            return last - digits;
+        }
+    }
+    return end - target;
 }
 
 uint32_t Array::getElementPosition(uint32_t position) {
-    auto size = getSize(true);
-    if (size <= position) {
+    if (this->totalSize <= position) {
         throw std::runtime_error("Requested array element does not exist");
     }
     return position - countNulls(position);
@@ -221,7 +257,8 @@ void Array::toString<int32_t>(uint32_t position, std::string &target) {
         throw std::runtime_error("Requested array element does not exist");
     }
     int32_t value = *reinterpret_cast<int32_t*>(this->elements + position * sizeof(int32_t));
-    target.append(std::to_string(value));
+    char digits[MAX_ELEMENT_CHARS];
+    target.append(digits, formatElement(digits, value));
 }
 
 template<>
@@ -230,7 +267,18 @@ void Array::toString<int64_t>(uint32_t position, std::string &target) {
         throw std::runtime_error("Requested array element does not exist");
     }
     int64_t value = *reinterpret_cast<int64_t*>(this->elements + position * sizeof(int64_t));
-    target.append(std::to_string(value));
+    char digits[MAX_ELEMENT_CHARS];
+    target.append(digits, formatElement(digits, value));
+}
+
+template<>
+void Array::toString<BFloat16>(uint32_t position, std::string &target) {
+    if (this->size <= position) {
+        throw std::runtime_error("Requested array element does not exist");
+    }
+    BFloat16 value = *reinterpret_cast<BFloat16*>(this->elements + position * sizeof(BFloat16));
+    char digits[MAX_ELEMENT_CHARS];
+    target.append(digits, formatElement(digits, value));
 }
 
 template<>
@@ -239,7 +287,8 @@ void Array::toString<float>(uint32_t position, std::string &target) {
         throw std::runtime_error("Requested array element does not exist");
     }
     float value = *reinterpret_cast<float*>(this->elements + position * sizeof(float));
-    target.append(std::to_string(value));
+    char digits[MAX_ELEMENT_CHARS];
+    target.append(digits, formatElement(digits, value));
 }
 
 template<>
@@ -248,7 +297,8 @@ void Array::toString<double>(uint32_t position, std::string &target) {
         throw std::runtime_error("Requested array element does not exist");
     }
     double value = *reinterpret_cast<double*>(this->elements + position * sizeof(double));
-    target.append(std::to_string(value));
+    char digits[MAX_ELEMENT_CHARS];
+    target.append(digits, formatElement(digits, value));
 }
 
 template<>
@@ -262,10 +312,9 @@ void Array::toString<std::string>(uint32_t position, std::string &target) {
     for (uint32_t i = 0; i < position; i++) {
         offset += lengths[i];
     }
-    std::string value = std::string(this->strings + offset, lengths[position]);
-    target.append("\"");
-    target.append(value);
-    target.append("\"");
+    target.push_back('"');
+    target.append(this->strings + offset, lengths[position]);
+    target.push_back('"');
 }
 
 bool Array::hasEmptyValue() {
@@ -0,0 +1,217 @@
+#include "../include/ArrayGenerator.h"
+#include <cmath>
+#include <limits>
+
+using lingodb::runtime::ArrayGenerator;
+using lingodb::runtime::ArraySpecification;
+using lingodb::runtime::Array;
+using lingodb::runtime::BFloat16;
+
+ArrayGenerator::ArrayGenerator(const ArraySpecification &specification, uint64_t seed)
+    : ArrayGenerator(specification, seed, seed ^ 0x9E3779B97F4A7C15ULL) {}
+
+ArrayGenerator::ArrayGenerator(const ArraySpecification &specification, uint64_t seed, uint64_t valueSeed)
+    : specification(specification), structureState(seed), valueState(valueSeed) {
+    this->typeId = Array::getTypeId(specification.type);
+    if (specification.dimensions.empty()) {
+        throw std::runtime_error("Array-Generator: At least one dimension must be specified");
+    }
+    for (auto &dimension : specification.dimensions) {
+        if (dimension.minWidth > dimension.maxWidth) {
+            throw std::runtime_error("Array-Generator: The smallest width is larger than the largest width");
+        }
+    }
+    if (!(specification.nullDensity >= 0 && specification.nullDensity <= 1)) {
+        throw std::runtime_error("Array-Generator: The NULL density must be in [0, 1]");
+    }
+    if (specification.minStringLength > specification.maxStringLength) {
+        throw std::runtime_error("Array-Generator: The smallest string length is larger than the largest string length");
+    }
+    if (!(specification.minValue <= specification.maxValue)) {
+        throw std::runtime_error("Array-Generator: The smallest value is larger than the largest value");
+    }
+    bool isInteger = this->typeId == Array::ArrayType::INTEGER32 || this->typeId == Array::ArrayType::INTEGER64;
+    if (isInteger && std::ceil(specification.minValue) > std::floor(specification.maxValue)) {
+        throw std::runtime_error("Array-Generator: The range of values does not contain an integer");
+    }
+    this->levels.resize(specification.dimensions.size());
+}
+
+uint64_t ArrayGenerator::nextRandom(uint64_t &state) {
+    uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+uint32_t ArrayGenerator::nextInRange(uint64_t &state, uint32_t min, uint32_t max) {
+    if (min == max) return min;
+    return min + nextRandom(state) % (static_cast<uint64_t>(max) - min + 1);
+}
+
+uint32_t ArrayGenerator::drawStructure() {
+    // The number of subarrays in the current dimension
+    uint64_t count = 1;
+    for (size_t i = 0; i < this->levels.size(); i++) {
+        auto &dimension = this->specification.dimensions[i];
+        auto &level = this->levels[i];
+        level.resize(count);
+        count = 0;
+        for (auto &width : level) {
+            width = nextInRange(this->structureState, dimension.minWidth, dimension.maxWidth);
+            count += width;
+        }
+        if (count > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Array-Generator: The array contains too many elements");
+        }
+    }
+
+    this->nulls.assign(count, false);
+    this->stringLengths.clear();
+    for (uint64_t i = 0; i < count; i++) {
+        if (this->specification.nullDensity > 0) {
+            // A uniform number in [0, 1)
+            double probability = (nextRandom(this->valueState) >> 11) * 0x1.0p-53;
+            this->nulls[i] = probability < this->specification.nullDensity;
+        }
+        if (this->typeId == Array::ArrayType::STRING && !this->nulls[i]) {
+            this->stringLengths.push_back(nextInRange(this->valueState, this->specification.minStringLength, this->specification.maxStringLength));
+        }
+    }
+    return count;
+}
+
+template<class TYPE>
+void ArrayGenerator::writeElements(char *&buffer, uint32_t size) {
+    auto *elements = reinterpret_cast<TYPE*>(buffer);
+    if constexpr (std::is_integral_v<TYPE>) {
+        // The range is restricted to the values of the type. The bounds are clamped in the integer
+        // domain, since the largest 64-bit integer is rounded up to 2^63 as double.
+        auto clamp = [](double value) -> int64_t {
+            if (value <= static_cast<double>(std::numeric_limits<TYPE>::min())) return std::numeric_limits<TYPE>::min();
+            if (value >= static_cast<double>(std::numeric_limits<TYPE>::max())) return std::numeric_limits<TYPE>::max();
+            return static_cast<int64_t>(value);
+        };
+        auto min = static_cast<uint64_t>(clamp(std::ceil(this->specification.minValue)));
+        auto max = static_cast<uint64_t>(clamp(std::floor(this->specification.maxValue)));
+        // The number of values (0 if the range contains every 64-bit integer)
+        uint64_t range = max - min + 1;
+        for (uint32_t i = 0; i < size; i++) {
+            auto offset = range == 0 ? nextRandom(this->valueState) : nextRandom(this->valueState) % range;
+            elements[i] = static_cast<TYPE>(static_cast<int64_t>(min + offset));
+        }
+    } else {
+        double min = this->specification.minValue;
+        double range = this->specification.maxValue - min;
+        for (uint32_t i = 0; i < size; i++) {
+            elements[i] = static_cast<TYPE>(min + range * ((nextRandom(this->valueState) >> 11) * 0x1.0p-53));
+        }
+    }
+    buffer += sizeof(TYPE) * size;
+}
+
+lingodb::runtime::VarLen32 ArrayGenerator::next() {
+    uint32_t totalSize = drawStructure();
+    uint32_t dimensions = this->levels.size();
+    uint64_t widthSize = 0;
+    for (auto &level : this->levels) {
+        widthSize += level.size();
+    }
+    uint32_t size = 0;
+    for (bool isNull : this->nulls) {
+        size += !isNull;
+    }
+    uint64_t stringSize = 0;
+    for (auto length : this->stringLengths) {
+        stringSize += length;
+    }
+    if (widthSize > std::numeric_limits<uint32_t>::max() || stringSize > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Array-Generator: The array exceeds the size of the binary format");
+    }
+
+    auto resultSize = Array::getStringSize(dimensions, size, widthSize, Array::getNullBytes(totalSize), stringSize, this->typeId);
+    if (resultSize > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Array-Generator: The array exceeds the size of the binary format");
+    }
+    ArrayBuilder result(resultSize);
+    char *buffer = result.getBuffer();
+
+    Array::writeHeader(buffer, this->typeId, dimensions, size, totalSize, widthSize, stringSize);
+    for (auto &dimension : this->specification.dimensions) {
+        Array::writeToBuffer(buffer, &dimension.lowerBound, 1);
+    }
+    for (auto &level : this->levels) {
+        uint32_t levelSize = level.size();
+        Array::writeToBuffer(buffer, &levelSize, 1);
+    }
+    for (auto &level : this->levels) {
+        if (!level.empty()) Array::writeToBuffer(buffer, level.data(), level.size());
+    }
+    Array::writePadding(buffer, dimensions, widthSize);
+
+    switch (this->typeId) {
+        case Array::ArrayType::INTEGER32:
+            writeElements<int32_t>(buffer, size);
+            break;
+        case Array::ArrayType::INTEGER64:
+            writeElements<int64_t>(buffer, size);
+            break;
+        case Array::ArrayType::BFLOAT:
+            writeElements<BFloat16>(buffer, size);
+            break;
+        case Array::ArrayType::FLOAT:
+            writeElements<float>(buffer, size);
+            break;
+        case Array::ArrayType::DOUBLE:
+            writeElements<double>(buffer, size);
+            break;
+        default:
+            if (size != 0) Array::writeToBuffer(buffer, this->stringLengths.data(), size);
+            break;
+    }
+    Array::copyNulls(buffer, this->nulls);
+
+    if (this->typeId == Array::ArrayType::STRING) {
+        // Lower case letters (every random number provides eight characters)
+        uint64_t letters = 0;
+        for (uint64_t i = 0; i < stringSize; i++) {
+            if (i % 8 == 0) letters = nextRandom(this->valueState);
+            buffer[i] = static_cast<char>('a' + (letters & 0xFF) % 26);
+            letters >>= 8;
+        }
+        buffer += stringSize;
+    }
+    return result.build();
+}
+
+void ArrayGenerator::next(VarLen32 *rows, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        rows[i] = next();
+    }
+}
+
+void ArrayGenerator::nextLiteral(PrintSink &sink) {
+    {
+        ArrayAllocator::Scope scope(this->scratch);
+        auto array = next();
+        Array(array, this->specification.type).print(sink);
+    }
+    this->scratch.reset();
+}
+
+std::string ArrayGenerator::nextLiteral() {
+    std::string result;
+    StringPrintSink sink(result);
+    nextLiteral(sink);
+    return result;
+}
+
+int32_t ArrayGenerator::getType(const std::string &name) {
+    if (name == "int32") return Array::ArrayType::INTEGER32;
+    if (name == "int64") return Array::ArrayType::INTEGER64;
+    if (name == "bfloat") return Array::ArrayType::BFLOAT;
+    if (name == "float") return Array::ArrayType::FLOAT;
+    if (name == "double") return Array::ArrayType::DOUBLE;
+    if (name == "string") return Array::ArrayType::STRING;
+    throw std::runtime_error("Array-Generator: Unknown element type " + name);
+}
@@ -0,0 +1,239 @@
+#include "../include/ArrayInstrumentation.h"
+#include "../include/Array.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+using lingodb::runtime::ArrayInstrumentation;
+using lingodb::runtime::ArrayAllocator;
+using lingodb::runtime::Array;
+using lingodb::runtime::VarLen32;
+
+namespace {
+
+const char *OPERATION_NAMES[] = {
+    "fromString", "append", "slice", "subscript", "add", "sub", "mul", "div",
+    "scalarAdd", "scalarSub", "scalarMul", "scalarDiv", "matrixMul", "matrixMulAdd", "fill", "transpose", "permute", "sigmoid",
+    "getHighestPosition", "getLowestPosition", "sum", "product", "minimum", "maximum", "mean", "l1Norm", "l2Norm",
+    "dot", "cosineSimilarity", "l2Distance", "innerProduct", "cast", "increment", "print",
+    "batchAdd", "batchSub", "batchMul", "batchDiv", "batchSum", "batchProduct", "batchMinimum", "batchMaximum",
+    "batchL1Norm", "batchL2Norm", "batchDot", "batchCosineSimilarity", "batchL2Distance", "batchInnerProduct",
+};
+static_assert(sizeof(OPERATION_NAMES) / sizeof(OPERATION_NAMES[0]) == ArrayInstrumentation::OPERATION_COUNT);
+
+// Every value of `ArrayInstrumentation::Counters` (in the order of the thread counters).
+constexpr uint64_t ArrayInstrumentation::Counters::*FIELDS[] = {
+    &ArrayInstrumentation::Counters::calls,
+    &ArrayInstrumentation::Counters::inputBytes,
+    &ArrayInstrumentation::Counters::outputBytes,
+    &ArrayInstrumentation::Counters::elements,
+    &ArrayInstrumentation::Counters::nanoseconds,
+    &ArrayInstrumentation::Counters::allocations,
+    &ArrayInstrumentation::Counters::allocatedBytes,
+};
+constexpr size_t COUNTER_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+/**
+ * This struct stores the counters of a single thread. They are only written by their thread,
+ * but read (and reset) by any thread, so they are atomic.
+ */
+struct ThreadCounters {
+    std::atomic<uint64_t> values[ArrayInstrumentation::OPERATION_COUNT][COUNTER_COUNT] = {};
+
+    ThreadCounters();
+    ~ThreadCounters();
+};
+
+/**
+ * This struct knows the counters of every running thread.
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadCounters*> threads;
+    // The counters of the threads that have already exited
+    ArrayInstrumentation::Snapshot exited{};
+};
+
+/**
+ * This function adds the counters of a thread to a snapshot.
+ */
+void addTo(ArrayInstrumentation::Snapshot &snapshot, const ThreadCounters &thread) {
+    for (size_t i = 0; i < ArrayInstrumentation::OPERATION_COUNT; i++) {
+        for (size_t j = 0; j < COUNTER_COUNT; j++) {
+            snapshot.operations[i].*FIELDS[j] += thread.values[i][j].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+Registry &getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+// The registry is created before the first counters, so it is destroyed after the last ones
+ThreadCounters::ThreadCounters() {
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    addTo(registry.exited, *this);
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+}
+
+ThreadCounters &getThreadCounters() {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+/**
+ * This function appends a JSON member (`"name":value`).
+ */
+void appendMember(std::string &text, const char *name, uint64_t value) {
+    text += '"';
+    text += name;
+    text += "\":";
+    text += std::to_string(value);
+}
+
+}
+
+ArrayInstrumentation::Measurement::Measurement(Operation operation) : operation(operation) {
+    auto &allocator = ArrayAllocator::get();
+    this->allocations = allocator.getAllocations();
+    this->allocatedBytes = allocator.getAllocatedBytes();
+    this->start = std::chrono::steady_clock::now();
+}
+
+ArrayInstrumentation::Measurement::~Measurement() {
+    auto end = std::chrono::steady_clock::now();
+    auto &allocator = ArrayAllocator::get();
+    this->counters.calls = 1;
+    this->counters.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - this->start).count();
+    this->counters.allocations = allocator.getAllocations() - this->allocations;
+    this->counters.allocatedBytes = allocator.getAllocatedBytes() - this->allocatedBytes;
+
+    auto &target = getThreadCounters().values[this->operation];
+    for (size_t i = 0; i < COUNTER_COUNT; i++) {
+        // Only this thread writes its counters, so an uncontended increment suffices
+        target[i].fetch_add(this->counters.*FIELDS[i], std::memory_order_relaxed);
+    }
+}
+
+void ArrayInstrumentation::Measurement::addInput(uint64_t bytes, uint64_t elements) {
+    this->counters.inputBytes += bytes;
+    this->counters.elements += elements;
+}
+
+void ArrayInstrumentation::Measurement::addInputs(const VarLen32 *arrays, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        VarLen32 array = arrays[i];
+        this->counters.inputBytes += array.getLen();
+    }
+}
+
+void ArrayInstrumentation::Measurement::addElements(uint64_t elements) {
+    this->counters.elements += elements;
+}
+
+void ArrayInstrumentation::Measurement::addLiteral(VarLen32 literal, VarLen32 result, int32_t type) {
+    addInput(literal.getLen(), Array(result, type).getSize(true));
+}
+
+VarLen32 ArrayInstrumentation::Measurement::addOutput(VarLen32 result) {
+    this->counters.outputBytes += result.getLen();
+    return result;
+}
+
+void ArrayInstrumentation::Measurement::addOutputBytes(uint64_t bytes) {
+    this->counters.outputBytes += bytes;
+}
+
+void ArrayInstrumentation::Measurement::addOutputs(const VarLen32 *results, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        VarLen32 result = results[i];
+        this->counters.outputBytes += result.getLen();
+    }
+}
+
+void ArrayInstrumentation::Measurement::addOutputs(const double *, size_t count) {
+    this->counters.outputBytes += sizeof(double) * count;
+}
+
+ArrayInstrumentation::Snapshot ArrayInstrumentation::snapshot() {
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    Snapshot result = registry.exited;
+    for (auto *thread : registry.threads) {
+        addTo(result, *thread);
+    }
+    return result;
+}
+
+void ArrayInstrumentation::reset() {
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.exited = Snapshot{};
+    for (auto *thread : registry.threads) {
+        for (auto &operation : thread->values) {
+            for (auto &value : operation) {
+                value.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+const char *ArrayInstrumentation::getName(Operation operation) {
+    return OPERATION_NAMES[operation];
+}
+
+std::string ArrayInstrumentation::Snapshot::toString() const {
+    std::string result = "operation                  calls    input bytes   output bytes       elements    nanoseconds    allocations allocated bytes\n";
+    for (size_t i = 0; i < OPERATION_COUNT; i++) {
+        auto &counters = this->operations[i];
+        if (counters.calls == 0) continue;
+        char line[256];
+        snprintf(line, sizeof(line), "%-22s %9llu %14llu %14llu %14llu %14llu %14llu %15llu\n", getName(static_cast<Operation>(i)),
+            static_cast<unsigned long long>(counters.calls), static_cast<unsigned long long>(counters.inputBytes),
+            static_cast<unsigned long long>(counters.outputBytes), static_cast<unsigned long long>(counters.elements),
+            static_cast<unsigned long long>(counters.nanoseconds), static_cast<unsigned long long>(counters.allocations),
+            static_cast<unsigned long long>(counters.allocatedBytes));
+        result += line;
+    }
+    return result;
+}
+
+std::string ArrayInstrumentation::Snapshot::toJson() const {
+    std::string result = std::string("{\"enabled\":") + (isEnabled() ? "true" : "false") + ",\"operations\":{";
+    bool first = true;
+    for (size_t i = 0; i < OPERATION_COUNT; i++) {
+        auto &counters = this->operations[i];
+        if (counters.calls == 0) continue;
+        if (!first) result += ',';
+        first = false;
+        result += '"';
+        result += getName(static_cast<Operation>(i));
+        result += "\":{";
+        appendMember(result, "calls", counters.calls);
+        result += ',';
+        appendMember(result, "inputBytes", counters.inputBytes);
+        result += ',';
+        appendMember(result, "outputBytes", counters.outputBytes);
+        result += ',';
+        appendMember(result, "elements", counters.elements);
+        result += ',';
+        appendMember(result, "nanoseconds", counters.nanoseconds);
+        result += ',';
+        appendMember(result, "allocations", counters.allocations);
+        result += ',';
+        appendMember(result, "allocatedBytes", counters.allocatedBytes);
+        result += '}';
+    }
+    result += "}}";
+    return result;
+}
@@ -0,0 +1,252 @@
+#include "../include/ArrayArithmetic.h"
+#include "../include/ArraySimd.h"
+#include "../include/ArrayThreadPool.h"
+#include <algorithm>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARRAY_GEMM_X86
+#endif
+
+using lingodb::runtime::ArraySimd;
+using lingodb::runtime::ArrayThreadPool;
+using lingodb::runtime::SimdLevel;
+
+namespace {
+
+/*
+ * The integer GEMM follows the usual blocking of BLAS libraries. The inner dimension is split
+ * into blocks of KC and the columns of the result into blocks of NC. The matching block of
+ * `op(B)` is packed once (in strips of NR columns) and stays in the L2/L3 cache, while blocks
+ * of MC rows of `op(A)` are packed (in strips of MR rows) and stay in the L1/L2 cache. The
+ * micro kernel multiplies a strip of `op(A)` with a strip of `op(B)` and keeps the MR x NR
+ * results in registers. All values are packed as sign-extended 64-bit integers and the
+ * results are computed modulo 2^64 (so an overflow wraps around like the other integer
+ * operations).
+ */
+constexpr int MR = 4;
+constexpr int NR = 8;
+constexpr int KC = 256;
+constexpr int MC = 64;
+constexpr int NC = 1024;
+
+// The MR x NR results of a micro kernel (row after row).
+using Tile = uint64_t[MR * NR];
+using MicroKernel = void (*)(int depth, const int64_t *a, const int64_t *b, Tile &tile);
+
+/**
+ * This function multiplies a strip of `op(A)` with a strip of `op(B)` without vector
+ * instructions. The products of sign-extended values are computed modulo 2^64, so unsigned
+ * arithmetic yields the exact (wrapped) signed result.
+ */
+void multiplyTile(int depth, const int64_t *a, const int64_t *b, Tile &tile) {
+    uint64_t sums[MR][NR] = {};
+    for (int p = 0; p < depth; p++, a += MR, b += NR) {
+        for (int i = 0; i < MR; i++) {
+            for (int j = 0; j < NR; j++) {
+                sums[i][j] += static_cast<uint64_t>(a[i]) * static_cast<uint64_t>(b[j]);
+            }
+        }
+    }
+    std::copy(&sums[0][0], &sums[0][0] + MR * NR, tile);
+}
+
+#ifdef ARRAY_GEMM_X86
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+/**
+ * This function multiplies the 64-bit lanes of two registers (modulo 2^64). If both operands
+ * are sign-extended 32-bit integers, a single signed 32-bit multiplication suffices.
+ */
+template<bool NARROW>
+AVX2_TARGET inline __m256i multiplyLanes(__m256i left, __m256i right) {
+    if (NARROW) return _mm256_mul_epi32(left, right);
+    // (2^32 * lh + ll) * (2^32 * rh + rl) = ll * rl + 2^32 * (lh * rl + ll * rh) (mod 2^64)
+    auto low = _mm256_mul_epu32(left, right);
+    auto cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(left, 32), right),
+                                  _mm256_mul_epu32(left, _mm256_srli_epi64(right, 32)));
+    return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+/**
+ * This function multiplies a strip of `op(A)` with a strip of `op(B)` with AVX2 instructions.
+ * Each row of the tile is kept in two registers.
+ *
+ * @tparam NARROW If all values are sign-extended 32-bit integers.
+ */
+template<bool NARROW>
+AVX2_TARGET void multiplyTileAvx2(int depth, const int64_t *a, const int64_t *b, Tile &tile) {
+    __m256i sums[MR][2];
+    for (int i = 0; i < MR; i++) {
+        sums[i][0] = _mm256_setzero_si256();
+        sums[i][1] = _mm256_setzero_si256();
+    }
+    for (int p = 0; p < depth; p++, a += MR, b += NR) {
+        auto right0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        auto right1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 4));
+        for (int i = 0; i < MR; i++) {
+            auto left = _mm256_set1_epi64x(a[i]);
+            sums[i][0] = _mm256_add_epi64(sums[i][0], multiplyLanes<NARROW>(left, right0));
+            sums[i][1] = _mm256_add_epi64(sums[i][1], multiplyLanes<NARROW>(left, right1));
+        }
+    }
+    for (int i = 0; i < MR; i++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(tile + i * NR), sums[i][0]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(tile + i * NR + 4), sums[i][1]);
+    }
+}
+
+#define AVX512_TARGET __attribute__((target("avx512f,avx512dq")))
+
+/**
+ * This function multiplies a strip of `op(A)` with a strip of `op(B)` with AVX-512
+ * instructions. Each row of the tile is kept in a single register.
+ *
+ * @tparam NARROW If all values are sign-extended 32-bit integers.
+ */
+template<bool NARROW>
+AVX512_TARGET void multiplyTileAvx512(int depth, const int64_t *a, const int64_t *b, Tile &tile) {
+    __m512i sums[MR];
+    for (int i = 0; i < MR; i++) sums[i] = _mm512_setzero_si512();
+    for (int p = 0; p < depth; p++, a += MR, b += NR) {
+        auto right = _mm512_loadu_si512(b);
+        for (int i = 0; i < MR; i++) {
+            auto left = _mm512_set1_epi64(a[i]);
+            auto product = NARROW ? _mm512_mul_epi32(left, right) : _mm512_mullo_epi64(left, right);
+            sums[i] = _mm512_add_epi64(sums[i], product);
+        }
+    }
+    for (int i = 0; i < MR; i++) _mm512_storeu_si512(tile + i * NR, sums[i]);
+}
+#endif
+
+/**
+ * This function returns the micro kernel for the current SIMD level (see `ArraySimd`).
+ */
+template<class TYPE>
+MicroKernel getMicroKernel() {
+#ifdef ARRAY_GEMM_X86
+    if (ArraySimd::getLevel() >= SimdLevel::AVX512) {
+        return multiplyTileAvx512<sizeof(TYPE) == sizeof(int32_t)>;
+    }
+    if (ArraySimd::getLevel() >= SimdLevel::AVX2) {
+        return multiplyTileAvx2<sizeof(TYPE) == sizeof(int32_t)>;
+    }
+#endif
+    return multiplyTile;
+}
+
+/**
+ * This struct reads the elements of a (possibly transposed) row-major matrix.
+ */
+template<class TYPE>
+struct MatrixView {
+    const TYPE *values;
+    bool transpose;
+    // The number of columns of the matrix as stored
+    int stride;
+
+    int64_t get(int row, int column) const {
+        return this->transpose ? this->values[static_cast<size_t>(column) * this->stride + row]
+                               : this->values[static_cast<size_t>(row) * this->stride + column];
+    }
+};
+
+/**
+ * This function packs the rows [row, row + rows) and the columns [column, column + columns)
+ * of `op(A)` into strips of MR rows (each column of a strip is contiguous). Missing rows of
+ * the last strip are zero.
+ */
+template<class TYPE>
+void packA(const MatrixView<TYPE> &A, int row, int rows, int column, int columns, int64_t *packed) {
+    for (int strip = 0; strip < rows; strip += MR) {
+        for (int p = 0; p < columns; p++) {
+            for (int i = 0; i < MR; i++) {
+                *packed++ = strip + i < rows ? A.get(row + strip + i, column + p) : 0;
+            }
+        }
+    }
+}
+
+/**
+ * This function packs the rows [row, row + rows) and the columns [column, column + columns)
+ * of `op(B)` into strips of NR columns (each row of a strip is contiguous). Missing columns of
+ * the last strip are zero.
+ */
+template<class TYPE>
+void packB(const MatrixView<TYPE> &B, int row, int rows, int column, int columns, int64_t *packed) {
+    for (int strip = 0; strip < columns; strip += NR) {
+        for (int p = 0; p < rows; p++) {
+            for (int j = 0; j < NR; j++) {
+                *packed++ = strip + j < columns ? B.get(row + p, column + strip + j) : 0;
+            }
+        }
+    }
+}
+
+/**
+ * This function computes `C = alpha * op(A) * op(B) + beta * C` block by block (see `IntegerGemm`).
+ */
+template<class TYPE>
+void multiplyBlocks(const MatrixView<TYPE> &left, const MatrixView<TYPE> &right, int rows, int columns, int inner,
+                    int64_t alpha, int64_t beta, int64_t *C) {
+    auto kernel = getMicroKernel<TYPE>();
+    auto factor = static_cast<uint64_t>(alpha);
+    auto *result = reinterpret_cast<uint64_t*>(C);
+    // The number of blocks of MC rows (the last one may be smaller)
+    int rowBlocks = (rows + MC - 1) / MC;
+
+    std::vector<int64_t> packedB;
+    for (int column = 0; column < columns; column += NC) {
+        int blockColumns = std::min(NC, columns - column);
+        for (int depth = 0; depth < inner; depth += KC) {
+            int blockDepth = std::min(KC, inner - depth);
+            packedB.resize(static_cast<size_t>(blockDepth) * ((blockColumns + NR - 1) / NR * NR));
+            packB(right, depth, blockDepth, column, blockColumns, packedB.data());
+            // The first block of the inner dimension scales the existing values of C
+            bool first = depth == 0;
+
+            // The blocks of rows write disjoint parts of C, so they are split across the threads
+            size_t work = static_cast<size_t>(MC) * blockColumns * blockDepth;
+            ArrayThreadPool::get().parallelForUnits(rowBlocks, work, [&](size_t begin, size_t end) {
+                // The packed rows are reused by every block of the thread
+                thread_local std::vector<int64_t> packedA;
+                packedA.resize(static_cast<size_t>(MC) * KC);
+                for (size_t block = begin; block < end; block++) {
+                    int row = static_cast<int>(block) * MC;
+                    int blockRows = std::min(MC, rows - row);
+                    packA(left, row, blockRows, depth, blockDepth, packedA.data());
+                    for (int j = 0; j < blockColumns; j += NR) {
+                        const int64_t *b = packedB.data() + static_cast<size_t>(j) * blockDepth;
+                        for (int i = 0; i < blockRows; i += MR) {
+                            Tile tile;
+                            kernel(blockDepth, packedA.data() + static_cast<size_t>(i) * blockDepth, b, tile);
+                            for (int ti = 0; ti < std::min(MR, blockRows - i); ti++) {
+                                uint64_t *target = result + static_cast<size_t>(row + i + ti) * columns + column + j;
+                                for (int tj = 0; tj < std::min(NR, blockColumns - j); tj++) {
+                                    auto value = factor * tile[ti * NR + tj];
+                                    if (!first) value += target[tj];
+                                    else if (beta != 0) value += static_cast<uint64_t>(beta) * target[tj];
+                                    target[tj] = value;
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+}
+
+template<class TYPE>
+void lingodb::runtime::IntegerGemm(bool transposeA, bool transposeB, int rows, int columns, int inner, int64_t alpha,
+                                   const TYPE *A, const TYPE *B, int64_t beta, int64_t *C) {
+    MatrixView<TYPE> left{A, transposeA, transposeA ? rows : inner};
+    MatrixView<TYPE> right{B, transposeB, transposeB ? inner : columns};
+    multiplyBlocks(left, right, rows, columns, inner, alpha, beta, C);
+}
+
+template void lingodb::runtime::IntegerGemm<int32_t>(bool, bool, int, int, int, int64_t, const int32_t*, const int32_t*, int64_t, int64_t*);
+template void lingodb::runtime::IntegerGemm<int64_t>(bool, bool, int, int, int, int64_t, const int64_t*, const int64_t*, int64_t, int64_t*);
@@ -7,21 +7,25 @@ const uint8_t* Array::getNulls() {
 }
 
 void Array::copyNulls(char *&buffer, std::vector<bool> &nulls) {
-    // Iterate over each vector element
+    // Collect the bits of eight positions before writing them as a single byte
+    uint8_t byte = 0;
     for (size_t i = 0; i < nulls.size(); i++) {
-        // Check if new byte must be selected
-        if (i != 0 && i % 8 == 0) {
-            buffer += 1;
-        }
+        uint8_t index = i % 8;
         if (nulls[i]) {
-            // If value is true, add true bit 
-            uint8_t index = i % 8;
+            // If value is true, add true bit
             uint8_t shift = 8 - index - 1;
-            *buffer |= (1 << shift);
+            byte |= (1 << shift);
+        }
+        // Write byte if it is complete
+        if (index == 7) {
+            *buffer++ = byte;
+            byte = 0;
         }
     }
-    // Step to the next empty byte
-    buffer += 1;
+    // Write last incomplete byte
+    if (nulls.size() % 8 != 0) {
+        *buffer++ = byte;
+    }
 }
 
 void Array::copyNulls(char *&buffer, const uint8_t *nulls, uint32_t size, uint32_t position) {
@@ -30,72 +34,170 @@ void Array::copyNulls(char *&buffer, const uint8_t *nulls, uint32_t size, uint32
         writeToBuffer(buffer, nulls, getNullBytes(size));
         return;
     }
+    // Keep the bits of previous positions if the buffer points to an incomplete byte
+    uint8_t byte = position % 8 == 0 ? 0 : *buffer & ~(0xFF >> (position % 8));
     // Iterate over each position
     for (uint32_t i = 0; i < size; i++) {
-        // Check if new null byte must be selected
-        if (i != 0 && i % 8 == 0) {
-            nulls++;
-        }
         // Get boolean value from nulls at position i
         uint8_t index = i % 8;
         uint8_t shift = 8 - index - 1;
-        bool isNull = (nulls[0] >> shift) & 1;
+        bool isNull = (nulls[i / 8] >> shift) & 1;
         if (isNull) {
             // If true, push bit to new position
             uint8_t newIndex = position % 8;
             uint8_t newShift = 8 - newIndex - 1;
-            *buffer |= (1 << newShift);
+            byte |= (1 << newShift);
         }
         // Check if new byte in result must be selected
         position++;
         if (position % 8 == 0) {
-            buffer++;
+            *buffer++ = byte;
+            byte = 0;
         }
     }
-    // Step to the next empty byte
+    // Write last incomplete byte
+    if (position % 8 != 0) {
+        *buffer++ = byte;
+    }
+}
+
+void Array::copyNullsWithNewBit(char *&buffer, bool isNull, bool isFront) {
+    uint8_t bit = isNull ? 0x80 : 0;
+    if (isFront) {
+        // Write new bit to the first position and move every other bit by one position
+        *buffer = bit;
+        copyNulls(buffer, this->nulls, this->totalSize, 1);
+        return;
+    }
+    copyNulls(buffer, this->nulls, this->totalSize, 0);
+    // Step one byte back if the last byte has unused bits, otherwise start a new byte
+    uint8_t index = this->totalSize % 8;
+    if (index != 0) {
+        buffer--;
+    } else {
+        *buffer = 0;
+    }
+    *buffer |= bit >> index;
     buffer++;
 }
 
 bool Array::isNull(uint32_t position) {
-    auto size = getSize(true);
-    if (size <= position) {
+    if (this->totalSize <= position) {
         throw std::runtime_error("Array-Element does not exist");
     }
     // Identify null byte
-    uint32_t element = std::floor(position / 8);
+    uint32_t element = position / 8;
     // Identify bit position in that byte
     uint32_t index = position % 8;
     uint32_t shift = 8 - index - 1;
     return 1 & (this->nulls[element] >> shift);
 }
 
+uint64_t Array::getNullWord(uint32_t word) {
+    auto nullBytes = getNullBytes(this->totalSize);
+    uint32_t offset = word * sizeof(uint64_t);
+    uint32_t length = std::min<uint32_t>(sizeof(uint64_t), nullBytes - offset);
+    // Load bytes in big-endian order, so that the first position is the most significant bit
+    uint64_t result = 0;
+    if (length == sizeof(uint64_t)) {
+        memcpy(&result, this->nulls + offset, sizeof(uint64_t));
+        result = __builtin_bswap64(result);
+    } else {
+        for (uint32_t i = 0; i < length; i++) {
+            result |= static_cast<uint64_t>(this->nulls[offset + i]) << (56 - 8 * i);
+        }
+    }
+    // Ignore unused bits behind the last position
+    uint32_t valid = std::min<uint32_t>(64, this->totalSize - word * 64);
+    if (valid < 64) {
+        result &= ~(~0ull >> valid);
+    }
+    return result;
+}
+
+void Array::buildNullIndex() {
+    if (!this->nullRanks.empty() || this->size == this->totalSize) return;
+    uint32_t words = (this->totalSize + 63) / 64;
+    this->nullRanks.resize(words);
+    uint32_t count = 0;
+    // Store the number of NULL values in front of each word
+    for (uint32_t i = 0; i < words; i++) {
+        this->nullRanks[i] = count;
+        count += __builtin_popcountll(getNullWord(i));
+    }
+}
+
 uint32_t Array::countNulls(uint32_t position) {
     // Check if position is valid
-    auto size = getSize(true);
-    if (size <= position) {
+    if (this->totalSize <= position) {
         throw std::runtime_error("Array-Element does not exist");
     }
-    // Iterate over each position until reaching parameter value
-    uint32_t result = 0;
-    for (uint32_t i = 0; i < position; i++) {
-        if (isNull(i)) {
-            result++;
-        }
+    // Without NULL values there is nothing to count
+    if (this->size == this->totalSize) return 0;
+    buildNullIndex();
+    // NULL values in front of the word plus NULL values in front of the position inside the word
+    uint32_t word = position / 64;
+    uint32_t bit = position % 64;
+    uint32_t result = this->nullRanks[word];
+    if (bit != 0) {
+        result += __builtin_popcountll(getNullWord(word) >> (64 - bit));
     }
     return result;
 }
 
+uint32_t Array::getLogicalPosition(uint32_t position) {
+    if (this->size <= position) {
+        throw std::runtime_error("Requested array element does not exist");
+    }
+    if (this->size == this->totalSize) return position;
+    buildNullIndex();
+    // Find the last word whose number of preceding elements does not exceed the position
+    uint32_t low = 0;
+    uint32_t high = this->nullRanks.size();
+    while (high - low > 1) {
+        uint32_t middle = low + (high - low) / 2;
+        if (middle * 64 - this->nullRanks[middle] <= position) low = middle;
+        else high = middle;
+    }
+    // Select the remaining element inside the word (ignoring NULL values)
+    uint32_t remaining = position - (low * 64 - this->nullRanks[low]);
+    uint64_t values = ~getNullWord(low);
+    for (uint32_t i = 0; i < remaining; i++) {
+        values &= ~(1ull << (63 - __builtin_clzll(values)));
+    }
+    return low * 64 + __builtin_clzll(values);
+}
+
 uint32_t Array::getNullBytes(uint32_t size) {
     return std::ceil((double) size / 8);
 }
 
 bool Array::hasNullValue() {
-    // Iterate over each position and check if it is null
-    auto size = getSize(true);
-    for (uint32_t i = 0; i < size; i++) {
-        if (isNull(i)) {
-            return true;
-        }
+    // Every position that does not store an element is a NULL value
+    return this->size != this->totalSize;
+}
+
+uint32_t Array::getCombinedNulls(Array &other, std::vector<uint64_t> &combined) {
+    combined.clear();
+    if (!hasNullValue() && !other.hasNullValue()) {
+        return this->size;
+    }
+    uint32_t words = (this->totalSize + 63) / 64;
+    combined.resize(words);
+    uint32_t nulls = 0;
+    // Combine 64 positions at once
+    for (uint32_t i = 0; i < words; i++) {
+        combined[i] = getNullWord(i) | other.getNullWord(i);
+        nulls += __builtin_popcountll(combined[i]);
     }
-    return false;
-}
\ No newline at end of file
+    return this->totalSize - nulls;
+}
+
+void Array::writeNullWords(char *&buffer, const std::vector<uint64_t> &words, uint32_t totalSize) {
+    auto nullBytes = getNullBytes(totalSize);
+    // Store each word in big-endian order, so that the first position is the most significant bit
+    for (uint32_t i = 0; i < nullBytes; i++) {
+        buffer[i] = static_cast<char>(words[i / 8] >> (56 - 8 * (i % 8)));
+    }
+    buffer += nullBytes;
+}
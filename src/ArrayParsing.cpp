@@ -1,234 +1,289 @@
 #include "../include/Array.h"
-#include <iostream>
+#include "../include/ArraySimd.h"
+#include <strings.h>
 
 using lingodb::runtime::Array;
+using lingodb::runtime::ArraySimd;
+using lingodb::runtime::BFloat16;
+
+namespace {
+
+/**
+ * This function returns whether the characters in `[begin, end)` are only whitespace.
+ */
+bool isBlank(const std::string &source, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        if (!isspace(static_cast<unsigned char>(source[i]))) return false;
+    }
+    return true;
+}
+
+/**
+ * This function returns whether the `length` characters at `begin` spell NULL (in any case).
+ */
+bool isNullToken(const std::string &source, size_t begin, size_t length) {
+    return length == 4 && strncasecmp(source.data() + begin, "null", 4) == 0;
+}
+
+}
 
 lingodb::runtime::VarLen32 Array::fromString(std::string &source, int32_t type) {
     uint8_t typeId = getTypeId(type);
-    uint32_t dimensions = 0;
     std::vector<int32_t> indices;
     std::vector<uint32_t> lengths;
     // How many characters should be ignored (possible header)
     auto start = parseHeader(source, indices, lengths);
-    // If header exists, dimensions can be derived
-    dimensions = indices.size();
+    bool hasHeader = !indices.empty();
 
     if (source.begin() + start == source.end()) {
         throw std::runtime_error("Array-Cast: Invalid array specification");
     }
 
-    uint32_t position = 0;
-    // Stores the dimension in which the elements are stored
-    uint32_t lastDimension = dimensions;
-    // Index to know which metadata entry should be updated
-    uint32_t widthIndex = 0;
-    uint32_t widthOffset = 0;
-    std::vector<std::string> elements;
-    std::vector<uint32_t> stringLengths;
-    std::vector<uint32_t> widthMap;
-    std::vector<uint32_t> widths;
+    // Stage 1: Mark every structural character ('{', '}', ',', '"' and '\')
+    size_t length = source.size() - start;
+    std::vector<uint64_t> masks((length + 63) / 64);
+    auto structuralKernel = ArraySimd::getStructuralKernel();
+    // Chunks start at a multiple of 64 characters, so each chunk fills its own masks
+    static_assert(ArrayThreadPool::CHUNK_SIZE % 64 == 0);
+    ArrayThreadPool::get().parallelFor(length, [&](size_t begin, size_t end) {
+        structuralKernel(source.data() + start + begin, end - begin, masks.data() + begin / 64);
+    });
+
+    // Stage 2: Visit only the marked characters and collect the structure
+    // The widths of each dimension (in order of appearance)
+    std::vector<std::vector<uint32_t>> levels;
+    // The position and length of each non-NULL value
+    std::vector<std::pair<uint32_t, uint32_t>> tokens;
     std::vector<bool> nulls;
-    // Iterate over each character from the given string
-    for(auto symbol = source.begin() + start; symbol != source.end(); symbol++) {
-        switch(*symbol) {
-            // Enter next lower dimension
-            case '{':
-            {
-                // Restrict possiblity of infinite number of empty arrays
-                if (lastDimension != 0 && lastDimension < position+1) {
-                    throw std::runtime_error("Array-Cast: Invalid structure, elements are not in lowest dimension");
+    // The current depth (0 = outside of the array)
+    uint32_t depth = 0;
+    // Stores the dimension in which the elements are stored
+    uint32_t lastDimension = 0;
+    // The last of '{', '}' and ',' outside of a quoted value (0 = none)
+    char previous = 0;
+    // The first character after the last '{' or ','
+    size_t tokenStart = start;
+    // The quoted value of the current element (if present)
+    bool inString = false;
+    bool quoted = false;
+    size_t quoteBegin = 0;
+    size_t quoteEnd = 0;
+    // The position of the character following a '\' (it is never structural)
+    size_t escaped = std::string::npos;
+    bool closed = false;
+
+    // Adds an element at the current depth and updates the width of its array
+    auto addElement = [&](bool isNull, size_t begin, size_t count) {
+        if (lastDimension == 0) {
+            lastDimension = depth;
+        }
+        if (lastDimension != depth || depth < levels.size()) {
+            if (isNull) {
+                throw std::runtime_error("Array-Cast: NULL can only be used for primitive elements");
+            }
+            throw std::runtime_error("Array-Cast: Inconsistent dimensions - found elements in different dimensions");
+        }
+        auto &width = levels[depth - 1].back();
+        width++;
+        // Check if the element is inside the defined bounds (Only if header is defined)
+        if (depth <= lengths.size() && width > lengths[depth - 1]) {
+            throw std::runtime_error("Array-Cast: Invalid structure, array object is out of bounds");
+        }
+        nulls.push_back(isNull);
+        if (!isNull) {
+            tokens.emplace_back(begin, count);
+        }
+    };
+
+    for (size_t block = 0; block < masks.size(); block++) {
+        uint64_t mask = masks[block];
+        while (mask != 0) {
+            size_t position = start + block * 64 + __builtin_ctzll(mask);
+            mask &= mask - 1;
+            if (position == escaped) continue;
+            char symbol = source[position];
+            // Inside of a quoted value only the closing '"' is relevant
+            if (inString) {
+                if (symbol == '\\') {
+                    escaped = position + 1;
+                } else if (symbol == '"') {
+                    inString = false;
+                    quoteEnd = position;
+                    tokenStart = position + 1;
                 }
-                // If not in first dimension, update width of upper dimension
-                if (widths.size() != 0) {
-                    widths[widthIndex] += 1;
-                    // Check if new structure is inside defined bounds (Only if header is defined)
-                    if (lengths.size() != 0) {
-                        if (widths[widthIndex] > lengths[position-1]) {
+                continue;
+            }
+            if (closed) {
+                throw std::runtime_error("Array-Cast: Invalid array specification");
+            }
+            switch (symbol) {
+                // Enter next lower dimension
+                case '{':
+                {
+                    if (!isBlank(source, tokenStart, position) || quoted || previous == '}') {
+                        if (depth == 0) throw std::runtime_error("Array-Cast: Invalid array specification");
+                        throw std::runtime_error("Array-Cast: Syntax error");
+                    }
+                    // Restrict possiblity of infinite number of empty arrays
+                    if (lastDimension != 0 && lastDimension < depth + 1) {
+                        throw std::runtime_error("Array-Cast: Invalid structure, elements are not in lowest dimension");
+                    }
+                    // If not in first dimension, update width of upper dimension
+                    if (depth != 0) {
+                        auto &width = levels[depth - 1].back();
+                        width++;
+                        // Check if new structure is inside defined bounds (Only if header is defined)
+                        if (depth <= lengths.size() && width > lengths[depth - 1]) {
                             throw std::runtime_error("Array-Cast: Invalid structure, array object is out of bounds");
                         }
                     }
-                }
-                // Determine the position to add a new width
-                auto insertPosition = widths.begin();
-                for (size_t i = 0; i < widthMap.size(); i++) {
-                    if (i > position) break;
-                    insertPosition += widthMap[i];
-                }
-                position++;
-                // Add new width entry
-                insertPosition = widths.insert(insertPosition, 0);
-                widthIndex = insertPosition - widths.begin();
-                // Add new widthMap information if completely new dimension has been discovered
-                if (position > widthMap.size()) {
-                    widthMap.push_back(1);
-                // Otherwise increase value of already existing one
-                } else {
-                    widthMap[position - 1] += 1;
-                }
-                // Add start index if not already defined in a header
-                if (position > indices.size()) {
-                    indices.push_back(1);
-                }
-                // Update absolute number of dimensions
-                dimensions = std::max(dimensions, position);
-                widthOffset = nulls.size();
-                break;
-            }
-            // Enter previous upper dimension
-            case '}':
-            {
-                // Update width entry only of last dimension
-                if (lastDimension == position) {
-                    widths[widthIndex] = nulls.size() - widthOffset;
-                    // Check if new structure is inside defined bounds (Only if header is defined)
-                    if (lengths.size() != 0) {
-                        if (widths[widthIndex] > lengths[position-1]) {
-                            throw std::runtime_error("Array-Cast: Invalid structure, array object is out of bounds"); 
-                        }
+                    depth++;
+                    // Add a new width entry (and a new dimension if it has not been discovered yet)
+                    if (depth > levels.size()) {
+                        levels.emplace_back();
                     }
+                    levels[depth - 1].push_back(0);
+                    previous = '{';
+                    tokenStart = position + 1;
+                    break;
                 }
-                position--;
-                // Determine the index of the last width entry that corresponds to the upper dimension
-                auto modifyPosition = widths.begin();
-                for (size_t i = 0; i < widthMap.size(); i++) {
-                    if (i == position) break;
-                    modifyPosition += widthMap[i];
-                }
-                if (modifyPosition != widths.begin()) {
-                    modifyPosition--;
-                    widthIndex = modifyPosition - widths.begin();
-                }
-                break;
-            }
-            // Only check if syntax is correct
-            case ',':
-            {
-                while(symbol < source.end() && isspace(*(symbol + 1))) {
-                    symbol++;
-                }
-                if (symbol + 1 < source.end() && (*(symbol + 1) == ',' || *(symbol + 1) == '}')) {
-                    throw std::runtime_error("Array-Cast: Syntax error");
-                }
-                break;
-            }
-            // Check if NULL value has been discovered
-            case 'n':
-            case 'N':
-            {
-                if (symbol + 4 < source.end()) {
-                    char possibleU = *(symbol + 1);
-                    char possibleL1 = *(symbol + 2);
-                    char possibleL2 = *(symbol + 3);
-                    if ((possibleU == 'u' || possibleU == 'U') && (possibleL1 == 'l' || possibleL1 == 'L') && (possibleL2 == 'l' || possibleL2 == 'L')) {
-                        if (lastDimension == 0) {
-                            lastDimension = position;
+                // Finish the current element
+                case '}':
+                case ',':
+                {
+                    if (depth == 0) {
+                        throw std::runtime_error("Array-Cast: Invalid array specification");
+                    }
+                    if (quoted) {
+                        if (!isBlank(source, tokenStart, position)) {
+                            throw std::runtime_error("Array-Cast: Syntax error");
                         }
-                        if (lastDimension != position) {
-                            throw std::runtime_error("Array-Cast: NULL can only be used for primitive elements");
+                        addElement(false, quoteBegin, quoteEnd - quoteBegin);
+                    } else {
+                        // Remove surrounding whitespace of unquoted values
+                        size_t begin = tokenStart;
+                        size_t end = position;
+                        while (begin < end && isspace(static_cast<unsigned char>(source[begin]))) begin++;
+                        while (end > begin && isspace(static_cast<unsigned char>(source[end - 1]))) end--;
+                        if (begin != end) {
+                            if (previous == '}') {
+                                throw std::runtime_error("Array-Cast: Syntax error");
+                            }
+                            addElement(isNullToken(source, begin, end - begin), begin, end - begin);
+                        // Only an empty array or a nested array may have no value
+                        } else if (!(previous == '}' || (previous == '{' && symbol == '}'))) {
+                            throw std::runtime_error("Array-Cast: Syntax error");
                         }
-                        symbol += 3;
-                        nulls.push_back(true);
                     }
-                }
-                break;
-            }
-            // Ignore these special characters
-            case ' ':
-            case '\\':
-            case '\t':
-            case '\n':
-            case '\r':
-                break;
-            // Default = New array element discovered
-            default:
-            {
-                // Check if no other characters are defined outside the array
-                if (position == 0) {
-                    throw std::runtime_error("Array-Cast: Invalid array specification");
-                }
-                // Check if all elements are at the same dimension level
-                if (lastDimension != 0 && lastDimension != position) {
-                    throw std::runtime_error("Array-Cast: Inconsistent dimensions - found elements in different dimensions");
-                }
-                lastDimension = position;
-                // Jump over " if present
-                auto end = symbol;
-                if (*symbol == '"') {
-                    symbol++;
-                    end++;
-                }
-                // Find end of array element
-                while (end < source.end()) {
-                    if (*end == '"' && *(end - 1) != '\\') {
-                        break;
-                    }
-                    if (*end == ',' && *(end - 1) != '\\') {
-                        break;
+                    quoted = false;
+                    previous = symbol;
+                    tokenStart = position + 1;
+                    if (symbol == '}') {
+                        depth--;
+                        closed = depth == 0;
                     }
-                    if (*end == '}' && *(end - 1) != '\\') {
-                        break;
+                    break;
+                }
+                // Start of a quoted value
+                case '"':
+                {
+                    if (depth == 0 || quoted || previous == '}' || !isBlank(source, tokenStart, position)) {
+                        throw std::runtime_error(depth == 0 ? "Array-Cast: Invalid array specification" : "Array-Cast: Syntax error");
                     }
-                    end++;
+                    inString = true;
+                    quoted = true;
+                    quoteBegin = position + 1;
+                    break;
                 }
-                // Add discovered element
-                elements.push_back(std::string(symbol, end));
-                // If type is STRING, also store the elements length
-                if (type == ArrayType::STRING) {
-                    stringLengths.push_back(end - symbol);
-                    symbol = end;
-                } else {
-                    symbol = end - 1;
+                // The next character is part of an unquoted value
+                default:
+                {
+                    if (depth == 0) {
+                        throw std::runtime_error("Array-Cast: Invalid array specification");
+                    }
+                    escaped = position + 1;
+                    break;
                 }
-                nulls.push_back(false);
-                break;
             }
         }
     }
+    if (inString || depth != 0) {
+        throw std::runtime_error("Array-Cast: Syntax error");
+    }
+    // Check if no other characters are defined outside the array
+    if (!closed || !isBlank(source, tokenStart, source.size())) {
+        throw std::runtime_error("Array-Cast: Invalid array specification");
+    }
+    uint32_t dimensions = levels.size();
+    if (hasHeader && indices.size() != dimensions) {
+        throw std::runtime_error("Array-Cast: Invalid array header");
+    }
+    // Add start indices if not defined in a header
+    indices.resize(dimensions, 1);
+
+    uint32_t widthSize = 0;
+    for (auto &level : levels) {
+        widthSize += level.size();
+    }
     // Get total size of all string values (if type is STRING)
     size_t totalStringSize = 0;
-    for (auto &length : stringLengths) {
-        totalStringSize += length;
+    if (typeId == ArrayType::STRING) {
+        for (auto &token : tokens) {
+            totalStringSize += token.second;
+        }
     }
-    std::string result;
     // Set new size of target string
-    auto size = getStringSize(dimensions, elements.size(), widths.size(), getNullBytes(nulls.size()), totalStringSize, typeId);
-    result.resize(size);
-    char *buffer = result.data();
-    
-    // Now copy each information into the target string
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.size());
-    writeToBuffer(buffer, &typeId, 1);
-    writeToBuffer(buffer, &dimensions, 1);
-    uint32_t elementSize = elements.size();
-    writeToBuffer(buffer, &elementSize, 1);
+    auto size = getStringSize(dimensions, tokens.size(), widthSize, getNullBytes(nulls.size()), totalStringSize, typeId);
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
+
+    // Now copy each information directly into the target string
+    writeHeader(buffer, typeId, dimensions, tokens.size(), nulls.size(), widthSize, totalStringSize);
     writeToBuffer(buffer, indices.data(), indices.size());
-    writeToBuffer(buffer, widthMap.data(), widthMap.size());
-    writeToBuffer(buffer, widths.data(), widths.size());
+    for (auto &level : levels) {
+        uint32_t levelSize = level.size();
+        writeToBuffer(buffer, &levelSize, 1);
+    }
+    for (auto &level : levels) {
+        writeToBuffer(buffer, level.data(), level.size());
+    }
+    writePadding(buffer, dimensions, widthSize);
 
     if (typeId == ArrayType::STRING) {
-        writeToBuffer(buffer, stringLengths.data(), stringLengths.size());
+        for (auto &token : tokens) {
+            writeToBuffer(buffer, &token.second, 1);
+        }
     } else {
-        for (auto &element : elements) {
-            if (typeId == ArrayType::INTEGER32) {
-                castAndCopyElement<int32_t>(buffer, element);
-            } else if (typeId == ArrayType::INTEGER64) {
-                castAndCopyElement<int64_t>(buffer, element);
-            } else if (typeId == ArrayType::FLOAT) {
-                castAndCopyElement<float>(buffer, element);
-            } else {
-                castAndCopyElement<double>(buffer, element);
+        // Every value has a fixed position, so the values can be converted in independent chunks
+        auto typeSize = getTypeSize(typeId);
+        ArrayThreadPool::get().parallelFor(tokens.size(), [&](size_t begin, size_t end) {
+            char *target = buffer + begin * typeSize;
+            for (size_t i = begin; i < end; i++) {
+                std::string_view element(source.data() + tokens[i].first, tokens[i].second);
+                if (typeId == ArrayType::INTEGER32) {
+                    castAndCopyElement<int32_t>(target, element);
+                } else if (typeId == ArrayType::INTEGER64) {
+                    castAndCopyElement<int64_t>(target, element);
+                } else if (typeId == ArrayType::BFLOAT) {
+                    castAndCopyElement<BFloat16>(target, element);
+                } else if (typeId == ArrayType::FLOAT) {
+                    castAndCopyElement<float>(target, element);
+                } else {
+                    castAndCopyElement<double>(target, element);
+                }
             }
-        }
+        });
+        buffer += typeSize * tokens.size();
     }
 
     copyNulls(buffer, nulls);
 
     if (typeId == ArrayType::STRING) {
-        for (auto &element : elements) {
-            writeToBuffer(buffer, element.data(), element.length());
+        for (auto &token : tokens) {
+            writeToBuffer(buffer, source.data() + token.first, token.second);
         }
     }
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 uint32_t Array::parseHeader(std::string &array, std::vector<int32_t> &indices, std::vector<uint32_t> &lengths) {
@@ -3,77 +3,120 @@
 using lingodb::runtime::Array;
 
 std::string Array::print() {
-    std::string result = "";
-    printHeader(result);
-    printArray(result, this->widths, 1);
+    std::string result;
+    result.reserve(estimatePrintSize());
+    StringPrintSink sink(result);
+    print(sink);
     return result;
 }
 
-void Array::printArray(std::string &target, const uint32_t *width, uint32_t dimension) {
+void Array::print(PrintSink &sink) {
+    printHeader(sink);
+    PrintCursor cursor;
+    cursor.position = 0;
+    cursor.element = 0;
+    cursor.stringOffset = 0;
+    cursor.formattedOffset = 0;
+    // Formatting dominates the printing of numbers, so it is done ahead for large arrays
+    if (this->type != ArrayType::STRING && ArrayThreadPool::get().isParallel(this->size)) {
+        switch (this->type) {
+        case ArrayType::INTEGER32:
+            formatElements<int32_t>(cursor);
+            break;
+        case ArrayType::INTEGER64:
+            formatElements<int64_t>(cursor);
+            break;
+        case ArrayType::BFLOAT:
+            formatElements<BFloat16>(cursor);
+            break;
+        case ArrayType::FLOAT:
+            formatElements<float>(cursor);
+            break;
+        case ArrayType::DOUBLE:
+            formatElements<double>(cursor);
+            break;
+        }
+    }
+    cursor.widths.reserve(this->dimensions);
+    for (uint32_t i = 0; i < this->dimensions; i++) {
+        cursor.widths.push_back(getFirstWidth(i + 1));
+    }
+    printArray(sink, cursor, 1);
+    sink.flush();
+}
+
+void Array::printArray(PrintSink &sink, PrintCursor &cursor, uint32_t dimension) {
+    // The subarrays of each dimension are stored in the order in which they are printed
+    uint32_t width = *cursor.widths[dimension - 1]++;
+    sink.append('{');
     // Check if last dimension is reached
     if (dimension == this->dimensions) {
-        target.append("{");
-        uint32_t offset = getOffset(width);
-        // Iterate over each element
-        for (uint32_t i = offset; i < offset + width[0]; i++) {
-            // Check if it is null
-            if (isNull(i)) {
-                target.append("null");
-            } else {
-                // Add the value to the result string
-                switch (this->type) 
-                {
-                case ArrayType::INTEGER32:
-                    toString<int32_t>(getElementPosition(i), target);
-                    break;
-                case ArrayType::INTEGER64:
-                    toString<int64_t>(getElementPosition(i), target);
-                    break;
-                case ArrayType::FLOAT:
-                    toString<float>(getElementPosition(i), target);
-                    break;
-                case ArrayType::DOUBLE:
-                    toString<double>(getElementPosition(i), target);
-                    break;
-                case ArrayType::STRING:
-                    toString<std::string>(getElementPosition(i), target);
-                    break;
-                default:
-                    throw std::runtime_error("Print-Operation: Given array type is not supported");
-                }
-            }
-            // If not last element, add a comma
-            if (i + 1 != offset + width[0]) target.append(",");
+        switch (this->type) 
+        {
+        case ArrayType::INTEGER32:
+            printElements<int32_t>(sink, cursor, width);
+            break;
+        case ArrayType::INTEGER64:
+            printElements<int64_t>(sink, cursor, width);
+            break;
+        case ArrayType::BFLOAT:
+            printElements<BFloat16>(sink, cursor, width);
+            break;
+        case ArrayType::FLOAT:
+            printElements<float>(sink, cursor, width);
+            break;
+        case ArrayType::DOUBLE:
+            printElements<double>(sink, cursor, width);
+            break;
+        case ArrayType::STRING:
+            printElements<std::string>(sink, cursor, width);
+            break;
+        default:
+            throw std::runtime_error("Print-Operation: Given array type is not supported");
+        }
+    } else {
+        // Iterate over each subarray belonging to the caller structure.
+        for (uint32_t i = 0; i < width; i++) {
+            // If not first element, add a comma
+            if (i != 0) sink.append(',');
+            printArray(sink, cursor, dimension + 1);
         }
-        target.append("}");
-        return;
     }
-    // Get a pointer to the first width entry which belongs to the next lower dimension
-    auto *entries = getChildWidth(width, dimension);
-    target.append("{");
-    // Iterate over each width entry belonging to the caller structure.
-    for (uint32_t i = 0; i < width[0]; i++) {
-        // Call function with its children
-        printArray(target, entries + i, dimension + 1);
-        // If not last element, add a comma
-        if (i+1 != width[0]) target.append(",");        
+    sink.append('}');
+}
+
+size_t Array::estimatePrintSize() {
+    // Braces and commas of every subarray
+    size_t result = 3 * static_cast<size_t>(getWidthSize());
+    // A comma after each element
+    result += this->totalSize;
+    // Four characters per NULL value ("null"), at least a digit per element
+    result += 4 * static_cast<size_t>(this->totalSize - this->size);
+    if (this->type == ArrayType::STRING) {
+        result += this->stringSize + 2 * static_cast<size_t>(this->size);
+    } else {
+        result += this->size;
     }
-    target.append("}");
+    return result;
 }
 
-void Array::printHeader(std::string &target) {
+void Array::printHeader(PrintSink &sink) {
     // Check if header must be printed
     auto print = false;
     for (uint32_t i = 0; i < this->dimensions; i++) {
         if (this->indices[i] != 1) print = true;
     }
     if (print) {
-        // Iterate over each index and add lower and upper bound to result string
+        char digits[MAX_ELEMENT_CHARS];
+        // Iterate over each index and add lower and upper bound to the sink
         for (uint32_t i = 0; i < this->dimensions; i++) {
             auto length = getDimensionSize(i+1);
-            auto expr = "[" + std::to_string(this->indices[i]) + ":" + std::to_string(this->indices[i] + (int32_t) length - 1) + "]";
-            target.append(expr);
+            sink.append('[');
+            sink.append(digits, formatElement(digits, this->indices[i]));
+            sink.append(':');
+            sink.append(digits, formatElement(digits, this->indices[i] + (int32_t) length - 1));
+            sink.append(']');
         }
-        target.append("=");
+        sink.append('=');
     }
-}
\ No newline at end of file
+}
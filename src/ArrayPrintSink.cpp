@@ -0,0 +1,36 @@
+#include "../include/ArrayPrintSink.h"
+#include <cerrno>
+#include <stdexcept>
+#include <unistd.h>
+#include <utility>
+
+using lingodb::runtime::StringPrintSink;
+using lingodb::runtime::FilePrintSink;
+using lingodb::runtime::CallbackPrintSink;
+
+StringPrintSink::StringPrintSink(std::string &target) : target(target) {}
+
+void StringPrintSink::write(const char *data, size_t size) {
+    this->target.append(data, size);
+}
+
+FilePrintSink::FilePrintSink(int descriptor) : descriptor(descriptor) {}
+
+void FilePrintSink::write(const char *data, size_t size) {
+    // A single call may write less than requested
+    while (size > 0) {
+        auto written = ::write(this->descriptor, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Print-Operation: Output could not be written");
+        }
+        data += written;
+        size -= written;
+    }
+}
+
+CallbackPrintSink::CallbackPrintSink(Callback callback) : callback(std::move(callback)) {}
+
+void CallbackPrintSink::write(const char *data, size_t size) {
+    this->callback(data, size);
+}
@@ -0,0 +1,145 @@
+#include "../include/Array.h"
+
+using lingodb::runtime::Array;
+using lingodb::runtime::ReductionOperator;
+
+template<bool HIGHEST>
+int32_t Array::getExtremePosition() {
+    if (this->size == 0) return 0;
+    switch (this->type) {
+    case ArrayType::INTEGER32:
+        return getExtremePosition<int32_t, HIGHEST>();
+    case ArrayType::INTEGER64:
+        return getExtremePosition<int64_t, HIGHEST>();
+    case ArrayType::BFLOAT:
+        return getExtremePosition<BFloat16, HIGHEST>();
+    case ArrayType::FLOAT:
+        return getExtremePosition<float, HIGHEST>();
+    case ArrayType::DOUBLE:
+        return getExtremePosition<double, HIGHEST>();
+    case ArrayType::STRING:
+        return getExtremePosition<uint32_t, HIGHEST>();
+    default:
+        if (HIGHEST) throw std::runtime_error("Array-HighestPosition: Given array type is not supported in arrays");
+        throw std::runtime_error("Array-LowestPosition: Given array type is not supported in arrays");
+    }
+}
+
+template<class TYPE>
+double Array::executeReduction(ReductionOperator op) {
+    auto kernel = ArraySimd::getReductionKernel<TYPE>(op);
+    auto *values = reinterpret_cast<const TYPE*>(this->elements);
+    if (this->size <= ArrayThreadPool::CHUNK_SIZE) {
+        return kernel(values, this->size);
+    }
+
+    // The chunks only depend on the number of values (not on the number of threads or the
+    // threshold), so floating point results are the same with and without parallelism
+    constexpr size_t chunkSize = ArrayThreadPool::CHUNK_SIZE;
+    std::vector<double> partials((this->size + chunkSize - 1) / chunkSize);
+    ArrayThreadPool::get().parallelFor(this->size, [&](size_t begin, size_t end) {
+        for (size_t position = begin; position < end; position += chunkSize) {
+            partials[position / chunkSize] = kernel(values + position, std::min(chunkSize, end - position));
+        }
+    });
+    double result = partials[0];
+    for (size_t i = 1; i < partials.size(); i++) {
+        switch (op) {
+        case ReductionOperator::PRODUCT:
+            result *= partials[i];
+            break;
+        case ReductionOperator::MIN:
+            result = std::min(result, partials[i]);
+            break;
+        case ReductionOperator::MAX:
+            result = std::max(result, partials[i]);
+            break;
+        default:
+            result += partials[i];
+        }
+    }
+    return result;
+}
+
+double Array::executeReduction(ReductionOperator op) {
+    switch (this->type) {
+    case ArrayType::INTEGER32:
+        return executeReduction<int32_t>(op);
+    case ArrayType::INTEGER64:
+        return executeReduction<int64_t>(op);
+    case ArrayType::BFLOAT:
+        return executeReduction<BFloat16>(op);
+    case ArrayType::FLOAT:
+        return executeReduction<float>(op);
+    case ArrayType::DOUBLE:
+        return executeReduction<double>(op);
+    default:
+        throw std::runtime_error("Array-Type is not supported");
+    }
+}
+
+int32_t Array::getHighestPosition() {
+    return getExtremePosition<true>();
+}
+
+int32_t Array::getLowestPosition() {
+    return getExtremePosition<false>();
+}
+
+double Array::sum() {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-Sum: Given element type is not numeric");
+    }
+    return executeReduction(ReductionOperator::SUM);
+}
+
+double Array::product() {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-Product: Given element type is not numeric");
+    }
+    return executeReduction(ReductionOperator::PRODUCT);
+}
+
+double Array::minimum() {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-Min: Given element type is not numeric");
+    }
+    if (this->size == 0) {
+        throw std::runtime_error("Array-Min: Array does not contain any values");
+    }
+    return executeReduction(ReductionOperator::MIN);
+}
+
+double Array::maximum() {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-Max: Given element type is not numeric");
+    }
+    if (this->size == 0) {
+        throw std::runtime_error("Array-Max: Array does not contain any values");
+    }
+    return executeReduction(ReductionOperator::MAX);
+}
+
+double Array::mean() {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-Mean: Given element type is not numeric");
+    }
+    if (this->size == 0) {
+        throw std::runtime_error("Array-Mean: Array does not contain any values");
+    }
+    return executeReduction(ReductionOperator::SUM) / this->size;
+}
+
+double Array::l1Norm() {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-L1Norm: Given element type is not numeric");
+    }
+    return executeReduction(ReductionOperator::ABSOLUTE_SUM);
+}
+
+double Array::l2Norm() {
+    if (!isNumericType(this->type)) {
+        throw std::runtime_error("Array-L2Norm: Given element type is not numeric");
+    }
+    return std::sqrt(executeReduction(ReductionOperator::SQUARED_SUM));
+}
@@ -1,10 +1,14 @@
 #include "../include/ArrayRuntime.h"
+#include "../include/ArrayInstrumentation.h"
 
 using lingodb::runtime::ArrayRuntime;
 
 lingodb::runtime::VarLen32 ArrayRuntime::fromString(lingodb::runtime::VarLen32 str, int32_t type) {
+    ARRAY_MEASURE(FROM_STRING);
     std::string content = str.str();
-    return lingodb::runtime::Array::fromString(content, type);
+    auto result = lingodb::runtime::Array::fromString(content, type);
+    ARRAY_MEASURE_LITERAL(str, result, type);
+    return ARRAY_MEASURE_OUTPUT(result);
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::append(
@@ -12,65 +16,74 @@ lingodb::runtime::VarLen32 ArrayRuntime::append(
     lingodb::runtime::VarLen32 right,
     int32_t leftType,
     int32_t rightType) {
-        std::string leftVal = left.str();
-        std::string rightVal = right.str();
-        Array leftArray(leftVal, leftType);
-        Array rightArray(rightVal, rightType);
-        return leftArray.append(rightArray);
+        ARRAY_MEASURE(APPEND);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray.append(rightArray));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::append(lingodb::runtime::VarLen32 array, int32_t type, int32_t value, bool isFront) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    if (isFront) return arrayObj.appendFront(value);
-    else return arrayObj.append(value);
+    ARRAY_MEASURE(APPEND);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    if (isFront) return ARRAY_MEASURE_OUTPUT(arrayObj.appendFront(value));
+    else return ARRAY_MEASURE_OUTPUT(arrayObj.append(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::append(lingodb::runtime::VarLen32 array, int32_t type, int64_t value, bool isFront) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    if (isFront) return arrayObj.appendFront(value);
-    else return arrayObj.append(value);
+    ARRAY_MEASURE(APPEND);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    if (isFront) return ARRAY_MEASURE_OUTPUT(arrayObj.appendFront(value));
+    else return ARRAY_MEASURE_OUTPUT(arrayObj.append(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::append(lingodb::runtime::VarLen32 array, int32_t type, float value, bool isFront) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    if (isFront) return arrayObj.appendFront(value);
-    else return arrayObj.append(value);
+    ARRAY_MEASURE(APPEND);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    if (isFront) return ARRAY_MEASURE_OUTPUT(arrayObj.appendFront(value));
+    else return ARRAY_MEASURE_OUTPUT(arrayObj.append(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::append(lingodb::runtime::VarLen32 array, int32_t type, double value, bool isFront) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    if (isFront) return arrayObj.appendFront(value);
-    else return arrayObj.append(value);
+    ARRAY_MEASURE(APPEND);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    if (isFront) return ARRAY_MEASURE_OUTPUT(arrayObj.appendFront(value));
+    else return ARRAY_MEASURE_OUTPUT(arrayObj.append(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::append(lingodb::runtime::VarLen32 array, int32_t type, VarLen32 value, bool isFront) {
-    std::string arrayVal = array.str();
+    ARRAY_MEASURE(APPEND);
     std::string valueVal = value.str();
-    Array arrayObj(arrayVal, type);
-    if (isFront) return arrayObj.appendFront(valueVal);
-    else return arrayObj.append(valueVal);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    if (isFront) return ARRAY_MEASURE_OUTPUT(arrayObj.appendFront(valueVal));
+    else return ARRAY_MEASURE_OUTPUT(arrayObj.append(valueVal));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::append(lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.append();
+    ARRAY_MEASURE(APPEND);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.append());
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::slice(lingodb::runtime::VarLen32 array, int32_t type, int32_t lowerBound, int32_t upperBound, int32_t dimension) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.slice(lowerBound, upperBound, dimension);
+    ARRAY_MEASURE(SLICE);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.slice(lowerBound, upperBound, dimension));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::subscript(lingodb::runtime::VarLen32 array, int32_t type, int32_t position) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj[position];
+    ARRAY_MEASURE(SUBSCRIPT);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj[position]);
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::add(
@@ -78,11 +91,12 @@ lingodb::runtime::VarLen32 ArrayRuntime::add(
     lingodb::runtime::VarLen32 right,
     int32_t leftType,
     int32_t rightType) {
-        std::string leftVal = left.str();
-        std::string rightVal = right.str();
-        Array leftArray(leftVal, leftType);
-        Array rightArray(rightVal, rightType);
-        return leftArray + rightArray;
+        ARRAY_MEASURE(ADD);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray + rightArray);
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::sub(
@@ -90,11 +104,12 @@ lingodb::runtime::VarLen32 ArrayRuntime::sub(
     lingodb::runtime::VarLen32 right,
     int32_t leftType,
     int32_t rightType) {
-        std::string leftVal = left.str();
-        std::string rightVal = right.str();
-        Array leftArray(leftVal, leftType);
-        Array rightArray(rightVal, rightType);
-        return leftArray - rightArray;
+        ARRAY_MEASURE(SUB);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray - rightArray);
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::mul(
@@ -102,11 +117,12 @@ lingodb::runtime::VarLen32 ArrayRuntime::mul(
     lingodb::runtime::VarLen32 right,
     int32_t leftType,
     int32_t rightType) {
-        std::string leftVal = left.str();
-        std::string rightVal = right.str();
-        Array leftArray(leftVal, leftType);
-        Array rightArray(rightVal, rightType);
-        return leftArray * rightArray;
+        ARRAY_MEASURE(MUL);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray * rightArray);
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::div(
@@ -114,156 +130,189 @@ lingodb::runtime::VarLen32 ArrayRuntime::div(
     lingodb::runtime::VarLen32 right,
     int32_t leftType,
     int32_t rightType) {
-        std::string leftVal = left.str();
-        std::string rightVal = right.str();
-        Array leftArray(leftVal, leftType);
-        Array rightArray(rightVal, rightType);
-        return leftArray / rightArray;
+        ARRAY_MEASURE(DIV);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray / rightArray);
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarAdd(lingodb::runtime::VarLen32 array, int32_t type, int32_t value) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarAdd(value);
+    ARRAY_MEASURE(SCALAR_ADD);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarAdd(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarAdd(lingodb::runtime::VarLen32 array, int32_t type, int64_t value) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarAdd(value);
+    ARRAY_MEASURE(SCALAR_ADD);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarAdd(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarAdd(lingodb::runtime::VarLen32 array, int32_t type, float value) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarAdd(value);
+    ARRAY_MEASURE(SCALAR_ADD);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarAdd(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarAdd(lingodb::runtime::VarLen32 array, int32_t type, double value) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarAdd(value);
+    ARRAY_MEASURE(SCALAR_ADD);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarAdd(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarSub(lingodb::runtime::VarLen32 array, int32_t type, int32_t value, bool isleft) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarSub(value, isleft);
+    ARRAY_MEASURE(SCALAR_SUB);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarSub(value, isleft));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarSub(lingodb::runtime::VarLen32 array, int32_t type, int64_t value, bool isleft) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarSub(value, isleft);
+    ARRAY_MEASURE(SCALAR_SUB);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarSub(value, isleft));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarSub(lingodb::runtime::VarLen32 array, int32_t type, float value, bool isleft) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarSub(value, isleft);
+    ARRAY_MEASURE(SCALAR_SUB);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarSub(value, isleft));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarSub(lingodb::runtime::VarLen32 array, int32_t type, double value, bool isleft) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarSub(value, isleft);
+    ARRAY_MEASURE(SCALAR_SUB);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarSub(value, isleft));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarMul(lingodb::runtime::VarLen32 array, int32_t type, int32_t value) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarMul(value);
+    ARRAY_MEASURE(SCALAR_MUL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarMul(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarMul(lingodb::runtime::VarLen32 array, int32_t type, int64_t value) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarMul(value);
+    ARRAY_MEASURE(SCALAR_MUL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarMul(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarMul(lingodb::runtime::VarLen32 array, int32_t type, float value) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarMul(value);
+    ARRAY_MEASURE(SCALAR_MUL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarMul(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarMul(lingodb::runtime::VarLen32 array, int32_t type, double value) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarMul(value);
+    ARRAY_MEASURE(SCALAR_MUL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarMul(value));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarDiv(lingodb::runtime::VarLen32 array, int32_t type, int32_t value, bool isleft) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarDiv(value, isleft);
+    ARRAY_MEASURE(SCALAR_DIV);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarDiv(value, isleft));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarDiv(lingodb::runtime::VarLen32 array, int32_t type, int64_t value, bool isleft) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarDiv(value, isleft);
+    ARRAY_MEASURE(SCALAR_DIV);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarDiv(value, isleft));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarDiv(lingodb::runtime::VarLen32 array, int32_t type, float value, bool isleft) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarDiv(value, isleft);
+    ARRAY_MEASURE(SCALAR_DIV);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarDiv(value, isleft));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::scalarDiv(lingodb::runtime::VarLen32 array, int32_t type, double value, bool isleft) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.scalarDiv(value, isleft);
+    ARRAY_MEASURE(SCALAR_DIV);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.scalarDiv(value, isleft));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::fill(int32_t value, lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return Array::fill(value, arrayObj);
+    ARRAY_MEASURE(FILL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(Array::fill(value, arrayObj));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::fill(int64_t value, lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return Array::fill(value, arrayObj);
+    ARRAY_MEASURE(FILL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(Array::fill(value, arrayObj));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::fill(float value, lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return Array::fill(value, arrayObj);
+    ARRAY_MEASURE(FILL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(Array::fill(value, arrayObj));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::fill(double value, lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return Array::fill(value, arrayObj);
+    ARRAY_MEASURE(FILL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(Array::fill(value, arrayObj));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::fill(VarLen32 value, lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
+    ARRAY_MEASURE(FILL);
     std::string val = value.str();
-    Array arrayObj(arrayVal, type);
-    return Array::fill(val, arrayObj);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(Array::fill(val, arrayObj));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::fill(lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return Array::fill(arrayObj);
+    ARRAY_MEASURE(FILL);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(Array::fill(arrayObj));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::transpose(lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.transpose();
+    ARRAY_MEASURE(TRANSPOSE);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.transpose());
+}
+
+lingodb::runtime::VarLen32 ArrayRuntime::permute(lingodb::runtime::VarLen32 array, int32_t type, lingodb::runtime::VarLen32 axes, int32_t axesType) {
+    ARRAY_MEASURE(PERMUTE);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    Array axesObj(axes, axesType);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.permute(axesObj));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::sigmoid(lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.sigmoid();
+    ARRAY_MEASURE(SIGMOID);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.sigmoid());
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::matrixMul(
@@ -271,27 +320,368 @@ lingodb::runtime::VarLen32 ArrayRuntime::matrixMul(
     lingodb::runtime::VarLen32 right,
     int32_t leftType,
     int32_t rightType) {
-        std::string leftVal = left.str();
-        std::string rightVal = right.str();
-        Array leftArray(leftVal, leftType);
-        Array rightArray(rightVal, rightType);
-        return leftArray.matrixMul(rightArray);
+        ARRAY_MEASURE(MATRIX_MUL);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray.matrixMul(rightArray));
+}
+
+lingodb::runtime::VarLen32 ArrayRuntime::matrixMul(
+    lingodb::runtime::VarLen32 left,
+    lingodb::runtime::VarLen32 right,
+    int32_t leftType,
+    int32_t rightType,
+    bool transposeLeft,
+    bool transposeRight,
+    double alpha) {
+        ARRAY_MEASURE(MATRIX_MUL);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray.matrixMul(rightArray, transposeLeft, transposeRight, alpha));
+}
+
+lingodb::runtime::VarLen32 ArrayRuntime::matrixMulAdd(
+    lingodb::runtime::VarLen32 left,
+    lingodb::runtime::VarLen32 right,
+    lingodb::runtime::VarLen32 accumulator,
+    int32_t leftType,
+    int32_t rightType,
+    int32_t accumulatorType,
+    bool transposeLeft,
+    bool transposeRight,
+    double alpha,
+    double beta) {
+        ARRAY_MEASURE(MATRIX_MUL_ADD);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        Array accumulatorArray(accumulator, accumulatorType);
+        ARRAY_MEASURE_INPUT(accumulator, accumulatorArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray.matrixMul(rightArray, accumulatorArray, transposeLeft, transposeRight, alpha, beta));
 }
 
 int32_t ArrayRuntime::getHighestPosition(lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.getHighestPosition();
+    ARRAY_MEASURE(GET_HIGHEST_POSITION);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.getHighestPosition());
+}
+
+int32_t ArrayRuntime::getLowestPosition(lingodb::runtime::VarLen32 array, int32_t type) {
+    ARRAY_MEASURE(GET_LOWEST_POSITION);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.getLowestPosition());
+}
+
+double ArrayRuntime::sum(lingodb::runtime::VarLen32 array, int32_t type) {
+    ARRAY_MEASURE(SUM);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.sum());
+}
+
+double ArrayRuntime::product(lingodb::runtime::VarLen32 array, int32_t type) {
+    ARRAY_MEASURE(PRODUCT);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.product());
+}
+
+double ArrayRuntime::minimum(lingodb::runtime::VarLen32 array, int32_t type) {
+    ARRAY_MEASURE(MINIMUM);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.minimum());
+}
+
+double ArrayRuntime::maximum(lingodb::runtime::VarLen32 array, int32_t type) {
+    ARRAY_MEASURE(MAXIMUM);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.maximum());
+}
+
+double ArrayRuntime::mean(lingodb::runtime::VarLen32 array, int32_t type) {
+    ARRAY_MEASURE(MEAN);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.mean());
+}
+
+double ArrayRuntime::l1Norm(lingodb::runtime::VarLen32 array, int32_t type) {
+    ARRAY_MEASURE(L1_NORM);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.l1Norm());
+}
+
+double ArrayRuntime::l2Norm(lingodb::runtime::VarLen32 array, int32_t type) {
+    ARRAY_MEASURE(L2_NORM);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.l2Norm());
+}
+
+double ArrayRuntime::dot(
+    lingodb::runtime::VarLen32 left,
+    lingodb::runtime::VarLen32 right,
+    int32_t leftType,
+    int32_t rightType) {
+        ARRAY_MEASURE(DOT);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray.dot(rightArray));
+}
+
+double ArrayRuntime::cosineSimilarity(
+    lingodb::runtime::VarLen32 left,
+    lingodb::runtime::VarLen32 right,
+    int32_t leftType,
+    int32_t rightType) {
+        ARRAY_MEASURE(COSINE_SIMILARITY);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray.cosineSimilarity(rightArray));
+}
+
+double ArrayRuntime::l2Distance(
+    lingodb::runtime::VarLen32 left,
+    lingodb::runtime::VarLen32 right,
+    int32_t leftType,
+    int32_t rightType) {
+        ARRAY_MEASURE(L2_DISTANCE);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray.l2Distance(rightArray));
+}
+
+double ArrayRuntime::innerProduct(
+    lingodb::runtime::VarLen32 left,
+    lingodb::runtime::VarLen32 right,
+    int32_t leftType,
+    int32_t rightType) {
+        ARRAY_MEASURE(INNER_PRODUCT);
+        Array leftArray(left, leftType);
+        ARRAY_MEASURE_INPUT(left, leftArray);
+        Array rightArray(right, rightType);
+        ARRAY_MEASURE_INPUT(right, rightArray);
+        return ARRAY_MEASURE_OUTPUT(leftArray.innerProduct(rightArray));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::cast(lingodb::runtime::VarLen32 array, int32_t srcType, int32_t dstType) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, srcType);
-    return arrayObj.cast(dstType);
+    ARRAY_MEASURE(CAST);
+    Array arrayObj(array, srcType);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.cast(dstType));
 }
 
 lingodb::runtime::VarLen32 ArrayRuntime::increment(lingodb::runtime::VarLen32 array, int32_t type) {
-    std::string arrayVal = array.str();
-    Array arrayObj(arrayVal, type);
-    return arrayObj.increment();
-}
\ No newline at end of file
+    ARRAY_MEASURE(INCREMENT);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    return ARRAY_MEASURE_OUTPUT(arrayObj.increment());
+}
+
+void ArrayRuntime::print(lingodb::runtime::VarLen32 array, int32_t type, lingodb::runtime::PrintSink &sink) {
+    ARRAY_MEASURE(PRINT);
+    Array arrayObj(array, type);
+    ARRAY_MEASURE_INPUT(array, arrayObj);
+    [[maybe_unused]] auto appended = sink.getAppended();
+    arrayObj.print(sink);
+    ARRAY_MEASURE_OUTPUT_BYTES(sink.getAppended() - appended);
+}
+
+void ArrayRuntime::add(
+    const lingodb::runtime::VarLen32 *left,
+    const lingodb::runtime::VarLen32 *right,
+    size_t count,
+    int32_t type,
+    lingodb::runtime::VarLen32 *result) {
+        ARRAY_MEASURE(BATCH_ADD);
+        ARRAY_MEASURE_INPUTS(left, count);
+        ARRAY_MEASURE_INPUTS(right, count);
+        uint64_t elements = 0;
+        Array::executeBatchOperation<ArrayAddOperator>(left, right, count, type, result, "Add", elements);
+        ARRAY_MEASURE_ELEMENTS(elements);
+        ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::sub(
+    const lingodb::runtime::VarLen32 *left,
+    const lingodb::runtime::VarLen32 *right,
+    size_t count,
+    int32_t type,
+    lingodb::runtime::VarLen32 *result) {
+        ARRAY_MEASURE(BATCH_SUB);
+        ARRAY_MEASURE_INPUTS(left, count);
+        ARRAY_MEASURE_INPUTS(right, count);
+        uint64_t elements = 0;
+        Array::executeBatchOperation<ArraySubOperator>(left, right, count, type, result, "Sub", elements);
+        ARRAY_MEASURE_ELEMENTS(elements);
+        ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::mul(
+    const lingodb::runtime::VarLen32 *left,
+    const lingodb::runtime::VarLen32 *right,
+    size_t count,
+    int32_t type,
+    lingodb::runtime::VarLen32 *result) {
+        ARRAY_MEASURE(BATCH_MUL);
+        ARRAY_MEASURE_INPUTS(left, count);
+        ARRAY_MEASURE_INPUTS(right, count);
+        uint64_t elements = 0;
+        Array::executeBatchOperation<ArrayMulOperator>(left, right, count, type, result, "Mul", elements);
+        ARRAY_MEASURE_ELEMENTS(elements);
+        ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::div(
+    const lingodb::runtime::VarLen32 *left,
+    const lingodb::runtime::VarLen32 *right,
+    size_t count,
+    int32_t type,
+    lingodb::runtime::VarLen32 *result) {
+        ARRAY_MEASURE(BATCH_DIV);
+        ARRAY_MEASURE_INPUTS(left, count);
+        ARRAY_MEASURE_INPUTS(right, count);
+        uint64_t elements = 0;
+        Array::executeBatchOperation<ArrayDivOperator>(left, right, count, type, result, "Div", elements);
+        ARRAY_MEASURE_ELEMENTS(elements);
+        ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::sum(const lingodb::runtime::VarLen32 *arrays, size_t count, int32_t type, double *result) {
+    ARRAY_MEASURE(BATCH_SUM);
+    ARRAY_MEASURE_INPUTS(arrays, count);
+    uint64_t elements = 0;
+    Array::executeBatchReduction(arrays, count, type, lingodb::runtime::ReductionOperator::SUM, result, "Sum", elements);
+    ARRAY_MEASURE_ELEMENTS(elements);
+    ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::product(const lingodb::runtime::VarLen32 *arrays, size_t count, int32_t type, double *result) {
+    ARRAY_MEASURE(BATCH_PRODUCT);
+    ARRAY_MEASURE_INPUTS(arrays, count);
+    uint64_t elements = 0;
+    Array::executeBatchReduction(arrays, count, type, lingodb::runtime::ReductionOperator::PRODUCT, result, "Product", elements);
+    ARRAY_MEASURE_ELEMENTS(elements);
+    ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::minimum(const lingodb::runtime::VarLen32 *arrays, size_t count, int32_t type, double *result) {
+    ARRAY_MEASURE(BATCH_MINIMUM);
+    ARRAY_MEASURE_INPUTS(arrays, count);
+    uint64_t elements = 0;
+    Array::executeBatchReduction(arrays, count, type, lingodb::runtime::ReductionOperator::MIN, result, "Min", elements);
+    ARRAY_MEASURE_ELEMENTS(elements);
+    ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::maximum(const lingodb::runtime::VarLen32 *arrays, size_t count, int32_t type, double *result) {
+    ARRAY_MEASURE(BATCH_MAXIMUM);
+    ARRAY_MEASURE_INPUTS(arrays, count);
+    uint64_t elements = 0;
+    Array::executeBatchReduction(arrays, count, type, lingodb::runtime::ReductionOperator::MAX, result, "Max", elements);
+    ARRAY_MEASURE_ELEMENTS(elements);
+    ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::l1Norm(const lingodb::runtime::VarLen32 *arrays, size_t count, int32_t type, double *result) {
+    ARRAY_MEASURE(BATCH_L1_NORM);
+    ARRAY_MEASURE_INPUTS(arrays, count);
+    uint64_t elements = 0;
+    Array::executeBatchReduction(arrays, count, type, lingodb::runtime::ReductionOperator::ABSOLUTE_SUM, result, "L1Norm", elements);
+    ARRAY_MEASURE_ELEMENTS(elements);
+    ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::l2Norm(const lingodb::runtime::VarLen32 *arrays, size_t count, int32_t type, double *result) {
+    ARRAY_MEASURE(BATCH_L2_NORM);
+    ARRAY_MEASURE_INPUTS(arrays, count);
+    uint64_t elements = 0;
+    Array::executeBatchReduction(arrays, count, type, lingodb::runtime::ReductionOperator::SQUARED_SUM, result, "L2Norm", elements);
+    ARRAY_MEASURE_ELEMENTS(elements);
+    for (size_t i = 0; i < count; i++) {
+        result[i] = std::sqrt(result[i]);
+    }
+    ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::dot(
+    const lingodb::runtime::VarLen32 *left,
+    const lingodb::runtime::VarLen32 *right,
+    size_t count,
+    int32_t type,
+    double *result) {
+        ARRAY_MEASURE(BATCH_DOT);
+        ARRAY_MEASURE_INPUTS(left, count);
+        ARRAY_MEASURE_INPUTS(right, count);
+        uint64_t elements = 0;
+        Array::executeBatchDistance(left, right, count, type, lingodb::runtime::DistanceOperator::DOT, result, "Dot", elements);
+        ARRAY_MEASURE_ELEMENTS(elements);
+        ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::cosineSimilarity(
+    const lingodb::runtime::VarLen32 *left,
+    const lingodb::runtime::VarLen32 *right,
+    size_t count,
+    int32_t type,
+    double *result) {
+        ARRAY_MEASURE(BATCH_COSINE_SIMILARITY);
+        ARRAY_MEASURE_INPUTS(left, count);
+        ARRAY_MEASURE_INPUTS(right, count);
+        uint64_t elements = 0;
+        Array::executeBatchDistance(left, right, count, type, lingodb::runtime::DistanceOperator::COSINE, result, "CosineSimilarity", elements);
+        ARRAY_MEASURE_ELEMENTS(elements);
+        ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::l2Distance(
+    const lingodb::runtime::VarLen32 *left,
+    const lingodb::runtime::VarLen32 *right,
+    size_t count,
+    int32_t type,
+    double *result) {
+        ARRAY_MEASURE(BATCH_L2_DISTANCE);
+        ARRAY_MEASURE_INPUTS(left, count);
+        ARRAY_MEASURE_INPUTS(right, count);
+        uint64_t elements = 0;
+        Array::executeBatchDistance(left, right, count, type, lingodb::runtime::DistanceOperator::SQUARED_L2, result, "L2Distance", elements);
+        ARRAY_MEASURE_ELEMENTS(elements);
+        for (size_t i = 0; i < count; i++) {
+            result[i] = std::sqrt(result[i]);
+        }
+        ARRAY_MEASURE_OUTPUTS(result, count);
+}
+
+void ArrayRuntime::innerProduct(
+    const lingodb::runtime::VarLen32 *left,
+    const lingodb::runtime::VarLen32 *right,
+    size_t count,
+    int32_t type,
+    double *result) {
+        ARRAY_MEASURE(BATCH_INNER_PRODUCT);
+        ARRAY_MEASURE_INPUTS(left, count);
+        ARRAY_MEASURE_INPUTS(right, count);
+        uint64_t elements = 0;
+        Array::executeBatchDistance(left, right, count, type, lingodb::runtime::DistanceOperator::DOT, result, "InnerProduct", elements);
+        ARRAY_MEASURE_ELEMENTS(elements);
+        for (size_t i = 0; i < count; i++) {
+            result[i] = -result[i];
+        }
+        ARRAY_MEASURE_OUTPUTS(result, count);
+}
@@ -0,0 +1,975 @@
+#include "../include/ArraySimd.h"
+#include "../include/ArrayArithmetic.h"
+#include "../include/BFloat16.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARRAY_SIMD_X86
+#endif
+
+#define ARRAY_SIMD_INLINE inline __attribute__((always_inline))
+
+using lingodb::runtime::ArraySimd;
+using lingodb::runtime::SimdLevel;
+using lingodb::runtime::OperandLayout;
+using lingodb::runtime::BinaryKernel;
+using lingodb::runtime::PromotingKernel;
+using lingodb::runtime::ReductionKernel;
+using lingodb::runtime::ReductionOperator;
+using lingodb::runtime::DistanceKernel;
+using lingodb::runtime::DistanceOperator;
+using lingodb::runtime::StructuralKernel;
+using lingodb::runtime::ArrayAddOperator;
+using lingodb::runtime::ArraySubOperator;
+using lingodb::runtime::ArrayMulOperator;
+using lingodb::runtime::ArrayDivOperator;
+using lingodb::runtime::BFloat16;
+
+namespace {
+
+SimdLevel detectLevel() {
+#ifdef ARRAY_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::SCALAR;
+}
+
+std::atomic<SimdLevel> &currentLevel() {
+    static std::atomic<SimdLevel> level(ArraySimd::getSupportedLevel());
+    return level;
+}
+
+template<class TYPE>
+constexpr bool isFloatingPoint() {
+    return std::is_floating_point_v<TYPE> || std::is_same_v<TYPE, BFloat16>;
+}
+
+// The type of a single lane of a vector register for values of type `TYPE` (brain floating
+// point numbers are expanded to floats).
+template<class TYPE>
+using Lane = std::conditional_t<std::is_same_v<TYPE, BFloat16>, float, TYPE>;
+
+/**
+ * This function converts an operand to the result type of a kernel. Values of the result
+ * type are returned unchanged.
+ */
+template<class RESULT, class TYPE>
+ARRAY_SIMD_INLINE RESULT promote(TYPE value) {
+    if constexpr (std::is_same_v<TYPE, RESULT>) return value;
+    else return static_cast<RESULT>(static_cast<Lane<TYPE>>(value));
+}
+
+/**
+ * This function applies `OP` element by element. It is used for the remaining elements
+ * of every vector kernel and for all combinations without vector instructions.
+ */
+template<class LEFT, class RIGHT, class RESULT, class OP, OperandLayout LAYOUT>
+ARRAY_SIMD_INLINE void applyScalar(const LEFT *left, const RIGHT *right, RESULT *result, size_t begin, size_t end) {
+    if constexpr (LAYOUT == OperandLayout::SCALAR_ARRAY) {
+        const RESULT value = promote<RESULT>(*left);
+        for (size_t i = begin; i < end; i++) result[i] = OP::apply(value, promote<RESULT>(right[i]));
+    } else if constexpr (LAYOUT == OperandLayout::ARRAY_SCALAR) {
+        const RESULT value = promote<RESULT>(*right);
+        for (size_t i = begin; i < end; i++) result[i] = OP::apply(promote<RESULT>(left[i]), value);
+    } else {
+        for (size_t i = begin; i < end; i++) result[i] = OP::apply(promote<RESULT>(left[i]), promote<RESULT>(right[i]));
+    }
+}
+
+template<class LEFT, class RIGHT, class RESULT, class OP, OperandLayout LAYOUT>
+void scalarKernel(const LEFT *left, const RIGHT *right, RESULT *result, size_t size) {
+    applyScalar<LEFT, RIGHT, RESULT, OP, LAYOUT>(left, right, result, 0, size);
+}
+
+// The number of values that are summed one after another before they are summed pairwise.
+constexpr size_t PAIRWISE_BLOCK = 128;
+
+template<ReductionOperator OP>
+constexpr bool isSummation() {
+    return OP == ReductionOperator::SUM || OP == ReductionOperator::ABSOLUTE_SUM || OP == ReductionOperator::SQUARED_SUM;
+}
+
+// The type of the partial results of a reduction over values of type `TYPE`.
+template<class TYPE, ReductionOperator OP>
+using Accumulator = std::conditional_t<
+    isFloatingPoint<TYPE>() || OP == ReductionOperator::MIN || OP == ReductionOperator::MAX,
+    Lane<TYPE>,
+    std::conditional_t<OP == ReductionOperator::SUM, int64_t, double>>;
+
+/**
+ * This function combines two partial results of a reduction.
+ */
+template<ReductionOperator OP, class ACCUMULATOR>
+ARRAY_SIMD_INLINE ACCUMULATOR combine(ACCUMULATOR left, ACCUMULATOR right) {
+    if constexpr (isSummation<OP>()) return left + right;
+    else if constexpr (OP == ReductionOperator::PRODUCT) return left * right;
+    else if constexpr (OP == ReductionOperator::MIN) return right < left ? right : left;
+    else return right > left ? right : left;
+}
+
+/**
+ * This function adds a single value to the partial result of a reduction.
+ */
+template<ReductionOperator OP, class ACCUMULATOR, class TYPE>
+ARRAY_SIMD_INLINE ACCUMULATOR accumulate(ACCUMULATOR result, TYPE value) {
+    auto converted = static_cast<ACCUMULATOR>(value);
+    if constexpr (OP == ReductionOperator::ABSOLUTE_SUM) return result + (converted < 0 ? -converted : converted);
+    else if constexpr (OP == ReductionOperator::SQUARED_SUM) return result + converted * converted;
+    else return combine<OP>(result, converted);
+}
+
+/**
+ * This function reduces the values one by one. Floating point values are summed pairwise.
+ * It is used for the remaining values of every vector kernel and for all integers.
+ */
+template<class TYPE, ReductionOperator OP>
+Accumulator<TYPE, OP> reduceScalar(const TYPE *values, size_t size) {
+    if constexpr (isFloatingPoint<TYPE>() && isSummation<OP>()) {
+        if (size > PAIRWISE_BLOCK) {
+            auto half = size / 2;
+            return reduceScalar<TYPE, OP>(values, half) + reduceScalar<TYPE, OP>(values + half, size - half);
+        }
+    }
+    Accumulator<TYPE, OP> result = 0;
+    if constexpr (OP == ReductionOperator::PRODUCT) result = 1;
+    if constexpr (OP == ReductionOperator::MIN || OP == ReductionOperator::MAX) result = values[0];
+    for (size_t i = 0; i < size; i++) {
+        result = accumulate<OP>(result, values[i]);
+    }
+    return result;
+}
+
+template<class TYPE, ReductionOperator OP>
+double scalarReduction(const TYPE *values, size_t size) {
+    return static_cast<double>(reduceScalar<TYPE, OP>(values, size));
+}
+
+/**
+ * This function adds the products of two corresponding values to the parts of a measure.
+ * The cosine similarity needs three parts (dot product and both squared lengths).
+ */
+template<DistanceOperator OP>
+ARRAY_SIMD_INLINE void accumulateDistance(double &first, double &second, double &third, double left, double right) {
+    if constexpr (OP == DistanceOperator::DOT) {
+        first += left * right;
+    } else if constexpr (OP == DistanceOperator::SQUARED_L2) {
+        double difference = left - right;
+        first += difference * difference;
+    } else {
+        first += left * right;
+        second += left * left;
+        third += right * right;
+    }
+}
+
+/**
+ * This function computes a measure from its parts.
+ */
+template<DistanceOperator OP>
+ARRAY_SIMD_INLINE double finishDistance(double first, double second, double third) {
+    if constexpr (OP == DistanceOperator::COSINE) return first / std::sqrt(second * third);
+    return first;
+}
+
+template<class TYPE, DistanceOperator OP>
+double scalarDistance(const TYPE *left, const TYPE *right, size_t size) {
+    double first = 0, second = 0, third = 0;
+    for (size_t i = 0; i < size; i++) {
+        accumulateDistance<OP>(first, second, third, left[i], right[i]);
+    }
+    return finishDistance<OP>(first, second, third);
+}
+
+/**
+ * This function returns whether a character separates the parts of an array literal.
+ */
+ARRAY_SIMD_INLINE bool isStructural(char c) {
+    return c == '{' || c == '}' || c == ',' || c == '"' || c == '\\';
+}
+
+void scalarStructurals(const char *text, size_t size, uint64_t *masks) {
+    for (size_t block = 0; block * 64 < size; block++) {
+        uint64_t mask = 0;
+        auto length = std::min<size_t>(64, size - block * 64);
+        for (size_t i = 0; i < length; i++) {
+            if (isStructural(text[block * 64 + i])) mask |= 1ull << i;
+        }
+        masks[block] = mask;
+    }
+}
+
+#ifdef ARRAY_SIMD_X86
+
+/*
+ * Each of the following structs wraps the instructions of one instruction set for one
+ * element type. `MUL` and `DIV` state whether the instruction set can multiply or divide
+ * these elements (if not, the corresponding function does not exist). Floating point
+ * elements additionally provide `min`, `max`, `abs` and `fmadd` (a * b + c). Further
+ * overloads of `load` convert narrower types to these elements (one register of them),
+ * they are used for operands of different types.
+ */
+#define SSE2_TARGET __attribute__((target("sse2")))
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#define AVX512_TARGET __attribute__((target("avx512f,avx512dq")))
+
+template<class TYPE> struct Sse2;
+template<class TYPE> struct Avx2;
+template<class TYPE> struct Avx512;
+
+template<> struct Sse2<int32_t> {
+    using Register = __m128i;
+    static constexpr size_t WIDTH = 4;
+    static constexpr bool MUL = false;
+    static constexpr bool DIV = false;
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static void store(int32_t *p, Register v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register set1(int32_t v) { return _mm_set1_epi32(v); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm_add_epi32(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm_sub_epi32(a, b); }
+};
+
+template<> struct Sse2<int64_t> {
+    using Register = __m128i;
+    static constexpr size_t WIDTH = 2;
+    static constexpr bool MUL = false;
+    static constexpr bool DIV = false;
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const int64_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) {
+        auto values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+        return _mm_unpacklo_epi32(values, _mm_srai_epi32(values, 31));
+    }
+    SSE2_TARGET ARRAY_SIMD_INLINE static void store(int64_t *p, Register v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register set1(int64_t v) { return _mm_set1_epi64x(v); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm_add_epi64(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm_sub_epi64(a, b); }
+};
+
+template<> struct Sse2<float> {
+    using Register = __m128;
+    static constexpr size_t WIDTH = 4;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = true;
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const float *p) { return _mm_loadu_ps(p); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const BFloat16 *p) {
+        auto bits = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+        return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), bits));
+    }
+    SSE2_TARGET ARRAY_SIMD_INLINE static void store(float *p, Register v) { _mm_storeu_ps(p, v); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register set1(float v) { return _mm_set1_ps(v); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm_add_ps(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register div(Register a, Register b) { return _mm_div_ps(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register min(Register a, Register b) { return _mm_min_ps(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register max(Register a, Register b) { return _mm_max_ps(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register abs(Register a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register fmadd(Register a, Register b, Register c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+};
+
+template<> struct Sse2<double> {
+    using Register = __m128d;
+    static constexpr size_t WIDTH = 2;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = true;
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const double *p) { return _mm_loadu_pd(p); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) { return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const float *p) { return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)))); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register load(const BFloat16 *p) {
+        int32_t bits;
+        memcpy(&bits, p, sizeof(bits));
+        return _mm_cvtps_pd(_mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), _mm_cvtsi32_si128(bits))));
+    }
+    SSE2_TARGET ARRAY_SIMD_INLINE static void store(double *p, Register v) { _mm_storeu_pd(p, v); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register set1(double v) { return _mm_set1_pd(v); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm_add_pd(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm_sub_pd(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm_mul_pd(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register div(Register a, Register b) { return _mm_div_pd(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register min(Register a, Register b) { return _mm_min_pd(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register max(Register a, Register b) { return _mm_max_pd(a, b); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register abs(Register a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    SSE2_TARGET ARRAY_SIMD_INLINE static Register fmadd(Register a, Register b, Register c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+};
+
+template<> struct Avx2<int32_t> {
+    using Register = __m256i;
+    static constexpr size_t WIDTH = 8;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = false;
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static void store(int32_t *p, Register v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register set1(int32_t v) { return _mm256_set1_epi32(v); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm256_add_epi32(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm256_sub_epi32(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm256_mullo_epi32(a, b); }
+};
+
+template<> struct Avx2<int64_t> {
+    using Register = __m256i;
+    static constexpr size_t WIDTH = 4;
+    static constexpr bool MUL = false;
+    static constexpr bool DIV = false;
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const int64_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) { return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static void store(int64_t *p, Register v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register set1(int64_t v) { return _mm256_set1_epi64x(v); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm256_add_epi64(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm256_sub_epi64(a, b); }
+};
+
+template<> struct Avx2<float> {
+    using Register = __m256;
+    static constexpr size_t WIDTH = 8;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = true;
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const float *p) { return _mm256_loadu_ps(p); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const BFloat16 *p) {
+        auto bits = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16));
+    }
+    AVX2_TARGET ARRAY_SIMD_INLINE static void store(float *p, Register v) { _mm256_storeu_ps(p, v); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register set1(float v) { return _mm256_set1_ps(v); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm256_add_ps(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm256_sub_ps(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm256_mul_ps(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register div(Register a, Register b) { return _mm256_div_ps(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register min(Register a, Register b) { return _mm256_min_ps(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register max(Register a, Register b) { return _mm256_max_ps(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register abs(Register a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register fmadd(Register a, Register b, Register c) { return _mm256_fmadd_ps(a, b, c); }
+};
+
+template<> struct Avx2<double> {
+    using Register = __m256d;
+    static constexpr size_t WIDTH = 4;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = true;
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const double *p) { return _mm256_loadu_pd(p); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) { return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const float *p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register load(const BFloat16 *p) {
+        auto bits = _mm_unpacklo_epi16(_mm_setzero_si128(), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+        return _mm256_cvtps_pd(_mm_castsi128_ps(bits));
+    }
+    AVX2_TARGET ARRAY_SIMD_INLINE static void store(double *p, Register v) { _mm256_storeu_pd(p, v); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register set1(double v) { return _mm256_set1_pd(v); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm256_add_pd(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm256_sub_pd(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm256_mul_pd(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register div(Register a, Register b) { return _mm256_div_pd(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register min(Register a, Register b) { return _mm256_min_pd(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register max(Register a, Register b) { return _mm256_max_pd(a, b); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register abs(Register a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    AVX2_TARGET ARRAY_SIMD_INLINE static Register fmadd(Register a, Register b, Register c) { return _mm256_fmadd_pd(a, b, c); }
+};
+
+template<> struct Avx512<int32_t> {
+    using Register = __m512i;
+    static constexpr size_t WIDTH = 16;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = false;
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) { return _mm512_loadu_si512(p); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static void store(int32_t *p, Register v) { _mm512_storeu_si512(p, v); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register set1(int32_t v) { return _mm512_set1_epi32(v); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm512_add_epi32(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm512_sub_epi32(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm512_mullo_epi32(a, b); }
+};
+
+template<> struct Avx512<int64_t> {
+    using Register = __m512i;
+    static constexpr size_t WIDTH = 8;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = false;
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const int64_t *p) { return _mm512_loadu_si512(p); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) { return _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static void store(int64_t *p, Register v) { _mm512_storeu_si512(p, v); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register set1(int64_t v) { return _mm512_set1_epi64(v); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm512_add_epi64(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm512_sub_epi64(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm512_mullo_epi64(a, b); }
+};
+
+template<> struct Avx512<float> {
+    using Register = __m512;
+    static constexpr size_t WIDTH = 16;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = true;
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const float *p) { return _mm512_loadu_ps(p); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const BFloat16 *p) {
+        auto bits = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(bits, 16));
+    }
+    AVX512_TARGET ARRAY_SIMD_INLINE static void store(float *p, Register v) { _mm512_storeu_ps(p, v); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register set1(float v) { return _mm512_set1_ps(v); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm512_add_ps(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm512_sub_ps(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm512_mul_ps(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register div(Register a, Register b) { return _mm512_div_ps(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register min(Register a, Register b) { return _mm512_min_ps(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register max(Register a, Register b) { return _mm512_max_ps(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register abs(Register a) { return _mm512_abs_ps(a); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register fmadd(Register a, Register b, Register c) { return _mm512_fmadd_ps(a, b, c); }
+};
+
+template<> struct Avx512<double> {
+    using Register = __m512d;
+    static constexpr size_t WIDTH = 8;
+    static constexpr bool MUL = true;
+    static constexpr bool DIV = true;
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const double *p) { return _mm512_loadu_pd(p); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const int32_t *p) { return _mm512_cvtepi32_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const int64_t *p) { return _mm512_cvtepi64_pd(_mm512_loadu_si512(p)); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const float *p) { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register load(const BFloat16 *p) {
+        auto bits = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        return _mm512_cvtps_pd(_mm256_castsi256_ps(_mm256_slli_epi32(bits, 16)));
+    }
+    AVX512_TARGET ARRAY_SIMD_INLINE static void store(double *p, Register v) { _mm512_storeu_pd(p, v); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register set1(double v) { return _mm512_set1_pd(v); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register add(Register a, Register b) { return _mm512_add_pd(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register sub(Register a, Register b) { return _mm512_sub_pd(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register mul(Register a, Register b) { return _mm512_mul_pd(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register div(Register a, Register b) { return _mm512_div_pd(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register min(Register a, Register b) { return _mm512_min_pd(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register max(Register a, Register b) { return _mm512_max_pd(a, b); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register abs(Register a) { return _mm512_abs_pd(a); }
+    AVX512_TARGET ARRAY_SIMD_INLINE static Register fmadd(Register a, Register b, Register c) { return _mm512_fmadd_pd(a, b, c); }
+};
+
+/*
+ * Brain floating point numbers are expanded to floats on load (see the float structs) and
+ * rounded back to the nearest value (ties to even, NaN remains NaN) on store, so they use
+ * the float registers. Storing to a float keeps the expanded value (e.g. for partial results).
+ */
+template<> struct Sse2<BFloat16> : Sse2<float> {
+    using Sse2<float>::store;
+    SSE2_TARGET ARRAY_SIMD_INLINE static void store(BFloat16 *p, Register v) {
+        auto bits = _mm_castps_si128(v);
+        auto bias = _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1)), _mm_set1_epi32(0x7FFF));
+        auto nan = _mm_castps_si128(_mm_cmpunord_ps(v, v));
+        auto quiet = _mm_or_si128(bits, _mm_set1_epi32(0x00400000));
+        auto rounded = _mm_or_si128(_mm_and_si128(nan, quiet), _mm_andnot_si128(nan, _mm_add_epi32(bits, bias)));
+        // The arithmetic shift keeps every value within 16 signed bits, so packing does not saturate
+        auto packed = _mm_packs_epi32(_mm_srai_epi32(rounded, 16), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(p), packed);
+    }
+};
+
+template<> struct Avx2<BFloat16> : Avx2<float> {
+    using Avx2<float>::store;
+    AVX2_TARGET ARRAY_SIMD_INLINE static void store(BFloat16 *p, Register v) {
+        auto bits = _mm256_castps_si256(v);
+        auto bias = _mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1)), _mm256_set1_epi32(0x7FFF));
+        auto nan = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+        auto quiet = _mm256_or_si256(bits, _mm256_set1_epi32(0x00400000));
+        auto rounded = _mm256_srli_epi32(_mm256_blendv_epi8(_mm256_add_epi32(bits, bias), quiet, nan), 16);
+        auto packed = _mm_packus_epi32(_mm256_castsi256_si128(rounded), _mm256_extracti128_si256(rounded, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), packed);
+    }
+};
+
+template<> struct Avx512<BFloat16> : Avx512<float> {
+    using Avx512<float>::store;
+    AVX512_TARGET ARRAY_SIMD_INLINE static void store(BFloat16 *p, Register v) {
+        auto bits = _mm512_castps_si512(v);
+        auto bias = _mm512_add_epi32(_mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1)), _mm512_set1_epi32(0x7FFF));
+        auto nan = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+        auto rounded = _mm512_mask_or_epi32(_mm512_add_epi32(bits, bias), nan, bits, _mm512_set1_epi32(0x00400000));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtepi32_epi16(_mm512_srli_epi32(rounded, 16)));
+    }
+};
+
+/**
+ * This function returns whether the instructions `V` support the operator `OP`.
+ */
+template<class V, class OP>
+constexpr bool isSupported() {
+    if constexpr (std::is_same_v<OP, ArrayMulOperator>) return V::MUL;
+    if constexpr (std::is_same_v<OP, ArrayDivOperator>) return V::DIV;
+    return true;
+}
+
+// Whether the instructions `V` can load values of type `TYPE` (see the `load` overloads).
+template<class V, class TYPE, class = void>
+struct CanLoad : std::false_type {};
+
+template<class V, class TYPE>
+struct CanLoad<V, TYPE, decltype(static_cast<void>(V::load(std::declval<const TYPE*>())))> : std::true_type {};
+
+/**
+ * This function returns whether the instructions `V` support the operator `OP` on
+ * operands of type `LEFT` and `RIGHT`.
+ */
+template<class V, class OP, class LEFT, class RIGHT>
+constexpr bool isSupported() {
+    return isSupported<V, OP>() && CanLoad<V, LEFT>::value && CanLoad<V, RIGHT>::value;
+}
+
+/*
+ * This macro defines the kernel `NAME` for the instructions `TRAITS` compiled with `TARGET`.
+ * The body is generated for every instruction set, because a function without the
+ * target attribute must not handle vector registers. The scalar operand is broadcast once,
+ * operands of another type are converted by the `load` overloads of the result type.
+ */
+#define ARRAY_SIMD_KERNEL(NAME, TARGET, TRAITS) \
+template<class LEFT, class RIGHT, class RESULT, class OP, OperandLayout LAYOUT> \
+TARGET void NAME(const LEFT *left, const RIGHT *right, RESULT *result, size_t size) { \
+    using V = TRAITS<RESULT>; \
+    typename V::Register leftValue, rightValue; \
+    if constexpr (LAYOUT == OperandLayout::SCALAR_ARRAY) leftValue = V::set1(promote<RESULT>(*left)); \
+    if constexpr (LAYOUT == OperandLayout::ARRAY_SCALAR) rightValue = V::set1(promote<RESULT>(*right)); \
+    size_t i = 0; \
+    for (; i + V::WIDTH <= size; i += V::WIDTH) { \
+        if constexpr (LAYOUT != OperandLayout::SCALAR_ARRAY) leftValue = V::load(left + i); \
+        if constexpr (LAYOUT != OperandLayout::ARRAY_SCALAR) rightValue = V::load(right + i); \
+        if constexpr (std::is_same_v<OP, ArrayAddOperator>) { \
+            V::store(result + i, V::add(leftValue, rightValue)); \
+        } else if constexpr (std::is_same_v<OP, ArraySubOperator>) { \
+            V::store(result + i, V::sub(leftValue, rightValue)); \
+        } else if constexpr (std::is_same_v<OP, ArrayMulOperator>) { \
+            V::store(result + i, V::mul(leftValue, rightValue)); \
+        } else { \
+            V::store(result + i, V::div(leftValue, rightValue)); \
+        } \
+    } \
+    applyScalar<LEFT, RIGHT, RESULT, OP, LAYOUT>(left, right, result, i, size); \
+}
+
+ARRAY_SIMD_KERNEL(sse2Kernel, SSE2_TARGET, Sse2)
+ARRAY_SIMD_KERNEL(avx2Kernel, AVX2_TARGET, Avx2)
+ARRAY_SIMD_KERNEL(avx512Kernel, AVX512_TARGET, Avx512)
+
+/*
+ * This macro defines the reduction `NAME` for the instructions `TRAITS` compiled with `TARGET`
+ * (only for floating point values). Each lane accumulates its own partial result, the lanes
+ * are combined at the end. Sums are split pairwise until a block fits `PAIRWISE_BLOCK`.
+ */
+#define ARRAY_SIMD_REDUCTION(NAME, TARGET, TRAITS) \
+template<class TYPE, ReductionOperator OP> \
+TARGET Accumulator<TYPE, OP> NAME(const TYPE *values, size_t size) { \
+    using V = TRAITS<TYPE>; \
+    if (size < V::WIDTH) return reduceScalar<TYPE, OP>(values, size); \
+    if constexpr (isSummation<OP>()) { \
+        if (size > PAIRWISE_BLOCK) { \
+            auto half = (size / 2) & ~(V::WIDTH - 1); \
+            return NAME<TYPE, OP>(values, half) + NAME<TYPE, OP>(values + half, size - half); \
+        } \
+    } \
+    typename V::Register result; \
+    size_t i = 0; \
+    if constexpr (isSummation<OP>()) { \
+        result = V::set1(0); \
+    } else if constexpr (OP == ReductionOperator::PRODUCT) { \
+        result = V::set1(1); \
+    } else { \
+        result = V::load(values); \
+        i = V::WIDTH; \
+    } \
+    for (; i + V::WIDTH <= size; i += V::WIDTH) { \
+        auto value = V::load(values + i); \
+        if constexpr (OP == ReductionOperator::SUM) result = V::add(result, value); \
+        else if constexpr (OP == ReductionOperator::ABSOLUTE_SUM) result = V::add(result, V::abs(value)); \
+        else if constexpr (OP == ReductionOperator::SQUARED_SUM) result = V::add(result, V::mul(value, value)); \
+        else if constexpr (OP == ReductionOperator::PRODUCT) result = V::mul(result, value); \
+        else if constexpr (OP == ReductionOperator::MIN) result = V::min(result, value); \
+        else result = V::max(result, value); \
+    } \
+    alignas(64) Lane<TYPE> lanes[V::WIDTH]; \
+    V::store(lanes, result); \
+    Accumulator<TYPE, OP> total = lanes[0]; \
+    for (size_t j = 1; j < V::WIDTH; j++) total = combine<OP>(total, lanes[j]); \
+    for (; i < size; i++) total = accumulate<OP>(total, values[i]); \
+    return total; \
+}
+
+ARRAY_SIMD_REDUCTION(sse2Reduction, SSE2_TARGET, Sse2)
+ARRAY_SIMD_REDUCTION(avx2Reduction, AVX2_TARGET, Avx2)
+ARRAY_SIMD_REDUCTION(avx512Reduction, AVX512_TARGET, Avx512)
+
+/*
+ * This macro accumulates the parts of a measure for the values at `OFFSET` into the
+ * registers `INDEX` (only within `ARRAY_SIMD_DISTANCE`).
+ */
+#define ARRAY_SIMD_DISTANCE_STEP(INDEX, OFFSET) { \
+    auto a = V::load(left + (OFFSET)); \
+    auto b = V::load(right + (OFFSET)); \
+    if constexpr (OP == DistanceOperator::DOT) { \
+        first[INDEX] = V::fmadd(a, b, first[INDEX]); \
+    } else if constexpr (OP == DistanceOperator::SQUARED_L2) { \
+        auto difference = V::sub(a, b); \
+        first[INDEX] = V::fmadd(difference, difference, first[INDEX]); \
+    } else { \
+        first[INDEX] = V::fmadd(a, b, first[INDEX]); \
+        second[INDEX] = V::fmadd(a, a, second[INDEX]); \
+        third[INDEX] = V::fmadd(b, b, third[INDEX]); \
+    } \
+}
+
+/*
+ * This macro defines the measure `NAME` for the instructions `TRAITS` compiled with `TARGET`
+ * (only for floating point values). Four independent accumulators per part hide the latency
+ * of the additions, so the kernel is limited by the memory bandwidth.
+ */
+#define ARRAY_SIMD_DISTANCE(NAME, TARGET, TRAITS) \
+template<class TYPE, DistanceOperator OP> \
+TARGET double NAME(const TYPE *left, const TYPE *right, size_t size) { \
+    using V = TRAITS<TYPE>; \
+    constexpr size_t UNROLL = 4; \
+    typename V::Register first[UNROLL], second[UNROLL], third[UNROLL]; \
+    for (size_t j = 0; j < UNROLL; j++) { \
+        first[j] = V::set1(0); \
+        second[j] = V::set1(0); \
+        third[j] = V::set1(0); \
+    } \
+    size_t i = 0; \
+    for (; i + UNROLL * V::WIDTH <= size; i += UNROLL * V::WIDTH) { \
+        ARRAY_SIMD_DISTANCE_STEP(0, i) \
+        ARRAY_SIMD_DISTANCE_STEP(1, i + V::WIDTH) \
+        ARRAY_SIMD_DISTANCE_STEP(2, i + 2 * V::WIDTH) \
+        ARRAY_SIMD_DISTANCE_STEP(3, i + 3 * V::WIDTH) \
+    } \
+    for (; i + V::WIDTH <= size; i += V::WIDTH) { \
+        ARRAY_SIMD_DISTANCE_STEP(0, i) \
+    } \
+    for (size_t j = 1; j < UNROLL; j++) { \
+        first[0] = V::add(first[0], first[j]); \
+        second[0] = V::add(second[0], second[j]); \
+        third[0] = V::add(third[0], third[j]); \
+    } \
+    alignas(64) Lane<TYPE> lanes[3][V::WIDTH]; \
+    V::store(lanes[0], first[0]); \
+    V::store(lanes[1], second[0]); \
+    V::store(lanes[2], third[0]); \
+    double parts[3] = {0, 0, 0}; \
+    for (size_t j = 0; j < V::WIDTH; j++) { \
+        parts[0] += lanes[0][j]; \
+        parts[1] += lanes[1][j]; \
+        parts[2] += lanes[2][j]; \
+    } \
+    for (; i < size; i++) { \
+        accumulateDistance<OP>(parts[0], parts[1], parts[2], left[i], right[i]); \
+    } \
+    return finishDistance<OP>(parts[0], parts[1], parts[2]); \
+}
+
+ARRAY_SIMD_DISTANCE(sse2Distance, SSE2_TARGET, Sse2)
+ARRAY_SIMD_DISTANCE(avx2Distance, AVX2_TARGET, Avx2)
+ARRAY_SIMD_DISTANCE(avx512Distance, AVX512_TARGET, Avx512)
+
+/**
+ * This function marks the structural characters of 64 characters with SSE2 instructions.
+ */
+SSE2_TARGET ARRAY_SIMD_INLINE uint64_t sse2StructuralBlock(const char *text) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < 64; i += 16) {
+        auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        auto braces = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('{')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('}')));
+        auto quotes = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\')));
+        auto found = _mm_or_si128(_mm_or_si128(braces, quotes), _mm_cmpeq_epi8(chars, _mm_set1_epi8(',')));
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(found))) << i;
+    }
+    return mask;
+}
+
+/**
+ * This function marks the structural characters of 64 characters with AVX2 instructions.
+ */
+AVX2_TARGET ARRAY_SIMD_INLINE uint64_t avx2StructuralBlock(const char *text) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < 64; i += 32) {
+        auto chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        auto braces = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('}')));
+        auto quotes = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\\')));
+        auto found = _mm256_or_si256(_mm256_or_si256(braces, quotes), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(',')));
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(found))) << i;
+    }
+    return mask;
+}
+
+/*
+ * This macro defines the structural scan `NAME` that processes 64 characters at once with
+ * `BLOCK` (compiled with `TARGET`). The last incomplete block is copied to a padded buffer.
+ */
+#define ARRAY_SIMD_STRUCTURALS(NAME, TARGET, BLOCK) \
+TARGET void NAME(const char *text, size_t size, uint64_t *masks) { \
+    size_t block = 0; \
+    for (; (block + 1) * 64 <= size; block++) { \
+        masks[block] = BLOCK(text + block * 64); \
+    } \
+    if (block * 64 < size) { \
+        alignas(64) char last[64] = {}; \
+        memcpy(last, text + block * 64, size - block * 64); \
+        masks[block] = BLOCK(last); \
+    } \
+}
+
+ARRAY_SIMD_STRUCTURALS(sse2Structurals, SSE2_TARGET, sse2StructuralBlock)
+ARRAY_SIMD_STRUCTURALS(avx2Structurals, AVX2_TARGET, avx2StructuralBlock)
+
+template<class TYPE, ReductionOperator OP, Accumulator<TYPE, OP> (*KERNEL)(const TYPE *, size_t)>
+double vectorReduction(const TYPE *values, size_t size) {
+    return static_cast<double>(KERNEL(values, size));
+}
+
+#endif
+
+/**
+ * This function returns the kernel of an instruction set (`KERNEL`) for a layout.
+ */
+template<class LEFT, class RIGHT, class RESULT, class OP, template<class, class, class, class, OperandLayout> class KERNEL>
+PromotingKernel<LEFT, RIGHT, RESULT> selectLayout(OperandLayout layout) {
+    switch (layout) {
+        case OperandLayout::SCALAR_ARRAY: return KERNEL<LEFT, RIGHT, RESULT, OP, OperandLayout::SCALAR_ARRAY>::get();
+        case OperandLayout::ARRAY_SCALAR: return KERNEL<LEFT, RIGHT, RESULT, OP, OperandLayout::ARRAY_SCALAR>::get();
+        default: return KERNEL<LEFT, RIGHT, RESULT, OP, OperandLayout::ARRAY_ARRAY>::get();
+    }
+}
+
+template<class LEFT, class RIGHT, class RESULT, class OP, OperandLayout LAYOUT>
+struct Scalar {
+    static PromotingKernel<LEFT, RIGHT, RESULT> get() { return &scalarKernel<LEFT, RIGHT, RESULT, OP, LAYOUT>; }
+};
+
+#ifdef ARRAY_SIMD_X86
+template<class LEFT, class RIGHT, class RESULT, class OP, OperandLayout LAYOUT>
+struct Sse2Kernel {
+    static PromotingKernel<LEFT, RIGHT, RESULT> get() { return &sse2Kernel<LEFT, RIGHT, RESULT, OP, LAYOUT>; }
+};
+
+template<class LEFT, class RIGHT, class RESULT, class OP, OperandLayout LAYOUT>
+struct Avx2Kernel {
+    static PromotingKernel<LEFT, RIGHT, RESULT> get() { return &avx2Kernel<LEFT, RIGHT, RESULT, OP, LAYOUT>; }
+};
+
+template<class LEFT, class RIGHT, class RESULT, class OP, OperandLayout LAYOUT>
+struct Avx512Kernel {
+    static PromotingKernel<LEFT, RIGHT, RESULT> get() { return &avx512Kernel<LEFT, RIGHT, RESULT, OP, LAYOUT>; }
+};
+#endif
+
+/**
+ * This function returns the reduction of an instruction set (`KERNEL`) for an operator.
+ */
+template<class TYPE, template<class, ReductionOperator> class KERNEL>
+ReductionKernel<TYPE> selectReduction(ReductionOperator op) {
+    switch (op) {
+        case ReductionOperator::SUM: return KERNEL<TYPE, ReductionOperator::SUM>::get();
+        case ReductionOperator::ABSOLUTE_SUM: return KERNEL<TYPE, ReductionOperator::ABSOLUTE_SUM>::get();
+        case ReductionOperator::SQUARED_SUM: return KERNEL<TYPE, ReductionOperator::SQUARED_SUM>::get();
+        case ReductionOperator::PRODUCT: return KERNEL<TYPE, ReductionOperator::PRODUCT>::get();
+        case ReductionOperator::MIN: return KERNEL<TYPE, ReductionOperator::MIN>::get();
+        default: return KERNEL<TYPE, ReductionOperator::MAX>::get();
+    }
+}
+
+template<class TYPE, ReductionOperator OP>
+struct ScalarReduction {
+    static ReductionKernel<TYPE> get() { return &scalarReduction<TYPE, OP>; }
+};
+
+#ifdef ARRAY_SIMD_X86
+template<class TYPE, ReductionOperator OP>
+struct Sse2Reduction {
+    static ReductionKernel<TYPE> get() { return &vectorReduction<TYPE, OP, sse2Reduction<TYPE, OP>>; }
+};
+
+template<class TYPE, ReductionOperator OP>
+struct Avx2Reduction {
+    static ReductionKernel<TYPE> get() { return &vectorReduction<TYPE, OP, avx2Reduction<TYPE, OP>>; }
+};
+
+template<class TYPE, ReductionOperator OP>
+struct Avx512Reduction {
+    static ReductionKernel<TYPE> get() { return &vectorReduction<TYPE, OP, avx512Reduction<TYPE, OP>>; }
+};
+#endif
+
+/**
+ * This function returns the measure of an instruction set (`KERNEL`) for an operator.
+ */
+template<class TYPE, template<class, DistanceOperator> class KERNEL>
+DistanceKernel<TYPE> selectDistance(DistanceOperator op) {
+    switch (op) {
+        case DistanceOperator::DOT: return KERNEL<TYPE, DistanceOperator::DOT>::get();
+        case DistanceOperator::SQUARED_L2: return KERNEL<TYPE, DistanceOperator::SQUARED_L2>::get();
+        default: return KERNEL<TYPE, DistanceOperator::COSINE>::get();
+    }
+}
+
+template<class TYPE, DistanceOperator OP>
+struct ScalarDistance {
+    static DistanceKernel<TYPE> get() { return &scalarDistance<TYPE, OP>; }
+};
+
+#ifdef ARRAY_SIMD_X86
+template<class TYPE, DistanceOperator OP>
+struct Sse2Distance {
+    static DistanceKernel<TYPE> get() { return &sse2Distance<TYPE, OP>; }
+};
+
+template<class TYPE, DistanceOperator OP>
+struct Avx2Distance {
+    static DistanceKernel<TYPE> get() { return &avx2Distance<TYPE, OP>; }
+};
+
+template<class TYPE, DistanceOperator OP>
+struct Avx512Distance {
+    static DistanceKernel<TYPE> get() { return &avx512Distance<TYPE, OP>; }
+};
+#endif
+
+}
+
+SimdLevel ArraySimd::getSupportedLevel() {
+    static const SimdLevel level = detectLevel();
+    return level;
+}
+
+SimdLevel ArraySimd::getLevel() {
+    return currentLevel().load(std::memory_order_relaxed);
+}
+
+void ArraySimd::setLevel(SimdLevel level) {
+    currentLevel().store(std::min(level, getSupportedLevel()), std::memory_order_relaxed);
+}
+
+template<class TYPE, class OP>
+BinaryKernel<TYPE> ArraySimd::getBinaryKernel(OperandLayout layout) {
+    return getPromotingKernel<TYPE, TYPE, TYPE, OP>(layout);
+}
+
+template<class LEFT, class RIGHT, class RESULT, class OP>
+PromotingKernel<LEFT, RIGHT, RESULT> ArraySimd::getPromotingKernel(OperandLayout layout) {
+#ifdef ARRAY_SIMD_X86
+    // Use the highest level that supports this operation, otherwise try the next lower one
+    switch (getLevel()) {
+        case SimdLevel::AVX512:
+            if constexpr (isSupported<Avx512<RESULT>, OP, LEFT, RIGHT>()) return selectLayout<LEFT, RIGHT, RESULT, OP, Avx512Kernel>(layout);
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if constexpr (isSupported<Avx2<RESULT>, OP, LEFT, RIGHT>()) return selectLayout<LEFT, RIGHT, RESULT, OP, Avx2Kernel>(layout);
+            [[fallthrough]];
+        case SimdLevel::SSE2:
+            if constexpr (isSupported<Sse2<RESULT>, OP, LEFT, RIGHT>()) return selectLayout<LEFT, RIGHT, RESULT, OP, Sse2Kernel>(layout);
+            [[fallthrough]];
+        default:
+            break;
+    }
+#endif
+    return selectLayout<LEFT, RIGHT, RESULT, OP, Scalar>(layout);
+}
+
+template BinaryKernel<int32_t> ArraySimd::getBinaryKernel<int32_t, ArrayAddOperator>(OperandLayout);
+template BinaryKernel<int64_t> ArraySimd::getBinaryKernel<int64_t, ArrayAddOperator>(OperandLayout);
+template BinaryKernel<float> ArraySimd::getBinaryKernel<float, ArrayAddOperator>(OperandLayout);
+template BinaryKernel<double> ArraySimd::getBinaryKernel<double, ArrayAddOperator>(OperandLayout);
+template BinaryKernel<BFloat16> ArraySimd::getBinaryKernel<BFloat16, ArrayAddOperator>(OperandLayout);
+template BinaryKernel<int32_t> ArraySimd::getBinaryKernel<int32_t, ArraySubOperator>(OperandLayout);
+template BinaryKernel<int64_t> ArraySimd::getBinaryKernel<int64_t, ArraySubOperator>(OperandLayout);
+template BinaryKernel<float> ArraySimd::getBinaryKernel<float, ArraySubOperator>(OperandLayout);
+template BinaryKernel<double> ArraySimd::getBinaryKernel<double, ArraySubOperator>(OperandLayout);
+template BinaryKernel<BFloat16> ArraySimd::getBinaryKernel<BFloat16, ArraySubOperator>(OperandLayout);
+template BinaryKernel<int32_t> ArraySimd::getBinaryKernel<int32_t, ArrayMulOperator>(OperandLayout);
+template BinaryKernel<int64_t> ArraySimd::getBinaryKernel<int64_t, ArrayMulOperator>(OperandLayout);
+template BinaryKernel<float> ArraySimd::getBinaryKernel<float, ArrayMulOperator>(OperandLayout);
+template BinaryKernel<double> ArraySimd::getBinaryKernel<double, ArrayMulOperator>(OperandLayout);
+template BinaryKernel<BFloat16> ArraySimd::getBinaryKernel<BFloat16, ArrayMulOperator>(OperandLayout);
+template BinaryKernel<int32_t> ArraySimd::getBinaryKernel<int32_t, ArrayDivOperator>(OperandLayout);
+template BinaryKernel<int64_t> ArraySimd::getBinaryKernel<int64_t, ArrayDivOperator>(OperandLayout);
+template BinaryKernel<float> ArraySimd::getBinaryKernel<float, ArrayDivOperator>(OperandLayout);
+template BinaryKernel<double> ArraySimd::getBinaryKernel<double, ArrayDivOperator>(OperandLayout);
+template BinaryKernel<BFloat16> ArraySimd::getBinaryKernel<BFloat16, ArrayDivOperator>(OperandLayout);
+
+// The kernels for every pair of operand types (see `Array::getPromotedType`)
+#define ARRAY_SIMD_PROMOTING_KERNELS(LEFT, RIGHT, RESULT) \
+template PromotingKernel<LEFT, RIGHT, RESULT> ArraySimd::getPromotingKernel<LEFT, RIGHT, RESULT, ArrayAddOperator>(OperandLayout); \
+template PromotingKernel<LEFT, RIGHT, RESULT> ArraySimd::getPromotingKernel<LEFT, RIGHT, RESULT, ArraySubOperator>(OperandLayout); \
+template PromotingKernel<LEFT, RIGHT, RESULT> ArraySimd::getPromotingKernel<LEFT, RIGHT, RESULT, ArrayMulOperator>(OperandLayout); \
+template PromotingKernel<LEFT, RIGHT, RESULT> ArraySimd::getPromotingKernel<LEFT, RIGHT, RESULT, ArrayDivOperator>(OperandLayout);
+
+ARRAY_SIMD_PROMOTING_KERNELS(int32_t, int32_t, int32_t)
+ARRAY_SIMD_PROMOTING_KERNELS(int64_t, int64_t, int64_t)
+ARRAY_SIMD_PROMOTING_KERNELS(BFloat16, BFloat16, BFloat16)
+ARRAY_SIMD_PROMOTING_KERNELS(float, float, float)
+ARRAY_SIMD_PROMOTING_KERNELS(double, double, double)
+ARRAY_SIMD_PROMOTING_KERNELS(int32_t, int64_t, int64_t)
+ARRAY_SIMD_PROMOTING_KERNELS(int64_t, int32_t, int64_t)
+ARRAY_SIMD_PROMOTING_KERNELS(int32_t, BFloat16, double)
+ARRAY_SIMD_PROMOTING_KERNELS(BFloat16, int32_t, double)
+ARRAY_SIMD_PROMOTING_KERNELS(int32_t, float, double)
+ARRAY_SIMD_PROMOTING_KERNELS(float, int32_t, double)
+ARRAY_SIMD_PROMOTING_KERNELS(int32_t, double, double)
+ARRAY_SIMD_PROMOTING_KERNELS(double, int32_t, double)
+ARRAY_SIMD_PROMOTING_KERNELS(int64_t, BFloat16, double)
+ARRAY_SIMD_PROMOTING_KERNELS(BFloat16, int64_t, double)
+ARRAY_SIMD_PROMOTING_KERNELS(int64_t, float, double)
+ARRAY_SIMD_PROMOTING_KERNELS(float, int64_t, double)
+ARRAY_SIMD_PROMOTING_KERNELS(int64_t, double, double)
+ARRAY_SIMD_PROMOTING_KERNELS(double, int64_t, double)
+ARRAY_SIMD_PROMOTING_KERNELS(BFloat16, float, float)
+ARRAY_SIMD_PROMOTING_KERNELS(float, BFloat16, float)
+ARRAY_SIMD_PROMOTING_KERNELS(BFloat16, double, double)
+ARRAY_SIMD_PROMOTING_KERNELS(double, BFloat16, double)
+ARRAY_SIMD_PROMOTING_KERNELS(float, double, double)
+ARRAY_SIMD_PROMOTING_KERNELS(double, float, double)
+
+template<class TYPE>
+ReductionKernel<TYPE> ArraySimd::getReductionKernel(ReductionOperator op) {
+#ifdef ARRAY_SIMD_X86
+    // Integers are reduced with wider accumulators (no vector instructions)
+    if constexpr (isFloatingPoint<TYPE>()) {
+        switch (getLevel()) {
+            case SimdLevel::AVX512: return selectReduction<TYPE, Avx512Reduction>(op);
+            case SimdLevel::AVX2: return selectReduction<TYPE, Avx2Reduction>(op);
+            case SimdLevel::SSE2: return selectReduction<TYPE, Sse2Reduction>(op);
+            default: break;
+        }
+    }
+#endif
+    return selectReduction<TYPE, ScalarReduction>(op);
+}
+
+template ReductionKernel<int32_t> ArraySimd::getReductionKernel<int32_t>(ReductionOperator);
+template ReductionKernel<int64_t> ArraySimd::getReductionKernel<int64_t>(ReductionOperator);
+template ReductionKernel<float> ArraySimd::getReductionKernel<float>(ReductionOperator);
+template ReductionKernel<double> ArraySimd::getReductionKernel<double>(ReductionOperator);
+template ReductionKernel<BFloat16> ArraySimd::getReductionKernel<BFloat16>(ReductionOperator);
+
+template<class TYPE>
+DistanceKernel<TYPE> ArraySimd::getDistanceKernel(DistanceOperator op) {
+#ifdef ARRAY_SIMD_X86
+    switch (getLevel()) {
+        case SimdLevel::AVX512: return selectDistance<TYPE, Avx512Distance>(op);
+        case SimdLevel::AVX2: return selectDistance<TYPE, Avx2Distance>(op);
+        case SimdLevel::SSE2: return selectDistance<TYPE, Sse2Distance>(op);
+        default: break;
+    }
+#endif
+    return selectDistance<TYPE, ScalarDistance>(op);
+}
+
+template DistanceKernel<float> ArraySimd::getDistanceKernel<float>(DistanceOperator);
+template DistanceKernel<double> ArraySimd::getDistanceKernel<double>(DistanceOperator);
+template DistanceKernel<BFloat16> ArraySimd::getDistanceKernel<BFloat16>(DistanceOperator);
+
+StructuralKernel ArraySimd::getStructuralKernel() {
+#ifdef ARRAY_SIMD_X86
+    switch (getLevel()) {
+        // Byte comparisons with AVX-512 require AVX-512BW, so AVX2 is used instead
+        case SimdLevel::AVX512:
+        case SimdLevel::AVX2: return &avx2Structurals;
+        case SimdLevel::SSE2: return &sse2Structurals;
+        default: break;
+    }
+#endif
+    return &scalarStructurals;
+}
@@ -25,9 +25,9 @@ lingodb::runtime::VarLen32 Array::slice(int32_t lowerBound, int32_t upperBound,
     
     const auto *start = this->widths;
     getArraySlice(widths, widthSize, elementIdx, lowerBound, upperBound, dimension, 1, start);
-    // Update width of first dimension
+    // Update width of first dimension (one-dimensional arrays store the number of elements)
     widthSize[0] = 1;
-    widths.insert(widths.begin(), widthSize[1]);
+    widths.insert(widths.begin(), this->dimensions == 1 ? elementIdx.size() : widthSize[1]);
     nulls.reserve(elementIdx.size());
 
     // Based on element indicies, fill NULL vector and string length vector
@@ -43,25 +43,23 @@ lingodb::runtime::VarLen32 Array::slice(int32_t lowerBound, int32_t upperBound,
 
     // If slice did not include any elements, return empty array which has only one dimension
     auto dimensions = elementIdx.size() == 0 ? 1 : this->dimensions;
+    // An empty array has a single width entry
+    uint32_t widthCount = elementIdx.size() == 0 ? 1 : widths.size();
 
     // Define result string
-    std::string result;
     size_t size = getStringSize(
         dimensions,
         numberElements,
-        widths.size(),
+        widthCount,
         getNullBytes(nulls.size()),
         stringLengths,
         type
     );
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
 
     // Write array data into string
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &dimensions, 1);
-    writeToBuffer(buffer, &numberElements, 1);
+    writeHeader(buffer, this->type, dimensions, numberElements, nulls.size(), widthCount, stringLengths);
 
     // Iterate over each dimension to update dimension indices
     for (uint32_t i = 0; i < dimensions; i++) {
@@ -88,6 +86,7 @@ lingodb::runtime::VarLen32 Array::slice(int32_t lowerBound, int32_t upperBound,
         // Otherwise copy all data from widths vector
         writeToBuffer(buffer, widths.data(), widths.size());
     }
+    writePadding(buffer, dimensions, widthCount);
 
     for (auto &entry : elementIdx) {
         if (!isNull(entry)) {
@@ -104,7 +103,7 @@ lingodb::runtime::VarLen32 Array::slice(int32_t lowerBound, int32_t upperBound,
             }
         }
     }
-    return VarLen32::fromString(result);
+    return result.build();
 }
 
 void Array::getArraySlice(
@@ -40,6 +40,8 @@ lingodb::runtime::VarLen32 Array::operator[](uint32_t position) {
             toString<int32_t>(position, result);
         } else if (type == ArrayType::INTEGER64) {
             toString<int64_t>(position, result);
+        } else if (type == ArrayType::BFLOAT) {
+            toString<BFloat16>(position, result);
         } else if (type == ArrayType::FLOAT) {
             toString<float>(position, result);
         } else if (type == ArrayType::DOUBLE) {
@@ -76,14 +78,11 @@ lingodb::runtime::VarLen32 Array::operator[](uint32_t position) {
         stringLengths,
         type
     );
-    result.resize(size);
-    char *buffer = result.data();
+    ArrayBuilder builder(size);
+    char *buffer = builder.getBuffer();
 
     // Write array data into string
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &dimensions, 1);
-    writeToBuffer(buffer, &numberElements, 1);
+    writeHeader(buffer, this->type, dimensions, numberElements, nulls.size(), widths.size(), stringLengths);
     
     if (elementIdx.size() == 0) {
         // If empty array structures are returned, use default index
@@ -98,6 +97,7 @@ lingodb::runtime::VarLen32 Array::operator[](uint32_t position) {
 
     writeToBuffer(buffer, widthSize.data(), dimensions);
     writeToBuffer(buffer, widths.data(), widths.size());
+    writePadding(buffer, dimensions, widths.size());
 
     for (auto &entry : elementIdx) {
         if (!isNull(entry)) {
@@ -114,5 +114,5 @@ lingodb::runtime::VarLen32 Array::operator[](uint32_t position) {
             }
         }
     }
-    return VarLen32::fromString(result);
+    return builder.build();
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "../include/ArrayThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+using lingodb::runtime::ArrayThreadPool;
+
+namespace {
+// The number of chunks the current thread is executing (nested operations are not split)
+thread_local uint32_t chunkDepth = 0;
+}
+
+ArrayThreadPool::ArrayThreadPool() : threshold(DEFAULT_THRESHOLD), pending(0), stopping(false) {
+    auto hardwareThreads = std::thread::hardware_concurrency();
+    this->threadCount = hardwareThreads == 0 ? 1 : hardwareThreads;
+}
+
+ArrayThreadPool::~ArrayThreadPool() {
+    std::unique_lock<std::shared_mutex> guard(this->lifecycle);
+    stop();
+}
+
+ArrayThreadPool &ArrayThreadPool::get() {
+    static ArrayThreadPool pool;
+    return pool;
+}
+
+void ArrayThreadPool::setThreadCount(uint32_t count) {
+    // The running operation of a chunk would never finish while waiting for it
+    if (chunkDepth > 0) {
+        throw std::runtime_error("Array-ThreadPool: The number of threads cannot be changed inside a parallel operation");
+    }
+    if (count == 0) {
+        auto hardwareThreads = std::thread::hardware_concurrency();
+        count = hardwareThreads == 0 ? 1 : hardwareThreads;
+    }
+    // Waits until the running operations are finished
+    std::unique_lock<std::shared_mutex> guard(this->lifecycle);
+    if (count == this->threadCount) return;
+    // The workers are started again by the next parallel operation
+    stop();
+    this->threadCount = count;
+}
+
+uint32_t ArrayThreadPool::getThreadCount() {
+    return this->threadCount;
+}
+
+void ArrayThreadPool::setThreshold(size_t elements) {
+    this->threshold = elements;
+}
+
+size_t ArrayThreadPool::getThreshold() {
+    return this->threshold;
+}
+
+bool ArrayThreadPool::isParallel(size_t elements) {
+    return chunkDepth == 0 && elements > CHUNK_SIZE && elements >= this->threshold && this->threadCount > 1;
+}
+
+void ArrayThreadPool::start() {
+    if (!this->workers.empty()) return;
+    this->stopping = false;
+    size_t workerCount = this->threadCount - 1;
+    while (this->queues.size() < workerCount) {
+        this->queues.push_back(std::make_unique<Queue>());
+    }
+    this->workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        this->workers.emplace_back(&ArrayThreadPool::work, this, i);
+    }
+}
+
+void ArrayThreadPool::stop() {
+    if (this->workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> guard(this->sleepMutex);
+        this->stopping = true;
+    }
+    this->wakeup.notify_all();
+    for (auto &worker : this->workers) {
+        worker.join();
+    }
+    this->workers.clear();
+    this->queues.clear();
+}
+
+void ArrayThreadPool::work(size_t index) {
+    Chunk chunk;
+    while (true) {
+        if (take(index, chunk)) {
+            run(chunk);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(this->sleepMutex);
+        this->wakeup.wait(lock, [this]() { return this->stopping || this->pending > 0; });
+        if (this->stopping) return;
+    }
+}
+
+bool ArrayThreadPool::take(size_t preferred, Chunk &chunk) {
+    size_t queueCount = this->queues.size();
+    if (preferred < queueCount) {
+        auto &queue = *this->queues[preferred];
+        std::lock_guard<std::mutex> guard(queue.mutex);
+        if (!queue.chunks.empty()) {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+            this->pending--;
+            return true;
+        }
+    }
+    // Steal from the back of the other queues (the chunks furthest away from their owner)
+    for (size_t i = 1; i <= queueCount; i++) {
+        auto &queue = *this->queues[(preferred + i) % queueCount];
+        std::lock_guard<std::mutex> guard(queue.mutex);
+        if (!queue.chunks.empty()) {
+            chunk = queue.chunks.back();
+            queue.chunks.pop_back();
+            this->pending--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ArrayThreadPool::run(Chunk &chunk) {
+    Job &job = *chunk.job;
+    chunkDepth++;
+    try {
+        (*job.task)(chunk.begin, chunk.end);
+    } catch (...) {
+        std::lock_guard<std::mutex> guard(job.mutex);
+        if (!job.error || chunk.index < job.errorChunk) {
+            job.error = std::current_exception();
+            job.errorChunk = chunk.index;
+        }
+    }
+    chunkDepth--;
+    // The job is owned by the waiting thread, so it must not be accessed after the lock is released
+    std::lock_guard<std::mutex> guard(job.mutex);
+    if (--job.remaining == 0) {
+        job.finished.notify_all();
+    }
+}
+
+void ArrayThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)> &task) {
+    if (count == 0) return;
+    if (!isParallel(count)) {
+        task(0, count);
+        return;
+    }
+    execute(count, CHUNK_SIZE, task);
+}
+
+void ArrayThreadPool::parallelForUnits(size_t count, size_t work, const std::function<void(size_t, size_t)> &task) {
+    if (count == 0) return;
+    if (!isParallel(count * work)) {
+        task(0, count);
+        return;
+    }
+    execute(count, std::max<size_t>(1, CHUNK_SIZE / std::max<size_t>(1, work)), task);
+}
+
+void ArrayThreadPool::execute(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)> &task) {
+    // The workers are not stopped while this operation is executed
+    std::shared_lock<std::shared_mutex> lifecycleLock(this->lifecycle);
+    {
+        std::lock_guard<std::mutex> guard(this->startMutex);
+        start();
+    }
+    if (this->workers.empty()) {
+        task(0, count);
+        return;
+    }
+    size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    size_t queueCount = this->queues.size();
+
+    Job job;
+    job.task = &task;
+    job.remaining = chunkCount;
+    job.errorChunk = 0;
+    {
+        std::lock_guard<std::mutex> guard(this->sleepMutex);
+        this->pending += chunkCount;
+    }
+    // Every worker receives a contiguous part of the chunks
+    for (size_t q = 0; q < queueCount; q++) {
+        size_t first = q * chunkCount / queueCount;
+        size_t last = (q + 1) * chunkCount / queueCount;
+        auto &queue = *this->queues[q];
+        std::lock_guard<std::mutex> guard(queue.mutex);
+        for (size_t i = first; i < last; i++) {
+            queue.chunks.push_back(Chunk{&job, i, i * chunkSize, std::min(count, (i + 1) * chunkSize)});
+        }
+    }
+    this->wakeup.notify_all();
+
+    // The calling thread helps until no chunk is left
+    Chunk chunk;
+    while (job.remaining > 0 && take(queueCount, chunk)) {
+        run(chunk);
+    }
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.finished.wait(lock, [&job]() { return job.remaining == 0; });
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
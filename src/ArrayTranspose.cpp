@@ -1,109 +1,275 @@
 #include "../include/Array.h"
+#include <memory>
 
 using lingodb::runtime::Array;
+using lingodb::runtime::ArrayThreadPool;
 
-lingodb::runtime::VarLen32 Array::transpose() {
+namespace {
+
+// The number of elements of each side of a tile. A tile of 8-byte elements reads 32 cache
+// lines of the source and writes 32 cache lines of the target, which fit into the L1 cache.
+constexpr size_t TILE = 32;
+
+/**
+ * This struct describes how a dense (row-major) array is permuted. Every dimension of the
+ * target is described by its size and by the distance of its consecutive elements in the
+ * source. Dimensions of size one are dropped and dimensions that stay adjacent in the source
+ * are merged, so the target is read in as few and as long runs as possible.
+ */
+struct PermutationLayout {
+    std::vector<size_t> sizes;
+    std::vector<size_t> sourceStrides;
+    std::vector<size_t> targetStrides;
+
+    PermutationLayout(const std::vector<uint32_t> &shape, const std::vector<uint32_t> &axes) {
+        std::vector<size_t> strides(shape.size(), 1);
+        for (size_t i = shape.size() - 1; i > 0; i--) strides[i - 1] = strides[i] * shape[i];
+        for (auto axis : axes) {
+            if (shape[axis] == 1) continue;
+            if (!this->sizes.empty() && this->sourceStrides.back() == strides[axis] * shape[axis]) {
+                // The dimension continues the previous one in the source
+                this->sizes.back() *= shape[axis];
+                this->sourceStrides.back() = strides[axis];
+            } else {
+                this->sizes.push_back(shape[axis]);
+                this->sourceStrides.push_back(strides[axis]);
+            }
+        }
+        this->targetStrides.resize(this->sizes.size());
+        size_t stride = 1;
+        for (size_t i = this->sizes.size(); i > 0; i--) {
+            this->targetStrides[i - 1] = stride;
+            stride *= this->sizes[i - 1];
+        }
+    }
+
+    /**
+     * This method returns the source and target offset of an index over the given dimensions
+     * (the first dimension varies slowest).
+     */
+    std::pair<size_t, size_t> getOffsets(size_t index, const std::vector<size_t> &dimensions) const {
+        size_t source = 0, target = 0;
+        for (size_t i = dimensions.size(); i > 0; i--) {
+            auto dimension = dimensions[i - 1];
+            auto position = index % this->sizes[dimension];
+            index /= this->sizes[dimension];
+            source += position * this->sourceStrides[dimension];
+            target += position * this->targetStrides[dimension];
+        }
+        return {source, target};
+    }
+};
+
+/**
+ * This function executes `count` units of work of `elements` elements each. Large
+ * permutations are split across the threads of the `ArrayThreadPool`.
+ */
+template<class FUNCTION>
+void forEachUnit(size_t count, size_t elements, FUNCTION function) {
+    ArrayThreadPool::get().parallelFor(count * elements, [&](size_t begin, size_t end) {
+        // Every unit is executed by the chunk that contains its first element
+        for (size_t unit = (begin + elements - 1) / elements; unit * elements < end; unit++) function(unit);
+    });
+}
+
+/**
+ * This function writes the values of a dense source array in the order of a permutation.
+ * If the innermost dimension of the target is also contiguous in the source, runs of values
+ * are copied. Otherwise the innermost dimensions of the source and of the target form a matrix
+ * that is transposed tile by tile, so both sides are accessed along whole cache lines.
+ *
+ * @param source The values of the source.
+ * @param target The values of the target.
+ * @param layout The permutation.
+ */
+template<class TYPE>
+void permuteValues(const TYPE *source, TYPE *target, const PermutationLayout &layout) {
+    auto dimensions = layout.sizes.size();
+    if (dimensions == 0) {
+        *target = *source;
+        return;
+    }
+    auto last = dimensions - 1;
+    if (layout.sourceStrides[last] == 1) {
+        // Copy runs of the innermost dimension
+        std::vector<size_t> outer(last);
+        for (size_t i = 0; i < last; i++) outer[i] = i;
+        auto run = layout.sizes[last];
+        forEachUnit(layout.targetStrides.empty() ? 1 : layout.sizes[0] * layout.targetStrides[0] / run, run, [&](size_t unit) {
+            auto [sourceOffset, targetOffset] = layout.getOffsets(unit, outer);
+            std::copy(source + sourceOffset, source + sourceOffset + run, target + targetOffset);
+        });
+        return;
+    }
+
+    // The target dimension that is contiguous in the source (the rows of the tiles)
+    size_t row = 0;
+    while (layout.sourceStrides[row] != 1) row++;
+    std::vector<size_t> outer;
+    size_t outerCount = 1;
+    for (size_t i = 0; i < last; i++) {
+        if (i == row) continue;
+        outer.push_back(i);
+        outerCount *= layout.sizes[i];
+    }
+    auto rows = layout.sizes[row];
+    auto columns = layout.sizes[last];
+    auto sourceStride = layout.sourceStrides[last];
+    auto targetStride = layout.targetStrides[row];
+    auto rowTiles = (rows + TILE - 1) / TILE;
+    forEachUnit(outerCount * rowTiles, TILE * columns, [&](size_t unit) {
+        auto [sourceOffset, targetOffset] = layout.getOffsets(unit / rowTiles, outer);
+        auto firstRow = unit % rowTiles * TILE;
+        auto lastRow = std::min(rows, firstRow + TILE);
+        const TYPE *from = source + sourceOffset;
+        TYPE *to = target + targetOffset;
+        for (size_t firstColumn = 0; firstColumn < columns; firstColumn += TILE) {
+            auto lastColumn = std::min(columns, firstColumn + TILE);
+            for (size_t i = firstRow; i < lastRow; i++) {
+                for (size_t j = firstColumn; j < lastColumn; j++) {
+                    to[i * targetStride + j] = from[i + j * sourceStride];
+                }
+            }
+        }
+    });
+}
+
+}
+
+template<class TYPE>
+void Array::permuteElements(char *&buffer, const std::vector<uint32_t> &shape, const std::vector<uint32_t> &axes) {
+    PermutationLayout layout(shape, axes);
+    auto *values = reinterpret_cast<const TYPE*>(this->elements);
+    auto *target = reinterpret_cast<TYPE*>(buffer);
+    if (this->size == this->totalSize) {
+        permuteValues(values, target, layout);
+        buffer += sizeof(TYPE) * this->size;
+        copyNulls(buffer, this->nulls, this->totalSize, 0);
+        return;
+    }
+
+    if (this->size == 0) {
+        // Every position is NULL, so the bitmap does not change
+        copyNulls(buffer, this->nulls, this->totalSize, 0);
+        return;
+    }
+
+    // NULL positions have no element, so the elements are expanded to all positions and the
+    // NULL flags are permuted with the same layout
+    std::unique_ptr<TYPE[]> dense(new TYPE[this->totalSize]);
+    std::unique_ptr<TYPE[]> permuted(new TYPE[this->totalSize]);
+    std::unique_ptr<uint8_t[]> flags(new uint8_t[this->totalSize]);
+    std::unique_ptr<uint8_t[]> permutedFlags(new uint8_t[this->totalSize]);
+    // The NULL flags are unpredictable, so both loops avoid branches on them. NULL positions
+    // repeat a valid element, which is dropped again by the compaction.
+    auto last = this->size - 1;
+    for (uint32_t i = 0, element = 0; i < this->totalSize; i++) {
+        flags[i] = (this->nulls[i / 8] >> (7 - i % 8)) & 1;
+        dense[i] = values[std::min(element, last)];
+        element += 1 - flags[i];
+    }
+    permuteValues(dense.get(), permuted.get(), layout);
+    permuteValues(flags.get(), permutedFlags.get(), layout);
+    auto *end = target + this->size;
+    for (uint32_t i = 0; target != end; i++) {
+        *target = permuted[i];
+        target += 1 - permutedFlags[i];
+    }
+    buffer = reinterpret_cast<char*>(target);
+    for (uint32_t i = 0; i < this->totalSize; i += 8) {
+        uint8_t byte = 0;
+        for (uint32_t j = i; j < std::min(this->totalSize, i + 8); j++) byte |= permutedFlags[j] << (7 - j % 8);
+        *buffer++ = static_cast<char>(byte);
+    }
+}
+
+lingodb::runtime::VarLen32 Array::executePermutation(const std::vector<uint32_t> &shape, const std::vector<int32_t> &indices, const std::vector<uint32_t> &axes) {
+    // The target has the dimensions of the source in the order of `axes`
+    auto dimensions = static_cast<uint32_t>(shape.size());
+    std::vector<uint32_t> sizes(dimensions);
+    std::vector<int32_t> targetIndices(dimensions);
+    for (uint32_t i = 0; i < dimensions; i++) {
+        sizes[i] = shape[axes[i]];
+        targetIndices[i] = indices[axes[i]];
+    }
+    auto widthSize = getRectangularWidthSize(sizes);
+
+    auto size = getStringSize(dimensions, this->size, widthSize, getNullBytes(this->totalSize), 0, this->type);
+    ArrayBuilder result(size);
+    char *buffer = result.getBuffer();
+
+    writeHeader(buffer, this->type, dimensions, this->size, this->totalSize, widthSize, 0);
+    writeRectangularStructure(buffer, sizes, targetIndices);
+
+    // The elements are only moved, so they are permuted by their size
+    auto elementSize = getTypeSize(this->type);
+    if (elementSize == 2) {
+        permuteElements<uint16_t>(buffer, shape, axes);
+    } else if (elementSize == 4) {
+        permuteElements<uint32_t>(buffer, shape, axes);
+    } else {
+        permuteElements<uint64_t>(buffer, shape, axes);
+    }
+    return result.build();
+}
+
+void Array::checkPermutation(const std::string &operation) {
     if (!isNumericType(this->type)) {
-        throw std::runtime_error("Array-Tranypose: This function is only supported with numeric element types");
+        throw std::runtime_error("Array-" + operation + ": This function is only supported with numeric element types");
     }
     if (hasEmptyValue()) {
-        throw std::runtime_error("Array-Transpose: This function does not allow any empty array structures");
+        throw std::runtime_error("Array-" + operation + ": This function does not allow any empty array structures");
     }
     if (!isSymmetric()) {
-        throw std::runtime_error("Array-Transpose: This function allows only symmetric arrays");
-    }
-
-    // One dimensional arrays will increase their dimension, otherwise it remains
-    auto dimension = this->dimensions == 1 ? 2 : this->dimensions;
-    auto totalElements = getSize(true);
-    auto widthSize = 0;
-    if (this->dimensions == 1) widthSize = 1 + getWidthSize();
-    // Remove old widthSize and replace it with new one
-    else widthSize = getWidthSize() - getWidthSize(2) + this->widths[1];
-
-    // Create result string in set its size
-    std::string result;
-    auto size = getStringSize(dimension, this->size, widthSize, getNullBytes(totalElements), 0, this->type);
-    result.resize(size);
-    char *buffer = result.data();
-
-    writeToBuffer(buffer, ARRAYHEADER.data(), ARRAYHEADER.length());
-    writeToBuffer(buffer, &this->type, 1);
-    writeToBuffer(buffer, &dimension, 1);
-    writeToBuffer(buffer, &this->size, 1);
-    if (dimension == 1) {
-        // Create new index
-        uint32_t index = 1;
-        writeToBuffer(buffer, &index, 1);
-        writeToBuffer(buffer, this->indices, 1);
-    } else {
-        // Swap first and second index
-        writeToBuffer(buffer, &this->indices[1], 1);
-        writeToBuffer(buffer, &this->indices[0], 1);
-        writeToBuffer(buffer, &this->indices[2], dimension-2);
-    }
-    auto *widthToChange = buffer + sizeof(uint32_t);
-    uint32_t width = 1;
-    writeToBuffer(buffer, this->dimensionWidthMap, this->dimensions);
-    // If one dimensional it will get further width entries, because it will change to two dimensional
-    if (this->dimensions == 1) writeToBuffer(buffer, &width, 1);
-    // If two dimensional, override the width size with the new value
-    else *widthToChange = this->widths[1];
+        throw std::runtime_error("Array-" + operation + ": This function allows only symmetric arrays");
+    }
+}
 
-    if (this->dimensions == 1) {
-        // Create new width and copy old one
-        writeToBuffer(buffer, &width, 1);
-        writeToBuffer(buffer, &this->widths[0], 1);
-    } else {
-        // Swap first and second width
-        writeToBuffer(buffer, &this->widths[1], 1);
-        for (uint32_t i = 0; i < this->widths[1]; i++) {
-            writeToBuffer(buffer, &this->widths[0], 1);
-        }
-        if (this->dimensions > 2) {
-            // Copy unchanged widths
-            writeToBuffer(buffer, &this->widths[this->dimensionWidthMap[1]+1], getWidthSize() - (getWidthSize(1) + getWidthSize(2)));
-        }
+std::vector<uint32_t> Array::getShape() {
+    std::vector<uint32_t> shape(this->dimensions);
+    for (uint32_t i = 0; i < this->dimensions; i++) {
+        shape[i] = *getFirstWidth(i + 1);
     }
+    return shape;
+}
 
-    // If one-dimensional, copy all elements and nulls
+lingodb::runtime::VarLen32 Array::transpose() {
+    checkPermutation("Transpose");
+    auto shape = getShape();
+    std::vector<int32_t> indices(this->indices, this->indices + this->dimensions);
     if (this->dimensions == 1) {
-        copyElements(buffer);
-        copyNulls(buffer, this->nulls, totalElements, 0);
-    // If multi-dimensional, re-adjust element order
-    } else {
-        // Number columns
-        auto cols = this->widths[1];
-        // Number of elements in a row
-        uint32_t rowSize = 1;
-        for (uint32_t i = 2; i <= this->dimensions; i++) {
-            auto *width = getFirstWidth(i);
-            rowSize *= *width;
-        }
-        // Number of elements in a element 
-        // (with more than 2 dimensions an element is a complete subarray)
-        uint32_t elementSize = this->dimensions == 2 ? 1 : rowSize / this->widths[1];
-        std::vector<bool> nulls;
-
-        // Iterate over each column
-        for (size_t column = 0; column < cols; column++) {
-            // Iterate over each row
-            for (size_t row = 0; row < totalElements; row += rowSize) {
-                // Identify the value range that must be copied
-                uint32_t start = row + column * elementSize;
-                uint32_t stop = start + elementSize - 1;
-                // Iterate over each single element
-                for (size_t k = start; k <= stop; k++) {
-                    if (isNull(k)) {
-                        nulls.push_back(true);  
-                    } else {
-                        copyElement(buffer, getElementPosition(k));
-                        nulls.push_back(false);
-                    } 
-                }
-            }
+        // One dimensional arrays become a single row (a new first dimension)
+        shape.insert(shape.begin(), 1);
+        indices.insert(indices.begin(), 1);
+        return executePermutation(shape, indices, {0, 1});
+    }
+    // Swap the first and the second dimension
+    std::vector<uint32_t> axes(this->dimensions);
+    for (uint32_t i = 0; i < this->dimensions; i++) axes[i] = i;
+    std::swap(axes[0], axes[1]);
+    return executePermutation(shape, indices, axes);
+}
+
+lingodb::runtime::VarLen32 Array::permute(Array &axes) {
+    checkPermutation("Permute");
+    if (axes.getType() != ArrayType::INTEGER32 && axes.getType() != ArrayType::INTEGER64) {
+        throw std::runtime_error("Array-Permute: The axes must be integers");
+    }
+    if (axes.hasNullValue() || axes.getSize() != this->dimensions) {
+        throw std::runtime_error("Array-Permute: The axes must contain every dimension exactly once");
+    }
+    // The axes are numbered from one (like the dimensions of `slice`)
+    std::vector<uint32_t> order(this->dimensions);
+    std::vector<bool> used(this->dimensions, false);
+    for (uint32_t i = 0; i < this->dimensions; i++) {
+        auto axis = axes.getType() == ArrayType::INTEGER32 ? reinterpret_cast<const int32_t*>(axes.getElements())[i]
+                                                           : reinterpret_cast<const int64_t*>(axes.getElements())[i];
+        if (axis < 1 || axis > this->dimensions || used[axis - 1]) {
+            throw std::runtime_error("Array-Permute: The axes must contain every dimension exactly once");
         }
-        copyNulls(buffer, nulls);
+        used[axis - 1] = true;
+        order[i] = static_cast<uint32_t>(axis - 1);
     }
-    return VarLen32::fromString(result);
-}
\ No newline at end of file
+    std::vector<int32_t> indices(this->indices, this->indices + this->dimensions);
+    return executePermutation(getShape(), indices, order);
+}
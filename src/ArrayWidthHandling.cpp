@@ -2,27 +2,59 @@
 
 using lingodb::runtime::Array;
 
-uint32_t Array::getOffset(const uint32_t *width) {
-    uint32_t offset = 0;
-    auto *entries = getFirstWidth(this->dimensions);
-    auto limit = this->dimensionWidthMap[this->dimensions-1];
-    // Iterate over each width of last dimension
-    for (uint32_t i = 0; i < limit; i++) {
-        // Compare pointer
-        if (entries + i == width) return offset;
-        else offset += entries[i];
+void Array::buildWidthIndex() {
+    if (!this->widthOffsets.empty()) return;
+    this->widthOffsets.resize(this->widthSize + this->dimensions);
+    // The position of the first offset of each dimension
+    std::vector<uint32_t> starts(this->dimensions + 1, 0);
+    const uint32_t *entries = this->widths;
+    for (uint32_t d = 0; d < this->dimensions; d++) {
+        auto length = this->dimensionWidthMap[d];
+        starts[d + 1] = starts[d] + length + 1;
+        // The children of a width follow the children of all previous widths of this dimension
+        uint32_t child = 0;
+        for (uint32_t i = 0; i <= length; i++) {
+            this->widthOffsets[starts[d] + i].child = child;
+            if (i < length) child += entries[i];
+        }
+        entries += length;
+    }
+    // The first element of a width is the first element of its first child (the children
+    // of the last dimension are elements). Empty widths point to the next element.
+    for (uint32_t d = this->dimensions; d > 0; d--) {
+        auto length = this->dimensionWidthMap[d - 1];
+        for (uint32_t i = 0; i <= length; i++) {
+            auto &offset = this->widthOffsets[starts[d - 1] + i];
+            if (d == this->dimensions) {
+                offset.element = offset.child;
+            } else {
+                auto last = this->dimensionWidthMap[d];
+                offset.element = this->widthOffsets[starts[d] + std::min(offset.child, last)].element;
+            }
+        }
     }
-    // If this happens, the width does not exist
-    throw std::runtime_error("Requested width does not exist");
 }
 
-uint32_t Array::getWidthSize() {
-    uint32_t result = 0;
-    // Count each value from map attribute
-    for (uint32_t i = 0; i < this->dimensions; i++) {
-        result += this->dimensionWidthMap[i];
+const Array::WidthOffset &Array::getWidthOffset(const uint32_t *width, uint32_t dimension) {
+    auto *entries = getFirstWidth(dimension);
+    if (width < entries || width >= entries + this->dimensionWidthMap[dimension-1]) {
+        throw std::runtime_error("Requested width does not exist");
     }
-    return result;
+    buildWidthIndex();
+    // Each previous dimension has one additional offset
+    return this->widthOffsets[(width - this->widths) + dimension - 1];
+}
+
+uint32_t Array::getOffset(const uint32_t *width) {
+    return getWidthOffset(width, this->dimensions).element;
+}
+
+uint32_t Array::getOffset(const uint32_t *width, uint32_t dimension) {
+    return getWidthOffset(width, dimension).element;
+}
+
+uint32_t Array::getWidthSize() {
+    return this->widthSize;
 }
 
 uint32_t Array::getWidthSize(uint32_t dimension) {
@@ -55,14 +87,10 @@ const uint32_t *Array::getChildWidth(const uint32_t *width, uint32_t dimension)
     if (width[0] == 0) return nullptr;
     auto *entries = getFirstWidth(dimension);
     auto length = this->dimensionWidthMap[dimension-1];
-    uint32_t ignore = 0;
-    // Iterate over widths of provided dimension
-    for (uint32_t i = 0; i <= length; i++) {
-        if (width == &entries[i]) return entries += length + ignore;
-        // Count values of previous widths
-        else ignore += entries[i];
-    }
-    return nullptr;
+    if (width < entries || width >= entries + length) return nullptr;
+    buildWidthIndex();
+    // Children are stored behind the widths of this dimension
+    return entries + length + this->widthOffsets[(width - this->widths) + dimension - 1].child;
 }
 
 bool Array::equalWidths(const uint32_t *other) {
@@ -1,4 +1,5 @@
 #include "../include/VarLen32.h"
+#include "../include/ArrayAllocator.h"
 #include "cstring"
 
 using lingodb::runtime::VarLen32;
@@ -9,15 +10,23 @@ VarLen32::VarLen32(uint8_t *ptr, uint32_t len) {
 }
 
 VarLen32::~VarLen32() {
-    //delete[] this->ptr;
+    // Memory belongs to the allocator and is released in bulk
 }
 
 VarLen32 VarLen32::fromString(std::string value) {
-    auto *ptr = new uint8_t[value.size()];
+    auto *ptr = ArrayAllocator::get().allocate(value.size());
     memcpy(ptr, value.data(), value.size());
     return VarLen32(ptr, value.size());
 }
 
 std::string VarLen32::str() {
     return std::string((char *) this->ptr, this->len);
+}
+
+uint8_t *VarLen32::getPtr() {
+    return this->ptr;
+}
+
+uint32_t VarLen32::getLen() {
+    return this->len;
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "ArrayTest.h"
+#include "ArrayAllocator.h"
+#include <algorithm>
+
+using lingodb::runtime::ArenaAllocator;
+using lingodb::runtime::ArrayAllocator;
+
+ARRAY_TEST(ArrayAllocator, ResetDefault) {
+    // Without a scope every result is taken from the default arena until it is reset
+    ArrayAllocator::resetDefault();
+    auto &allocator = ArrayAllocator::get();
+    auto reserved = allocator.getReservedBytes();
+    for (size_t i = 0; i < 64; i++) allocator.allocate(ArenaAllocator::MAX_CHUNK_SIZE / 4);
+    ARRAY_EXPECT(allocator.getReservedBytes() > 8 * ArenaAllocator::MAX_CHUNK_SIZE);
+    ArrayAllocator::resetDefault();
+    ARRAY_EXPECT(allocator.getReservedBytes() <= std::max(reserved, static_cast<uint64_t>(ArenaAllocator::MAX_CHUNK_SIZE)));
+
+    // An installed allocator is not affected
+    ArenaAllocator arena;
+    {
+        ArrayAllocator::Scope scope(arena);
+        ARRAY_EXPECT(&ArrayAllocator::get() == &arena);
+        ArrayAllocator::get().allocate(100);
+        ArrayAllocator::resetDefault();
+        ARRAY_EXPECT(arena.getReservedBytes() == ArenaAllocator::MIN_CHUNK_SIZE);
+    }
+    ARRAY_EXPECT(&ArrayAllocator::get() == &allocator);
+}
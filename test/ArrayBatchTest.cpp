@@ -0,0 +1,39 @@
+#include "ArrayTest.h"
+
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::test::createLiteral;
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+using lingodb::runtime::test::print;
+
+ARRAY_TEST(ArrayBatch, OperationsLikeSingleCalls) {
+    // Pairs without NULL values and with NULL values in one or both arrays, across 64-bit words
+    const std::vector<std::pair<size_t, size_t>> nulls = {{0, 0}, {3, 0}, {0, 5}, {3, 5}, {64, 0}, {7, 7}};
+    for (int32_t type : {ElementType::INTEGER32, ElementType::INTEGER64, ElementType::FLOAT, ElementType::DOUBLE}) {
+        std::vector<VarLen32> left, right;
+        for (uint32_t size : {1u, 3u, 63u, 64u, 65u, 130u}) {
+            for (auto &[leftNulls, rightNulls] : nulls) {
+                auto value = [](size_t every, size_t offset) {
+                    return [=](size_t i) { return every != 0 && i % every == every - 1 ? std::string() : std::to_string(static_cast<int64_t>(i + offset) % 23 - 11); };
+                };
+                left.push_back(parse(createLiteral({2, size}, value(leftNulls, 0)), type));
+                right.push_back(parse(createLiteral({2, size}, value(rightNulls, 5)), type));
+            }
+        }
+        std::vector<VarLen32> sums(left), products(left);
+        ArrayRuntime::add(left.data(), right.data(), left.size(), type, sums.data());
+        ArrayRuntime::mul(left.data(), right.data(), left.size(), type, products.data());
+        for (size_t i = 0; i < left.size(); i++) {
+            ARRAY_EXPECT(print(sums[i], type) == print(ArrayRuntime::add(left[i], right[i], type, type), type));
+            ARRAY_EXPECT(print(products[i], type) == print(ArrayRuntime::mul(left[i], right[i], type, type), type));
+        }
+    }
+}
+
+ARRAY_TEST(ArrayBatch, InvalidPairs) {
+    VarLen32 left[] = {parse("{1,2}", ElementType::INTEGER32), parse("{1,2}", ElementType::INTEGER32)};
+    VarLen32 right[] = {parse("{3,4}", ElementType::INTEGER32), parse("{3,4,5}", ElementType::INTEGER32)};
+    VarLen32 result[] = {left[0], left[1]};
+    ARRAY_EXPECT_THROW(ArrayRuntime::add(left, right, 2, ElementType::INTEGER32, result), std::runtime_error);
+}
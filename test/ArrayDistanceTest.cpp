@@ -0,0 +1,34 @@
+#include "ArrayTest.h"
+
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+
+ARRAY_TEST(ArrayDistance, CosineSimilarity) {
+    for (int32_t type : {ElementType::BFLOAT, ElementType::FLOAT, ElementType::DOUBLE}) {
+        auto left = parse("{1,0,1}", type);
+        auto right = parse("{1,1,0}", type);
+        ARRAY_EXPECT_NEAR(ArrayRuntime::cosineSimilarity(left, right, type, type), 0.5, 1e-6);
+        ARRAY_EXPECT_NEAR(ArrayRuntime::cosineSimilarity(left, left, type, type), 1.0, 1e-6);
+    }
+}
+
+ARRAY_TEST(ArrayDistance, CosineSimilarityOfZeroVector) {
+    for (int32_t type : {ElementType::BFLOAT, ElementType::FLOAT, ElementType::DOUBLE}) {
+        auto zero = parse("{0,0,0}", type);
+        auto other = parse("{1,2,3}", type);
+        ARRAY_EXPECT_THROW(ArrayRuntime::cosineSimilarity(zero, other, type, type), std::runtime_error);
+        ARRAY_EXPECT_THROW(ArrayRuntime::cosineSimilarity(other, zero, type, type), std::runtime_error);
+        ARRAY_EXPECT_THROW(ArrayRuntime::cosineSimilarity(zero, zero, type, type), std::runtime_error);
+    }
+}
+
+ARRAY_TEST(ArrayDistance, BatchCosineSimilarityOfZeroVector) {
+    VarLen32 left[] = {parse("{1,2}", ElementType::DOUBLE), parse("{0,0}", ElementType::DOUBLE)};
+    VarLen32 right[] = {parse("{2,4}", ElementType::DOUBLE), parse("{1,1}", ElementType::DOUBLE)};
+    double result[2];
+    ArrayRuntime::cosineSimilarity(left, right, 1, ElementType::DOUBLE, result);
+    ARRAY_EXPECT_NEAR(result[0], 1.0, 1e-12);
+    ARRAY_EXPECT_THROW(ArrayRuntime::cosineSimilarity(left, right, 2, ElementType::DOUBLE, result), std::runtime_error);
+}
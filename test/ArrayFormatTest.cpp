@@ -0,0 +1,98 @@
+#include "ArrayTest.h"
+#include <cstring>
+
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+using lingodb::runtime::test::print;
+
+namespace {
+
+// The version tag of the binary format (version 1 stores the element type at its position)
+constexpr uint8_t FORMAT_VERSION = 0x82;
+
+/**
+ * This class writes an array in version 1 of the binary format: the identifier, the type,
+ * the number of dimensions and of elements (without NULL values), indices, dimension width
+ * map, widths, elements, NULL bits and strings (without counts, offsets or padding).
+ */
+class VersionOneWriter {
+    std::string buffer;
+
+    template<class TYPE>
+    void write(const std::vector<TYPE> &values) {
+        this->buffer.append(reinterpret_cast<const char*>(values.data()), sizeof(TYPE) * values.size());
+    }
+
+    public:
+    VersionOneWriter(int32_t type, uint32_t dimensions, uint32_t size) : buffer("array") {
+        this->buffer.push_back(static_cast<char>(type));
+        write(std::vector<uint32_t>{dimensions, size});
+    }
+
+    VersionOneWriter &indices(const std::vector<int32_t> &values) { write(values); return *this; }
+    VersionOneWriter &widths(const std::vector<uint32_t> &values) { write(values); return *this; }
+    template<class TYPE>
+    VersionOneWriter &elements(const std::vector<TYPE> &values) { write(values); return *this; }
+    VersionOneWriter &nulls(const std::vector<uint8_t> &values) { write(values); return *this; }
+    VersionOneWriter &strings(const std::string &values) { this->buffer += values; return *this; }
+
+    VarLen32 build() { return VarLen32::fromString(this->buffer); }
+};
+
+/**
+ * This function checks that an array in version 1 is read like the array of its literal and
+ * that its literal is parsed into an array in version 2.
+ */
+void checkRoundTrip(VarLen32 versionOne, int32_t type, const std::string &literal) {
+    ARRAY_EXPECT(static_cast<uint8_t>(versionOne.str()[5]) != FORMAT_VERSION);
+    ARRAY_EXPECT(print(versionOne, type) == literal);
+    auto versionTwo = parse(print(versionOne, type), type);
+    ARRAY_EXPECT(static_cast<uint8_t>(versionTwo.str()[5]) == FORMAT_VERSION);
+    ARRAY_EXPECT(print(versionTwo, type) == literal);
+    // Operations read both versions alike and write version 2
+    auto appended = ArrayRuntime::append(versionOne, type);
+    ARRAY_EXPECT(static_cast<uint8_t>(appended.str()[5]) == FORMAT_VERSION);
+    ARRAY_EXPECT(print(appended, type) == print(ArrayRuntime::append(versionTwo, type), type));
+    auto sliced = ArrayRuntime::slice(versionOne, type, 1, 1, 1);
+    ARRAY_EXPECT(print(sliced, type) == print(ArrayRuntime::slice(versionTwo, type, 1, 1, 1), type));
+}
+
+}
+
+ARRAY_TEST(ArrayFormat, VersionOneIntegers) {
+    // {{1,NULL,3},{4,5}}
+    auto array = VersionOneWriter(ElementType::INTEGER32, 2, 4)
+        .indices({1, 1})
+        .widths({1, 2, 2, 3, 2})
+        .elements(std::vector<int32_t>{1, 3, 4, 5})
+        .nulls({0b01000000})
+        .build();
+    checkRoundTrip(array, ElementType::INTEGER32, "{{1,null,3},{4,5}}");
+    ARRAY_EXPECT(ArrayRuntime::sum(array, ElementType::INTEGER32) == 13);
+}
+
+ARRAY_TEST(ArrayFormat, VersionOneDoublesWithIndices) {
+    // [0:1][-2:-1]={{1.5,2.5},{NULL,-4}}
+    auto array = VersionOneWriter(ElementType::DOUBLE, 2, 3)
+        .indices({0, -2})
+        .widths({1, 2, 2, 2, 2})
+        .elements(std::vector<double>{1.5, 2.5, -4})
+        .nulls({0b00100000})
+        .build();
+    checkRoundTrip(array, ElementType::DOUBLE, "[0:1][-2:-1]={{1.5,2.5},{null,-4}}");
+    ARRAY_EXPECT(ArrayRuntime::getHighestPosition(array, ElementType::DOUBLE) == 1);
+}
+
+ARRAY_TEST(ArrayFormat, VersionOneStrings) {
+    // {"ab",NULL,"cde",""} (string elements store their lengths)
+    auto array = VersionOneWriter(ElementType::STRING, 1, 3)
+        .indices({1})
+        .widths({1, 4})
+        .elements(std::vector<uint32_t>{2, 3, 0})
+        .nulls({0b01000000})
+        .strings("abcde")
+        .build();
+    checkRoundTrip(array, ElementType::STRING, "{\"ab\",null,\"cde\",\"\"}");
+}
@@ -0,0 +1,65 @@
+#include "ArrayGenerator.h"
+#include "ArrayTest.h"
+#include <limits>
+
+using lingodb::runtime::Array;
+using lingodb::runtime::ArrayGenerator;
+using lingodb::runtime::ArraySpecification;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::test::ElementType;
+
+namespace {
+
+/**
+ * This function generates an array of 1000 integers in `[minValue, maxValue]` and returns
+ * its elements.
+ */
+template<class TYPE>
+std::vector<TYPE> generate(int32_t type, double minValue, double maxValue) {
+    ArraySpecification specification;
+    specification.type = type;
+    specification.dimensions.push_back({1000, 1000, 1});
+    specification.minValue = minValue;
+    specification.maxValue = maxValue;
+    ArrayGenerator generator(specification, 7);
+    VarLen32 binary = generator.next();
+    Array array(binary, type);
+    auto *elements = reinterpret_cast<const TYPE*>(array.getElements());
+    return std::vector<TYPE>(elements, elements + array.getSize());
+}
+
+}
+
+ARRAY_TEST(ArrayGenerator, IntegersBeyondTheType) {
+    // Bounds beyond the type are clamped to its range
+    auto values = generate<int64_t>(ElementType::INTEGER64, -1e19, 1e19);
+    ARRAY_EXPECT(values.size() == 1000);
+    bool negative = false, positive = false;
+    for (auto value : values) {
+        negative |= value < 0;
+        positive |= value > 0;
+    }
+    ARRAY_EXPECT(negative && positive);
+
+    auto integers = generate<int32_t>(ElementType::INTEGER32, -1e19, 1e19);
+    ARRAY_EXPECT(integers.size() == 1000);
+}
+
+ARRAY_TEST(ArrayGenerator, IntegersAtTheLimits) {
+    // 2^63 (the double of the largest 64-bit integer) is clamped to the largest integer
+    for (auto value : generate<int64_t>(ElementType::INTEGER64, 9223372036854774784.0, 9223372036854775808.0)) {
+        ARRAY_EXPECT(value >= 9223372036854774784LL);
+    }
+    for (auto value : generate<int64_t>(ElementType::INTEGER64, -9223372036854775808.0, -9223372036854774784.0)) {
+        ARRAY_EXPECT(value <= -9223372036854774784LL);
+    }
+    for (auto value : generate<int64_t>(ElementType::INTEGER64, 1e19, 1e19)) {
+        ARRAY_EXPECT(value == std::numeric_limits<int64_t>::max());
+    }
+    for (auto value : generate<int32_t>(ElementType::INTEGER32, -1e10, -1e10)) {
+        ARRAY_EXPECT(value == std::numeric_limits<int32_t>::min());
+    }
+    for (auto value : generate<int32_t>(ElementType::INTEGER32, -3.5, 2.5)) {
+        ARRAY_EXPECT(value >= -3 && value <= 2);
+    }
+}
@@ -0,0 +1,30 @@
+#include "ArrayTest.h"
+#include "ArrayInstrumentation.h"
+
+using lingodb::runtime::ArrayInstrumentation;
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+
+ARRAY_TEST(ArrayInstrumentation, BatchInputs) {
+    if (!ArrayInstrumentation::isEnabled()) return;
+    VarLen32 left[] = {parse("{1,null,3}", ElementType::INTEGER32), parse("{{1,2},{3}}", ElementType::INTEGER32)};
+    VarLen32 right[] = {parse("{4,5,6}", ElementType::INTEGER32), parse("{{4,5},{6}}", ElementType::INTEGER32)};
+    VarLen32 result[] = {left[0], left[1]};
+    double sums[2];
+    uint64_t bytes = left[0].getLen() + left[1].getLen() + right[0].getLen() + right[1].getLen();
+
+    ArrayInstrumentation::reset();
+    ArrayRuntime::add(left, right, 2, ElementType::INTEGER32, result);
+    ArrayRuntime::sum(left, 2, ElementType::INTEGER32, sums);
+    auto snapshot = ArrayInstrumentation::snapshot();
+    auto &add = snapshot.operations[ArrayInstrumentation::BATCH_ADD];
+    ARRAY_EXPECT(add.calls == 1);
+    ARRAY_EXPECT(add.inputBytes == bytes);
+    ARRAY_EXPECT(add.elements == 12);
+    ARRAY_EXPECT(add.outputBytes == result[0].getLen() + result[1].getLen());
+    auto &sum = snapshot.operations[ArrayInstrumentation::BATCH_SUM];
+    ARRAY_EXPECT(sum.inputBytes == left[0].getLen() + left[1].getLen());
+    ARRAY_EXPECT(sum.elements == 6);
+}
@@ -0,0 +1,221 @@
+#include "ArrayTest.h"
+#include "ArrayThreadPool.h"
+#include <limits>
+
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::ArrayThreadPool;
+using lingodb::runtime::test::createLiteral;
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+using lingodb::runtime::test::print;
+
+namespace {
+
+// The matrix product `alpha * op(left) * op(right) + beta * accumulator` of batches of matrices
+struct Product {
+    std::vector<uint32_t> leftBatch;
+    std::vector<uint32_t> rightBatch;
+    uint32_t rows;
+    uint32_t columns;
+    uint32_t depth;
+    bool transposeLeft = false;
+    bool transposeRight = false;
+    int64_t alpha = 1;
+    bool accumulate = false;
+    int64_t beta = 0;
+};
+
+int32_t getResultType(int32_t type) {
+    if (type == ElementType::INTEGER32) return ElementType::INTEGER64;
+    if (type == ElementType::BFLOAT) return ElementType::FLOAT;
+    return type;
+}
+
+std::vector<uint32_t> getShape(const std::vector<uint32_t> &batch, uint32_t rows, uint32_t columns) {
+    auto shape = batch;
+    shape.push_back(rows);
+    shape.push_back(columns);
+    return shape;
+}
+
+size_t getCount(const std::vector<uint32_t> &shape) {
+    size_t count = 1;
+    for (auto size : shape) count *= size;
+    return count;
+}
+
+/**
+ * This function compares the product with a scalar triple loop over the elements `value(i)`
+ * of the operands. Integers wrap modulo 2^64 like in the runtime, the other types must be
+ * exact (small integers).
+ */
+void checkProduct(const Product &product, int32_t type, const std::function<int64_t(size_t)> &value) {
+    auto leftShape = product.transposeLeft ? getShape(product.leftBatch, product.depth, product.rows) : getShape(product.leftBatch, product.rows, product.depth);
+    auto rightShape = product.transposeRight ? getShape(product.rightBatch, product.columns, product.depth) : getShape(product.rightBatch, product.depth, product.columns);
+    auto batch = product.leftBatch.empty() ? product.rightBatch : product.leftBatch;
+    auto resultShape = getShape(batch, product.rows, product.columns);
+    // The operands and the accumulator take different slices of the values
+    size_t leftCount = getCount(leftShape);
+    size_t rightCount = getCount(rightShape);
+    auto toString = [](int64_t element) { return std::to_string(element); };
+    auto left = parse(createLiteral(leftShape, [&](size_t i) { return toString(value(i)); }), type);
+    auto right = parse(createLiteral(rightShape, [&](size_t i) { return toString(value(leftCount + i)); }), type);
+    auto accumulatorValue = [&](size_t i) { return value(leftCount + rightCount + i); };
+
+    std::vector<uint64_t> expected(getCount(resultShape));
+    size_t leftStride = product.leftBatch.empty() ? 0 : static_cast<size_t>(product.rows) * product.depth;
+    size_t rightStride = product.rightBatch.empty() ? 0 : static_cast<size_t>(product.depth) * product.columns;
+    for (size_t b = 0; b < getCount(batch); b++) {
+        for (uint32_t i = 0; i < product.rows; i++) {
+            for (uint32_t j = 0; j < product.columns; j++) {
+                uint64_t sum = 0;
+                for (uint32_t k = 0; k < product.depth; k++) {
+                    size_t l = b * leftStride + (product.transposeLeft ? k * product.rows + i : i * product.depth + k);
+                    size_t r = b * rightStride + (product.transposeRight ? j * product.depth + k : k * product.columns + j);
+                    sum += static_cast<uint64_t>(value(l)) * static_cast<uint64_t>(value(leftCount + r));
+                }
+                size_t position = (b * product.rows + i) * product.columns + j;
+                expected[position] = static_cast<uint64_t>(product.alpha) * sum;
+                if (product.accumulate) expected[position] += static_cast<uint64_t>(product.beta) * static_cast<uint64_t>(accumulatorValue(position));
+            }
+        }
+    }
+
+    auto resultType = getResultType(type);
+    auto multiply = [&]() {
+        if (!product.accumulate) {
+            return ArrayRuntime::matrixMul(left, right, type, type, product.transposeLeft, product.transposeRight, static_cast<double>(product.alpha));
+        }
+        auto accumulator = parse(createLiteral(resultShape, [&](size_t i) { return toString(accumulatorValue(i)); }), resultType);
+        return ArrayRuntime::matrixMulAdd(left, right, accumulator, type, type, resultType, product.transposeLeft, product.transposeRight,
+            static_cast<double>(product.alpha), static_cast<double>(product.beta));
+    };
+    auto result = multiply();
+    ARRAY_EXPECT(print(result, resultType) == createLiteral(resultShape, [&](size_t i) { return toString(static_cast<int64_t>(expected[i])); }));
+}
+
+int64_t getSmallValue(size_t i) {
+    return static_cast<int64_t>(i * 7 % 11) - 5;
+}
+
+// Values close to the limits of 32-bit integers, whose products need 64 bits
+int64_t getLargeInteger32(size_t i) {
+    return i % 3 == 0 ? std::numeric_limits<int32_t>::max() - static_cast<int64_t>(i % 5) : std::numeric_limits<int32_t>::min() + static_cast<int64_t>(i % 7);
+}
+
+// Values close to the limits of 64-bit integers, whose products wrap around
+int64_t getLargeInteger64(size_t i) {
+    return i % 2 == 0 ? std::numeric_limits<int64_t>::max() - static_cast<int64_t>(i % 9) : std::numeric_limits<int64_t>::min() / 3 + static_cast<int64_t>(i);
+}
+
+/**
+ * This function compares integer products whose sizes are not multiples of the blocks of the
+ * integer GEMM (MR = 4, NR = 8, MC = 64, KC = 256, NC = 1024) with the reference.
+ */
+void checkIntegerProducts() {
+    const std::vector<std::vector<uint32_t>> sizes = {
+        {1, 1, 1}, {3, 7, 5}, {4, 8, 256}, {5, 9, 257}, {67, 13, 300}, {130, 17, 513}, {2, 1030, 3},
+    };
+    for (auto &size : sizes) {
+        for (int transpose = 0; transpose < 4; transpose++) {
+            Product product{{}, {}, size[0], size[1], size[2]};
+            product.transposeLeft = transpose & 1;
+            product.transposeRight = transpose & 2;
+            product.alpha = -3;
+            checkProduct(product, ElementType::INTEGER32, getLargeInteger32);
+            checkProduct(product, ElementType::INTEGER64, getLargeInteger64);
+            product.accumulate = true;
+            product.beta = 5;
+            checkProduct(product, ElementType::INTEGER32, getSmallValue);
+            checkProduct(product, ElementType::INTEGER64, getLargeInteger64);
+        }
+    }
+    // Batches with a broadcast side share the packed blocks of the other side
+    Product product{{3}, {}, 9, 11, 260};
+    product.accumulate = true;
+    product.beta = 1;
+    checkProduct(product, ElementType::INTEGER32, getLargeInteger32);
+    checkProduct(product, ElementType::INTEGER64, getLargeInteger64);
+}
+
+}
+
+ARRAY_TEST(ArrayMatrixMul, BatchedLikeReference) {
+    const std::vector<std::pair<std::vector<uint32_t>, std::vector<uint32_t>>> batches = {
+        {{}, {}}, {{3}, {3}}, {{2, 3}, {2, 3}}, {{}, {2, 3}}, {{4}, {}},
+    };
+    for (int32_t type : {ElementType::INTEGER32, ElementType::INTEGER64, ElementType::BFLOAT, ElementType::FLOAT, ElementType::DOUBLE}) {
+        for (auto &[leftBatch, rightBatch] : batches) {
+            for (int transpose = 0; transpose < 4; transpose++) {
+                Product product{leftBatch, rightBatch, 5, 3, 4};
+                product.transposeLeft = transpose & 1;
+                product.transposeRight = transpose & 2;
+                checkProduct(product, type, getSmallValue);
+                product.alpha = 2;
+                product.accumulate = true;
+                product.beta = -3;
+                checkProduct(product, type, getSmallValue);
+                product.beta = 0;
+                checkProduct(product, type, getSmallValue);
+            }
+        }
+    }
+}
+
+ARRAY_TEST(ArrayMatrixMul, BatchedVectors) {
+    // One dimensional arrays are column vectors, transposed they become row vectors
+    auto matrices = parse("{{{1,2},{3,4}},{{5,6},{7,8}}}", ElementType::INTEGER64);
+    auto vector = parse("{1,-1}", ElementType::INTEGER64);
+    ARRAY_EXPECT(print(ArrayRuntime::matrixMul(matrices, vector, ElementType::INTEGER64, ElementType::INTEGER64), ElementType::INTEGER64) == "{{{-1},{-1}},{{-1},{-1}}}");
+    ARRAY_EXPECT(print(ArrayRuntime::matrixMul(vector, matrices, ElementType::INTEGER64, ElementType::INTEGER64, true, false, 1.0), ElementType::INTEGER64) == "{{{-2,-2}},{{-2,-2}}}");
+}
+
+ARRAY_TEST(ArrayMatrixMul, InvalidBatches) {
+    auto type = ElementType::DOUBLE;
+    auto twoBatches = parse(createLiteral({2, 2, 2}, [](size_t i) { return std::to_string(i); }), type);
+    auto threeBatches = parse(createLiteral({3, 2, 2}, [](size_t i) { return std::to_string(i); }), type);
+    auto nestedBatches = parse(createLiteral({2, 1, 2, 2}, [](size_t i) { return std::to_string(i); }), type);
+    auto matrix = parse("{{1,2,3},{4,5,6}}", type);
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMul(twoBatches, threeBatches, type, type), std::runtime_error);
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMul(twoBatches, nestedBatches, type, type), std::runtime_error);
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMul(matrix, twoBatches, type, type), std::runtime_error);
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMul(twoBatches, parse("{{1,2},{null,4}}", type), type, type), std::runtime_error);
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMul(twoBatches, parse("{{1,2},{3}}", type), type, type), std::runtime_error);
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMul(twoBatches, parse("{{1,2},{3,4}}", ElementType::FLOAT), type, ElementType::FLOAT), std::runtime_error);
+
+    // The accumulator needs the batches and the element type of the result
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMulAdd(twoBatches, matrix, parse("{{1,2,3},{4,5,6}}", type), type, type, type, false, false, 1.0, 1.0), std::runtime_error);
+    auto accumulator = ArrayRuntime::matrixMul(twoBatches, matrix, type, type);
+    ArrayRuntime::matrixMulAdd(twoBatches, matrix, accumulator, type, type, type, false, false, 1.0, 1.0);
+    auto integers = parse("{{1,2},{3,4}}", ElementType::INTEGER32);
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMulAdd(integers, integers, integers, ElementType::INTEGER32, ElementType::INTEGER32, ElementType::INTEGER32, false, false, 1.0, 1.0), std::runtime_error);
+}
+
+ARRAY_TEST(ArrayMatrixMul, IntegersLikeReference) {
+    checkIntegerProducts();
+}
+
+ARRAY_TEST(ArrayMatrixMul, IntegersInParallel) {
+    auto &pool = ArrayThreadPool::get();
+    pool.setThreadCount(4);
+    pool.setThreshold(1);
+    checkIntegerProducts();
+    pool.setThreshold(ArrayThreadPool::DEFAULT_THRESHOLD);
+    pool.setThreadCount(0);
+}
+
+ARRAY_TEST(ArrayMatrixMul, IntegerResults) {
+    // 32-bit integers are multiplied with 64-bit accumulators and return 64-bit integers
+    auto left = parse("{{2147483647,-2147483648}}", ElementType::INTEGER32);
+    auto right = parse("{{2},{2}}", ElementType::INTEGER32);
+    ARRAY_EXPECT(print(ArrayRuntime::matrixMul(left, right, ElementType::INTEGER32, ElementType::INTEGER32), ElementType::INTEGER64) == "{{-2}}");
+    ARRAY_EXPECT(print(ArrayRuntime::matrixMul(right, left, ElementType::INTEGER32, ElementType::INTEGER32), ElementType::INTEGER64) == "{{4294967294,-4294967296},{4294967294,-4294967296}}");
+    auto accumulator = parse("{{9223372036854775807}}", ElementType::INTEGER64);
+    ARRAY_EXPECT(print(ArrayRuntime::matrixMulAdd(left, right, accumulator, ElementType::INTEGER32, ElementType::INTEGER32, ElementType::INTEGER64, false, false, 1.0, 1.0), ElementType::INTEGER64) == "{{9223372036854775805}}");
+
+    // Integer matrices take integer factors only
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMul(left, right, ElementType::INTEGER32, ElementType::INTEGER32, false, false, 0.5), std::runtime_error);
+    ARRAY_EXPECT_THROW(ArrayRuntime::matrixMulAdd(left, right, accumulator, ElementType::INTEGER32, ElementType::INTEGER32, ElementType::INTEGER64, false, false, 1.0, 1.5), std::runtime_error);
+    auto doubles = parse("{{1,2}}", ElementType::DOUBLE);
+    ARRAY_EXPECT(print(ArrayRuntime::matrixMul(doubles, parse("{{1},{1}}", ElementType::DOUBLE), ElementType::DOUBLE, ElementType::DOUBLE, false, false, 0.5), ElementType::DOUBLE) == "{{1.5}}");
+}
@@ -0,0 +1,67 @@
+#include "ArrayTest.h"
+
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+
+namespace {
+
+/**
+ * This function returns the literal of a vector whose element `i` is NULL if `isNull(i)`
+ * holds and `values[i]` otherwise.
+ */
+template<class IS_NULL>
+std::string createLiteral(const std::vector<int32_t> &values, IS_NULL isNull) {
+    std::string literal = "{";
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i > 0) literal += ",";
+        literal += isNull(i) ? "NULL" : std::to_string(values[i]);
+    }
+    return literal + "}";
+}
+
+// The NULL patterns, so NULL values end and begin at every position of the 64-bit words
+const std::vector<bool (*)(size_t)> PATTERNS = {
+    [](size_t i) { return i % 2 == 0; },
+    [](size_t i) { return i % 7 == 3; },
+    [](size_t i) { return i % 64 < 60; },
+    [](size_t i) { return (i + 1) % 64 < 2; },
+    [](size_t i) { return i < 130; },
+    [](size_t i) { return i >= 63; },
+};
+
+}
+
+ARRAY_TEST(ArrayNullHandling, SubscriptAcrossWords) {
+    for (size_t size : {63, 64, 65, 128, 200, 1000}) {
+        std::vector<int32_t> values(size);
+        for (size_t i = 0; i < size; i++) values[i] = static_cast<int32_t>(i) + 1;
+        for (auto isNull : PATTERNS) {
+            auto array = parse(createLiteral(values, isNull), ElementType::INTEGER32);
+            for (size_t i = 0; i < size; i++) {
+                // Subscripts start at 1, NULL values are returned as empty strings
+                auto element = ArrayRuntime::subscript(array, ElementType::INTEGER32, static_cast<int32_t>(i) + 1).str();
+                ARRAY_EXPECT(element == (isNull(i) ? "" : std::to_string(values[i])));
+            }
+        }
+    }
+}
+
+ARRAY_TEST(ArrayNullHandling, PositionsAcrossWords) {
+    for (size_t size : {64, 65, 200}) {
+        for (auto isNull : PATTERNS) {
+            // Every element that is not NULL becomes the largest and the smallest element once
+            for (size_t extreme = 0; extreme < size; extreme++) {
+                if (isNull(extreme)) continue;
+                std::vector<int32_t> values(size, 5);
+                values[extreme] = 9;
+                auto highest = parse(createLiteral(values, isNull), ElementType::INTEGER32);
+                ARRAY_EXPECT(ArrayRuntime::getHighestPosition(highest, ElementType::INTEGER32) == static_cast<int32_t>(extreme));
+                values[extreme] = 1;
+                auto lowest = parse(createLiteral(values, isNull), ElementType::INTEGER32);
+                ARRAY_EXPECT(ArrayRuntime::getLowestPosition(lowest, ElementType::INTEGER32) == static_cast<int32_t>(extreme));
+            }
+        }
+    }
+}
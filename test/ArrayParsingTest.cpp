@@ -0,0 +1,51 @@
+#include "ArrayTest.h"
+
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+using lingodb::runtime::test::print;
+
+ARRAY_TEST(ArrayParsing, RoundTrip) {
+    // Literals that are printed as they are parsed
+    const std::pair<const char*, int32_t> literals[] = {
+        {"{}", ElementType::INTEGER32},
+        {"{{},{}}", ElementType::INTEGER32},
+        {"{{1,2,3},{4},{}}", ElementType::INTEGER32},
+        {"{{{1}},{{2,3},{4}}}", ElementType::INTEGER32},
+        {"{9223372036854775807,-9223372036854775808,null}", ElementType::INTEGER64},
+        {"[2:3]={1.25,-0.5}", ElementType::DOUBLE},
+        {"[0:1][-5:-4]={{1,null},{null,4}}", ElementType::INTEGER32},
+        {"{\"a,b\",\"{c}\",\"q\\\"x\",\"back\\\\\",null,\"NULL\",\"\"}", ElementType::STRING},
+    };
+    for (auto &[literal, type] : literals) {
+        ARRAY_EXPECT(print(parse(literal, type), type) == literal);
+    }
+}
+
+ARRAY_TEST(ArrayParsing, Normalization) {
+    ARRAY_EXPECT(print(parse(" { {1, 2 ,3} , {4} , {} } ", ElementType::INTEGER32), ElementType::INTEGER32) == "{{1,2,3},{4},{}}");
+    ARRAY_EXPECT(print(parse("{NULL,null,Null}", ElementType::INTEGER64), ElementType::INTEGER64) == "{null,null,null}");
+    ARRAY_EXPECT(print(parse("{a b,  c }", ElementType::STRING), ElementType::STRING) == "{\"a b\",\"c\"}");
+    ARRAY_EXPECT(print(parse("{1e3,2.5E-1}", ElementType::FLOAT), ElementType::FLOAT) == "{1000,0.25}");
+}
+
+ARRAY_TEST(ArrayParsing, StructuralCharactersAtBlockBoundaries) {
+    // The structural characters are marked in blocks of 64 characters, so escapes, quotes and
+    // separators are moved across the end of the first blocks
+    for (size_t offset = 0; offset < 140; offset++) {
+        std::string padding(offset, 'x');
+        std::string literal = "{\"" + padding + "\\\"\",\"" + padding + "\\\\\",\"{" + padding + ",}\"}";
+        ARRAY_EXPECT(print(parse(literal, ElementType::STRING), ElementType::STRING) == literal);
+        std::string numbers = "{{" + std::string(offset, ' ') + "1,2},{3}}";
+        ARRAY_EXPECT(print(parse(numbers, ElementType::INTEGER32), ElementType::INTEGER32) == "{{1,2},{3}}");
+    }
+}
+
+ARRAY_TEST(ArrayParsing, InvalidLiterals) {
+    const char *literals[] = {
+        "", "{1,2", "{1,{2}}", "{{1},2}", "{1,,2}", "{1}x", "{1},{2}", "[1:1]={1,2}", "{abc}", "[1:2={1,2}",
+    };
+    for (auto *literal : literals) {
+        ARRAY_EXPECT_THROW(parse(literal, ElementType::INTEGER32), std::exception);
+    }
+    ARRAY_EXPECT_THROW(parse("{\"ab}", ElementType::STRING), std::runtime_error);
+}
@@ -0,0 +1,69 @@
+#include "ArrayTest.h"
+#include "ArrayAllocator.h"
+
+namespace {
+
+// The number of failed checks of the current test case.
+size_t failures = 0;
+
+}
+
+std::vector<lingodb::runtime::test::TestCase> &lingodb::runtime::test::getTestCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void lingodb::runtime::test::fail(const char *file, int line, const char *check) {
+    std::cerr << file << ":" << line << ": Check failed: " << check << std::endl;
+    failures++;
+}
+
+lingodb::runtime::VarLen32 lingodb::runtime::test::parse(const std::string &literal, int32_t type) {
+    return ArrayRuntime::fromString(VarLen32::fromString(literal), type);
+}
+
+std::string lingodb::runtime::test::print(VarLen32 array, int32_t type) {
+    std::string result;
+    StringPrintSink sink(result);
+    ArrayRuntime::print(array, type, sink);
+    sink.flush();
+    return result;
+}
+
+std::string lingodb::runtime::test::createLiteral(const std::vector<uint32_t> &shape, const std::function<std::string(size_t)> &value) {
+    std::string literal;
+    size_t position = 0;
+    std::function<void(size_t)> write = [&](size_t dimension) {
+        literal += "{";
+        for (uint32_t i = 0; i < shape[dimension]; i++) {
+            if (i > 0) literal += ",";
+            if (dimension + 1 < shape.size()) {
+                write(dimension + 1);
+            } else {
+                auto element = value(position++);
+                literal += element.empty() ? "null" : element;
+            }
+        }
+        literal += "}";
+    };
+    write(0);
+    return literal;
+}
+
+int main() {
+    size_t failed = 0;
+    for (auto &testCase : lingodb::runtime::test::getTestCases()) {
+        failures = 0;
+        try {
+            testCase.run();
+        } catch (const std::exception &exception) {
+            std::cerr << "Unexpected exception: " << exception.what() << std::endl;
+            failures++;
+        }
+        std::cout << (failures == 0 ? "[  PASSED  ] " : "[  FAILED  ] ") << testCase.name << std::endl;
+        // The results of a test case are not used by the next one
+        lingodb::runtime::ArrayAllocator::resetDefault();
+        if (failures > 0) failed++;
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+#ifndef LINGODB_RUNTIME_ARRAYTEST_H
+#define LINGODB_RUNTIME_ARRAYTEST_H
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ArrayRuntime.h"
+
+namespace lingodb::runtime::test {
+
+// The element types of `ArrayRuntime` (see `Array::ArrayType`)
+enum ElementType : int32_t {
+    INTEGER32,
+    INTEGER64,
+    BFLOAT,
+    FLOAT,
+    DOUBLE,
+    STRING,
+};
+
+// A test case: its name and the function that executes it.
+struct TestCase {
+    const char *name;
+    void (*run)();
+};
+
+/**
+ * This function returns the test cases of every test file. A test file registers its
+ * cases with `ARRAY_TEST`.
+ */
+std::vector<TestCase> &getTestCases();
+
+/**
+ * This function reports a failed check of the current test case.
+ */
+void fail(const char *file, int line, const char *check);
+
+/**
+ * This function parses an array literal (see `ArrayRuntime::fromString`).
+ */
+VarLen32 parse(const std::string &literal, int32_t type);
+
+/**
+ * This function returns the array literal of an array (see `ArrayRuntime::print`).
+ */
+std::string print(VarLen32 array, int32_t type);
+
+/**
+ * This function returns the literal of a rectangular array of the given shape. The element
+ * at the (row-major) position `i` is `value(i)` (an empty string stands for NULL).
+ */
+std::string createLiteral(const std::vector<uint32_t> &shape, const std::function<std::string(size_t)> &value);
+
+// Registers a test case (`ARRAY_TEST(Suite, Name) { ... }`)
+#define ARRAY_TEST(SUITE, NAME)                                                            \
+    void SUITE##_##NAME();                                                                 \
+    static const bool SUITE##_##NAME##_registered =                                        \
+        (lingodb::runtime::test::getTestCases().push_back({#SUITE "." #NAME, SUITE##_##NAME}), true); \
+    void SUITE##_##NAME()
+
+// Checks that a condition holds
+#define ARRAY_EXPECT(CONDITION)                                                            \
+    if (!(CONDITION)) lingodb::runtime::test::fail(__FILE__, __LINE__, #CONDITION)
+
+// Checks that two values differ by at most `TOLERANCE`
+#define ARRAY_EXPECT_NEAR(VALUE, EXPECTED, TOLERANCE)                                      \
+    ARRAY_EXPECT(std::fabs((VALUE) - (EXPECTED)) <= (TOLERANCE))
+
+// Checks that a statement throws an exception of the given type
+#define ARRAY_EXPECT_THROW(STATEMENT, EXCEPTION)                                           \
+    do {                                                                                   \
+        bool thrown = false;                                                               \
+        try {                                                                              \
+            STATEMENT;                                                                     \
+        } catch (const EXCEPTION &) {                                                      \
+            thrown = true;                                                                 \
+        }                                                                                  \
+        if (!thrown) lingodb::runtime::test::fail(__FILE__, __LINE__, #STATEMENT " throws " #EXCEPTION); \
+    } while (false)
+
+}
+#endif
@@ -0,0 +1,102 @@
+#include "ArrayTest.h"
+#include "ArrayThreadPool.h"
+#include <atomic>
+#include <cstdint>
+
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::ArrayThreadPool;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+using lingodb::runtime::test::print;
+
+namespace {
+
+/**
+ * This function returns the literal of a ragged two dimensional array with `size` elements
+ * (every tenth element is NULL), as it is printed.
+ */
+std::string createLiteral(size_t size, int32_t type) {
+    std::string literal = "{{";
+    for (size_t i = 0; i < size; i++) {
+        if (i > 0) literal += i % 97 == 0 || i % 89 == 0 ? "},{" : ",";
+        if (i % 10 == 3) {
+            literal += "null";
+        } else if (type == ElementType::DOUBLE) {
+            literal += std::to_string(static_cast<int64_t>(i) - 1000) + ".25";
+        } else if (type == ElementType::STRING) {
+            literal += "\"s" + std::to_string(i) + "\"";
+        } else {
+            literal += std::to_string(static_cast<int64_t>(i * 7919 % 2000000) - 1000000);
+        }
+    }
+    return literal + "}}";
+}
+
+}
+
+ARRAY_TEST(ArrayThreadPool, ParseAndPrintAboveThreshold) {
+    auto &pool = ArrayThreadPool::get();
+    size_t size = 2 * ArrayThreadPool::DEFAULT_THRESHOLD;
+    for (int32_t type : {ElementType::INTEGER32, ElementType::INTEGER64, ElementType::DOUBLE, ElementType::STRING}) {
+        auto literal = createLiteral(size, type);
+        pool.setThreadCount(1);
+        VarLen32 serial = parse(literal, type);
+        pool.setThreadCount(4);
+        VarLen32 parallel = parse(literal, type);
+        ARRAY_EXPECT(pool.isParallel(size));
+        // The parallel parser writes the same binary array
+        ARRAY_EXPECT(serial.getLen() == parallel.getLen() && serial.str() == parallel.str());
+        ARRAY_EXPECT(print(parallel, type) == literal);
+        pool.setThreadCount(1);
+        ARRAY_EXPECT(print(parallel, type) == literal);
+    }
+    pool.setThreadCount(0);
+}
+
+ARRAY_TEST(ArrayThreadPool, ReductionsIndependentOfParallelism) {
+    auto &pool = ArrayThreadPool::get();
+    size_t size = 3 * ArrayThreadPool::CHUNK_SIZE + 123;
+    std::string literal = "{";
+    for (size_t i = 0; i < size; i++) {
+        literal += (i > 0 ? "," : "") + std::to_string(i % 1000) + "." + std::to_string(i % 7) + "1";
+    }
+    literal += "}";
+    for (int32_t type : {ElementType::BFLOAT, ElementType::FLOAT, ElementType::DOUBLE}) {
+        auto array = parse(literal, type);
+        auto reduce = [&]() {
+            return std::vector<double>{ArrayRuntime::sum(array, type), ArrayRuntime::mean(array, type), ArrayRuntime::l2Norm(array, type)};
+        };
+        pool.setThreadCount(1);
+        auto serial = reduce();
+        // Every split into chunks combines the same partial results
+        pool.setThreadCount(4);
+        for (size_t threshold : {size_t{1}, ArrayThreadPool::DEFAULT_THRESHOLD, SIZE_MAX}) {
+            pool.setThreshold(threshold);
+            ARRAY_EXPECT(reduce() == serial);
+        }
+        pool.setThreshold(ArrayThreadPool::DEFAULT_THRESHOLD);
+    }
+    pool.setThreadCount(0);
+}
+
+ARRAY_TEST(ArrayThreadPool, SetThreadCountInsideChunk) {
+    auto &pool = ArrayThreadPool::get();
+    pool.setThreadCount(4);
+    pool.setThreshold(1);
+    std::atomic<size_t> rejected = 0;
+    size_t chunks = 8;
+    pool.parallelFor(chunks * ArrayThreadPool::CHUNK_SIZE, [&](size_t, size_t) {
+        // Waiting for the running operations would wait for this chunk
+        try {
+            pool.setThreadCount(2);
+        } catch (const std::runtime_error &) {
+            rejected++;
+        }
+        pool.setThreshold(1);
+    });
+    ARRAY_EXPECT(rejected == chunks);
+    ARRAY_EXPECT(pool.getThreadCount() == 4);
+    pool.setThreshold(ArrayThreadPool::DEFAULT_THRESHOLD);
+    pool.setThreadCount(0);
+}
@@ -0,0 +1,107 @@
+#include "ArrayTest.h"
+#include "ArrayThreadPool.h"
+#include <algorithm>
+
+using lingodb::runtime::ArrayRuntime;
+using lingodb::runtime::ArrayThreadPool;
+using lingodb::runtime::VarLen32;
+using lingodb::runtime::test::createLiteral;
+using lingodb::runtime::test::ElementType;
+using lingodb::runtime::test::parse;
+using lingodb::runtime::test::print;
+
+namespace {
+
+/**
+ * This function returns the element of the source that is moved to the (row-major) position
+ * `target` of the permuted array (the naive definition of a permutation).
+ */
+size_t getSourcePosition(const std::vector<uint32_t> &shape, const std::vector<uint32_t> &axes, size_t target) {
+    std::vector<size_t> index(shape.size());
+    for (size_t i = axes.size(); i > 0; i--) {
+        auto size = shape[axes[i - 1]];
+        index[axes[i - 1]] = target % size;
+        target /= size;
+    }
+    size_t source = 0;
+    for (size_t i = 0; i < shape.size(); i++) source = source * shape[i] + index[i];
+    return source;
+}
+
+std::string toAxesLiteral(const std::vector<uint32_t> &axes) {
+    std::string literal = "{";
+    for (size_t i = 0; i < axes.size(); i++) literal += (i > 0 ? "," : "") + std::to_string(axes[i] + 1);
+    return literal + "}";
+}
+
+/**
+ * This function permutes an array of the given shape with every order of its dimensions and
+ * compares the result with the naive definition.
+ */
+void checkPermutations(const std::vector<uint32_t> &shape, int32_t type, size_t nullEvery) {
+    auto value = [&](size_t i) -> std::string {
+        if (nullEvery != 0 && i % nullEvery == 1) return "";
+        // Small integers are exact in every numeric type, including bfloat
+        return std::to_string(static_cast<int64_t>(i % 200) - 100);
+    };
+    auto array = parse(createLiteral(shape, value), type);
+    std::vector<uint32_t> axes(shape.size());
+    for (uint32_t i = 0; i < axes.size(); i++) axes[i] = i;
+    do {
+        std::vector<uint32_t> permuted(shape.size());
+        for (size_t i = 0; i < axes.size(); i++) permuted[i] = shape[axes[i]];
+        auto expected = createLiteral(permuted, [&](size_t i) { return value(getSourcePosition(shape, axes, i)); });
+        auto result = ArrayRuntime::permute(array, type, parse(toAxesLiteral(axes), ElementType::INTEGER32), ElementType::INTEGER32);
+        ARRAY_EXPECT(print(result, type) == expected);
+        if (axes.size() >= 2 && axes[0] == 1 && axes[1] == 0 && std::is_sorted(axes.begin() + 2, axes.end())) {
+            // A transpose swaps the first two dimensions
+            ARRAY_EXPECT(print(ArrayRuntime::transpose(array, type), type) == expected);
+        }
+    } while (std::next_permutation(axes.begin(), axes.end()));
+}
+
+}
+
+ARRAY_TEST(ArrayTranspose, PermuteLikeReference) {
+    const std::vector<std::vector<uint32_t>> shapes = {
+        {7}, {1, 1}, {3, 5}, {40, 33}, {65, 1, 31}, {5, 40, 33}, {2, 3, 4, 5}, {1, 70, 2, 35},
+    };
+    for (auto &shape : shapes) {
+        // Elements of 2, 4 and 8 bytes, with and without NULL values
+        for (int32_t type : {ElementType::BFLOAT, ElementType::INTEGER32, ElementType::INTEGER64, ElementType::DOUBLE}) {
+            for (size_t nullEvery : {0, 3, 64}) {
+                checkPermutations(shape, type, nullEvery);
+            }
+        }
+    }
+}
+
+ARRAY_TEST(ArrayTranspose, PermuteInParallel) {
+    auto &pool = ArrayThreadPool::get();
+    pool.setThreadCount(4);
+    checkPermutations({300, 2, 500}, ElementType::INTEGER32, 0);
+    checkPermutations({600, 500}, ElementType::DOUBLE, 7);
+    pool.setThreadCount(0);
+}
+
+ARRAY_TEST(ArrayTranspose, TransposeVectorAndIndices) {
+    // A vector becomes a single row, the indices move with their dimensions
+    ARRAY_EXPECT(print(ArrayRuntime::transpose(parse("{1,null,3}", ElementType::INTEGER32), ElementType::INTEGER32), ElementType::INTEGER32) == "{{1,null,3}}");
+    auto array = parse("[2:3][0:2]={{1,2,3},{4,5,6}}", ElementType::INTEGER64);
+    ARRAY_EXPECT(print(ArrayRuntime::transpose(array, ElementType::INTEGER64), ElementType::INTEGER64) == "[0:2][2:3]={{1,4},{2,5},{3,6}}");
+}
+
+ARRAY_TEST(ArrayTranspose, InvalidPermutations) {
+    auto array = parse("{{{1,2},{3,4}}}", ElementType::INTEGER32);
+    const char *axes[] = {"{1,2}", "{1,2,3,4}", "{1,1,2}", "{0,1,2}", "{1,2,4}", "{1,null,2}", "{-1,2,3}"};
+    for (auto *literal : axes) {
+        ARRAY_EXPECT_THROW(ArrayRuntime::permute(array, ElementType::INTEGER32, parse(literal, ElementType::INTEGER32), ElementType::INTEGER32), std::runtime_error);
+    }
+    ARRAY_EXPECT_THROW(ArrayRuntime::permute(array, ElementType::INTEGER32, parse("{1.0,2.0,3.0}", ElementType::DOUBLE), ElementType::DOUBLE), std::runtime_error);
+    // Ragged arrays and strings cannot be permuted
+    auto ragged = parse("{{1,2},{3}}", ElementType::INTEGER32);
+    ARRAY_EXPECT_THROW(ArrayRuntime::permute(ragged, ElementType::INTEGER32, parse("{2,1}", ElementType::INTEGER32), ElementType::INTEGER32), std::runtime_error);
+    ARRAY_EXPECT_THROW(ArrayRuntime::transpose(ragged, ElementType::INTEGER32), std::runtime_error);
+    auto strings = parse("{{\"a\"},{\"b\"}}", ElementType::STRING);
+    ARRAY_EXPECT_THROW(ArrayRuntime::transpose(strings, ElementType::STRING), std::runtime_error);
+}
@@ -0,0 +1,188 @@
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+#include <unistd.h>
+#include "ArrayGenerator.h"
+
+using lingodb::runtime::ArenaAllocator;
+using lingodb::runtime::ArrayAllocator;
+using lingodb::runtime::ArrayGenerator;
+using lingodb::runtime::ArraySpecification;
+using lingodb::runtime::FilePrintSink;
+using lingodb::runtime::VarLen32;
+
+namespace {
+
+const char *USAGE =
+    "Usage: array_generate [options]\n"
+    "  --type NAME        Element type: int32, int64, bfloat, float, double or string (default: int32)\n"
+    "  --dims W[,W...]    Width of each dimension, either N (rectangular) or MIN-MAX (ragged) (default: 10)\n"
+    "  --lower L[,L...]   Index of the first element of each dimension (default: 1)\n"
+    "  --nulls DENSITY    Probability of a NULL element (default: 0)\n"
+    "  --strings MIN-MAX  Range of the string lengths (default: 1-16)\n"
+    "  --min VALUE        Smallest numeric value (default: -1000)\n"
+    "  --max VALUE        Largest numeric value (default: 1000)\n"
+    "  --rows N           Number of arrays (default: 1)\n"
+    "  --seed N           Seed of the random numbers (default: 0)\n"
+    "  --format FORMAT    text (one literal per line) or binary (a 32-bit length before each array) (default: text)\n"
+    "  --output PATH      Output file (default: standard output)\n";
+
+/**
+ * This function splits a comma-separated list.
+ */
+std::vector<std::string> split(const std::string &list) {
+    std::vector<std::string> parts;
+    size_t begin = 0;
+    while (true) {
+        auto end = list.find(',', begin);
+        parts.push_back(list.substr(begin, end - begin));
+        if (end == std::string::npos) return parts;
+        begin = end + 1;
+    }
+}
+
+/**
+ * This function parses the value of a numeric option with `parse` (e.g. `std::stod`). The
+ * whole value has to be a number in the range of the result.
+ *
+ * @throws `std::runtime_error`: If the value is no valid number (naming the option and the value).
+ */
+template<class PARSE>
+auto parseNumber(const std::string &option, const std::string &value, PARSE parse) {
+    try {
+        size_t end = 0;
+        auto number = parse(value, &end);
+        if (end == value.size()) return number;
+    } catch (std::logic_error &) {
+        // std::invalid_argument or std::out_of_range
+    }
+    throw std::runtime_error("Invalid value '" + value + "' of " + option);
+}
+
+double parseDouble(const std::string &option, const std::string &value) {
+    return parseNumber(option, value, [](const std::string &text, size_t *end) { return std::stod(text, end); });
+}
+
+int32_t parseInteger(const std::string &option, const std::string &value) {
+    return parseNumber(option, value, [](const std::string &text, size_t *end) { return std::stoi(text, end); });
+}
+
+uint64_t parseUnsigned(const std::string &option, const std::string &value) {
+    return parseNumber(option, value, [](const std::string &text, size_t *end) {
+        // std::stoull accepts negative numbers (and negates the result)
+        if (text.find('-') != std::string::npos) throw std::invalid_argument(text);
+        return std::stoull(text, end);
+    });
+}
+
+/**
+ * This function parses a range `MIN-MAX` (or a single value `N`) of an option.
+ */
+std::pair<uint32_t, uint32_t> parseRange(const std::string &option, const std::string &range) {
+    auto parse = [&](const std::string &value) {
+        auto number = parseUnsigned(option, value);
+        if (number > UINT32_MAX) throw std::runtime_error("Invalid value '" + value + "' of " + option);
+        return static_cast<uint32_t>(number);
+    };
+    auto separator = range.find('-');
+    if (separator == std::string::npos) {
+        auto value = parse(range);
+        return {value, value};
+    }
+    return {parse(range.substr(0, separator)), parse(range.substr(separator + 1))};
+}
+}
+
+int main(int argc, char **argv) {
+    ArraySpecification specification;
+    std::vector<std::string> widths{"10"};
+    std::vector<std::string> lowerBounds;
+    size_t rows = 1;
+    uint64_t seed = 0;
+    bool binary = false;
+    std::string output;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string option = argv[i];
+            if (option == "--help") {
+                std::cout << USAGE;
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value of " + option);
+            }
+            std::string value = argv[++i];
+            if (option == "--type") {
+                specification.type = ArrayGenerator::getType(value);
+            } else if (option == "--dims") {
+                widths = split(value);
+            } else if (option == "--lower") {
+                lowerBounds = split(value);
+            } else if (option == "--nulls") {
+                specification.nullDensity = parseDouble(option, value);
+            } else if (option == "--strings") {
+                std::tie(specification.minStringLength, specification.maxStringLength) = parseRange(option, value);
+            } else if (option == "--min") {
+                specification.minValue = parseDouble(option, value);
+            } else if (option == "--max") {
+                specification.maxValue = parseDouble(option, value);
+            } else if (option == "--rows") {
+                rows = parseUnsigned(option, value);
+            } else if (option == "--seed") {
+                seed = parseUnsigned(option, value);
+            } else if (option == "--format") {
+                if (value != "text" && value != "binary") {
+                    throw std::runtime_error("Unknown format " + value);
+                }
+                binary = value == "binary";
+            } else if (option == "--output") {
+                output = value;
+            } else {
+                throw std::runtime_error("Unknown option " + option);
+            }
+        }
+        if (!lowerBounds.empty() && lowerBounds.size() != widths.size()) {
+            throw std::runtime_error("Every dimension needs an index of its first element");
+        }
+        for (size_t i = 0; i < widths.size(); i++) {
+            ArraySpecification::Dimension dimension;
+            std::tie(dimension.minWidth, dimension.maxWidth) = parseRange("--dims", widths[i]);
+            if (!lowerBounds.empty()) dimension.lowerBound = parseInteger("--lower", lowerBounds[i]);
+            specification.dimensions.push_back(dimension);
+        }
+
+        int descriptor = STDOUT_FILENO;
+        if (!output.empty()) {
+            descriptor = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (descriptor < 0) {
+                throw std::runtime_error("Could not open " + output + ": " + strerror(errno));
+            }
+        }
+        ArrayGenerator generator(specification, seed);
+        FilePrintSink sink(descriptor);
+        ArenaAllocator allocator;
+        ArrayAllocator::Scope scope(allocator);
+        for (size_t i = 0; i < rows; i++) {
+            if (binary) {
+                auto array = generator.next();
+                uint32_t length = array.getLen();
+                sink.append(reinterpret_cast<const char*>(&length), sizeof(length));
+                sink.append(reinterpret_cast<const char*>(array.getPtr()), length);
+                allocator.reset();
+            } else {
+                generator.nextLiteral(sink);
+                sink.append('\n');
+            }
+        }
+        sink.flush();
+        if (descriptor != STDOUT_FILENO) close(descriptor);
+    } catch (std::exception &exception) {
+        std::cerr << "array_generate: " << exception.what() << "\n" << USAGE;
+        return 1;
+    }
+    return 0;
+}